@@ -62,11 +62,19 @@ the program(s) have been supplied.
 
 // Tokenizer system
 #include <ee/boolean.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
 #include <ee/integer.hpp>
+#include <ee/lazy_real.hpp>
+#include <ee/quad_double.hpp>
 #include <ee/real.hpp>
 #include <ee/variable.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <string>
+#include <thread>
+#include <vector>
 using namespace std;
 
 #include "ut_test_phases.hpp"
@@ -97,6 +105,42 @@ GATS_TEST_CASE(1_integer_test) {
 #endif
 	GATS_CHECK(is<Integer>(i));
 }
+
+
+#if TEST_INTEGER_KERNELS
+GATS_TEST_CASE(1_integer_kernels_test) {
+	using value_type = Integer::value_type;
+	GATS_CHECK(isqrt(value_type(0)) == 0);
+	GATS_CHECK(isqrt(value_type(15)) == 3);
+	GATS_CHECK(isqrt(value_type(16)) == 4);
+	GATS_CHECK(isqrt(pow(value_type(10), 1000) - 1) == pow(value_type(10), 500) - 1);
+
+	// exact results stay Integer
+	auto r = integer_sqrt(pow(value_type(10), 1000));
+	GATS_CHECK(is<Integer>(r) && value_of<Integer>(r) == pow(value_type(10), 500));
+	r = integer_lb(pow(value_type(2), 4096));
+	GATS_CHECK(is<Integer>(r) && value_of<Integer>(r) == 4096);
+	r = integer_log(pow(value_type(10), 1000));
+	GATS_CHECK(is<Integer>(r) && value_of<Integer>(r) == 1000);
+	r = integer_ln(value_type(1));
+	GATS_CHECK(is<Integer>(r) && value_of<Integer>(r) == 0);
+	r = integer_abs(value_type(-42));
+	GATS_CHECK(is<Integer>(r) && value_of<Integer>(r) == 42);
+
+	// irrational results become Real
+	GATS_CHECK(is<Real>(integer_sqrt(value_type(2))));
+	GATS_CHECK(is<Real>(integer_lb(value_type(3))));
+	GATS_CHECK(is<Real>(integer_log(value_type(999))));
+	GATS_CHECK(is<Real>(integer_log(value_type(8))));
+	GATS_CHECK(is<Real>(integer_ln(value_type(7))));
+
+	GATS_CHECK_THROW((void)isqrt(value_type(-1)), std::domain_error);
+	GATS_CHECK_THROW((void)integer_lb(value_type(0)), std::domain_error);
+	GATS_CHECK_THROW((void)integer_sqrt(value_type(-4)), std::domain_error);
+	GATS_CHECK_THROW((void)integer_log(value_type(-1)), std::domain_error);
+	GATS_CHECK_THROW((void)integer_ln(value_type(0)), std::domain_error);
+}
+#endif // TEST_INTEGER_KERNELS
 #endif // TEST_INTEGER
 
 
@@ -162,6 +206,181 @@ GATS_TEST_CASE(1_real_test) {
 
 
 
+#if TEST_MULTI_DOUBLE
+GATS_TEST_CASE(1_multi_double_test) {
+	// error-free arithmetic keeps digits far beyond double precision
+	dd_real third = dd_real(1.0) / dd_real(3.0);
+	GATS_CHECK(third.to_string() == "0.3333333333333333333333333333333");
+	GATS_CHECK(abs(third * dd_real(3.0) - dd_real(1.0)) < dd_real(1e-31));
+	GATS_CHECK(dd_real(1.0) + dd_real(1e-25) > dd_real(1.0));
+	GATS_CHECK(dd_real("12345678901234567890.25").to_string(2) == "12345678901234567890.25");
+
+	GATS_CHECK(sqrt(qd_real(2.0)).to_string(40) == "1.4142135623730950488016887242096980785697");
+	GATS_CHECK(exp(qd_real(1.0)).to_string(40) == qd_real::e().to_string(40));
+	GATS_CHECK(abs(::log(qd_real::e()) - qd_real(1.0)) < qd_real(1e-60));
+	GATS_CHECK(abs(sin(qd_real::pi() / qd_real(6.0)) - qd_real(0.5)) < qd_real(1e-60));
+	GATS_CHECK(abs(atan(qd_real(1.0)) * qd_real(4.0) - qd_real::pi()) < qd_real(1e-60));
+	GATS_CHECK(floor(qd_real(-2.5)) == qd_real(-3.0));
+	GATS_CHECK(ceil(qd_real(-2.5)) == qd_real(-2.0));
+
+	// integers beyond 2^53 are held exactly, up to the ends of the range
+	GATS_CHECK(dd_real(9007199254740993LL).to_string(0) == "9007199254740993");
+	GATS_CHECK(dd_real(std::numeric_limits<long long>::max()).to_string(0) == "9223372036854775807");
+	GATS_CHECK(dd_real(std::numeric_limits<long long>::min()).to_string(0) == "-9223372036854775808");
+	GATS_CHECK(dd_real(std::numeric_limits<long long>::max() - 1) - dd_real(std::numeric_limits<long long>::max()) == dd_real(-1.0));
+
+	auto d = make<DoubleDouble>(dd_real(4.25));
+	GATS_CHECK(is<Operand>(d));
+	GATS_CHECK(!is<Real>(d));
+	GATS_CHECK(is<DoubleDouble>(d));
+	GATS_CHECK(d->str() == "4.2500000000000000000000000000000");
+
+	auto q = make<QuadDouble>(qd_real(4.25));
+	GATS_CHECK(is<Operand>(q));
+	GATS_CHECK(!is<DoubleDouble>(q));
+	GATS_CHECK(is<QuadDouble>(q));
+}
+#endif // TEST_MULTI_DOUBLE
+
+
+
+#if TEST_LAZY_REAL
+GATS_TEST_CASE(1_lazy_real_test) {
+	lazy_real x = lazy_real("1.5") * lazy_real::pi() + sqrt(lazy_real(2));
+	GATS_CHECK(x.cached_digits() == 0);
+	GATS_CHECK(x.to_string(10) == "6.1266025428");
+	GATS_CHECK(x.cached_digits() < 100);
+	GATS_CHECK(x.to_string(120).substr(0, 30) == "6.1266025427577849064956537991");
+	GATS_CHECK(x.cached_digits() >= 120);
+
+	// cancellation is detected and the digits are recomputed at higher precision
+	lazy_real big = exp(lazy_real(100));
+	lazy_real tiny = (big + lazy_real("1e-60")) - big;
+	GATS_CHECK(tiny.to_string(62) == "0.00000000000000000000000000000000000000000000000000000000000100");
+
+	GATS_CHECK(lazy_real(1) / lazy_real(3) * lazy_real(3) == lazy_real(1));
+	GATS_CHECK(lazy_real::pi() < lazy_real("3.1416"));
+	GATS_CHECK(sqrt(lazy_real(2)) * sqrt(lazy_real(2)) == lazy_real(2));
+	GATS_CHECK((sqrt(lazy_real(2)) * sqrt(lazy_real(2))).floor() == 2);
+	GATS_CHECK((-lazy_real::e()).floor() == -3);
+	GATS_CHECK(lazy_real::e().ceil() == 3);
+
+	// integral powers are exact products, so a negative base is fine; otherwise it is a domain error
+	GATS_CHECK(pow(lazy_real(-2), lazy_real(3)) == lazy_real(-8));
+	GATS_CHECK(pow(lazy_real(-2), lazy_real(-2)) == lazy_real("0.25"));
+	GATS_CHECK(pow(lazy_real(3), lazy_real(40)).to_string(2) == "12157665459056928801.00");
+	GATS_CHECK(pow(lazy_real(2), lazy_real("0.5")) == sqrt(lazy_real(2)));
+	GATS_CHECK_THROW((void)pow(lazy_real(-2), lazy_real("0.5")).to_string(10), std::domain_error);
+	GATS_CHECK_THROW((void)pow(lazy_real("0"), lazy_real(-1)).to_string(10), std::domain_error);
+
+	// a long chain is evaluated and released without deep recursion, and costs little until evaluated
+	lazy_real chain(1);
+	for (int i = 0; i < 20000; ++i)
+		chain = chain + lazy_real(1);
+	std::size_t const pending = chain.bytes();
+	GATS_CHECK(pending < 20001 * sizeof(Real));
+	GATS_CHECK(chain.to_string(5) == "20001.00000");
+	GATS_CHECK(chain.bytes() > pending);
+	chain = lazy_real();
+
+	auto r = make<LazyReal>(lazy_real::pi());
+	GATS_CHECK(is<Operand>(r));
+	GATS_CHECK(!is<Real>(r));
+	GATS_CHECK(r->str() == "3.14159265358979323846264338327950288419716939937511");
+
+	// one shared tree refined from several threads at once gives every thread the same digits
+	lazy_real shared = sqrt(lazy_real(2)) * lazy_real::pi() + exp(lazy_real(3));
+	vector<string> digits(4);
+	vector<thread> threads;
+	for (size_t i = 0; i < digits.size(); ++i)
+		threads.emplace_back([&, i] { digits[i] = shared.to_string(100 + unsigned(i) * 200).substr(0, 100); });
+	for (auto& t : threads)
+		t.join();
+	GATS_CHECK(count(digits.begin(), digits.end(), digits[0]) == 4);
+	GATS_CHECK(shared.cached_digits() >= 700);
+}
+#endif // TEST_LAZY_REAL
+
+
+
+#if TEST_DECIMAL
+GATS_TEST_CASE(1_decimal_test) {
+	fixed_decimal a, b, r;
+	GATS_CHECK(fixed_decimal::from_string("0.1", a));
+	GATS_CHECK(fixed_decimal::from_string("0.2", b));
+	GATS_CHECK(fixed_decimal::add(a, b, r));
+	GATS_CHECK(r.to_string() == "0.300000000000000000");
+	GATS_CHECK(fixed_decimal::subtract(a, b, r));
+	GATS_CHECK(r.to_string() == "-0.100000000000000000");
+
+	// rounding modes on the 19th fractional digit
+	GATS_CHECK(fixed_decimal::from_string("0.0000000000000000025", r) && r.raw() == 2);
+	GATS_CHECK(fixed_decimal::from_string("0.0000000000000000035", r) && r.raw() == 4);
+	GATS_CHECK(fixed_decimal::from_string("0.0000000000000000025", r, RoundingMode::HalfUp) && r.raw() == 3);
+	GATS_CHECK(fixed_decimal::from_string("-0.0000000000000000025", r, RoundingMode::Floor) && r.raw() == -3);
+	GATS_CHECK(fixed_decimal::from_string("-0.0000000000000000025", r, RoundingMode::Ceiling) && r.raw() == -2);
+	GATS_CHECK(fixed_decimal::from_string("-0.0000000000000000029", r, RoundingMode::TowardZero) && r.raw() == -2);
+
+	GATS_CHECK(fixed_decimal::from_string("1", a) && fixed_decimal::from_string("3", b));
+	GATS_CHECK(fixed_decimal::divide(a, b, r));
+	GATS_CHECK(r.to_string() == "0.333333333333333333");
+	GATS_CHECK(fixed_decimal::divide(-b, b, r) && r == fixed_decimal::from_raw(-fixed_decimal::one()));
+	GATS_CHECK(fixed_decimal::divide(b, a, r, RoundingMode::Ceiling) && r.to_string() == "3.000000000000000000");
+	GATS_CHECK(fixed_decimal::divide(a, b, r, RoundingMode::Ceiling) && r.to_string() == "0.333333333333333334");
+	GATS_CHECK_THROW((void)fixed_decimal::divide(a, fixed_decimal(), r), std::domain_error);
+
+	// wide products and quotients
+	GATS_CHECK(fixed_decimal::from_string("12345678901.25", a) && fixed_decimal::from_string("1000.5", b));
+	GATS_CHECK(fixed_decimal::multiply(a, b, r));
+	GATS_CHECK(r.to_string() == "12351851740700.625000000000000000");
+	GATS_CHECK(fixed_decimal::divide(r, b, r));
+	GATS_CHECK(r == a);
+	GATS_CHECK(!fixed_decimal::multiply(a, a, r));
+	GATS_CHECK(a > b && b < a && a != b && -a < b);
+
+	// mixed-type rules and overflow promotion
+	auto d = make_decimal_literal("2.5");
+	GATS_CHECK(is<Decimal>(d));
+	GATS_CHECK(is<Decimal>(decimal_add(d, make_operand<Integer>(1))));
+	GATS_CHECK(value_of<Decimal>(decimal_multiply(make_operand<Integer>(3), d)).to_string() == "7.500000000000000000");
+	GATS_CHECK(is<Real>(decimal_add(d, make_operand<Real>(Real::value_type("0.5")))));
+	GATS_CHECK(value_of<Real>(decimal_add(d, make_operand<Real>(Real::value_type("0.5")))) == 3);
+	auto big = make_decimal_literal("9999999999999999999.5");
+	GATS_CHECK(is<Decimal>(big));
+	auto sum = decimal_add(big, big);
+	GATS_CHECK(is<Real>(sum));
+	GATS_CHECK(value_of<Real>(sum) == Real::value_type("19999999999999999999"));
+	GATS_CHECK(is<Real>(make_decimal_literal("99999999999999999999")));
+	GATS_CHECK(is<Real>(decimal_add(d, make_operand<Integer>(Integer::value_type("100000000000000000000")))));
+
+	// integers convert up to integer_digits digits, past 64 bits
+	GATS_CHECK(fixed_decimal::from_integer(Integer::value_type("9999999999999999999"), r) && r.to_string() == "9999999999999999999.000000000000000000");
+	GATS_CHECK(fixed_decimal::from_integer(Integer::value_type("-9223372036854775809"), r) && r.to_string() == "-9223372036854775809.000000000000000000");
+	GATS_CHECK(!fixed_decimal::from_integer(Integer::value_type("10000000000000000000"), r));
+	GATS_CHECK(is<Decimal>(decimal_add(d, make_operand<Integer>(Integer::value_type("9223372036854775808")))));
+	GATS_CHECK(decimal_compare(d, make_operand<Integer>(2)) > 0);
+	GATS_CHECK(decimal_compare(d, make_operand<Real>(Real::value_type("2.5"))) == 0);
+
+	// the most precise real type present wins
+	auto dd = decimal_add(d, make_operand<DoubleDouble>(dd_real(0.5)));
+	GATS_CHECK(is<DoubleDouble>(dd) && value_of<DoubleDouble>(dd) == dd_real(3.0));
+	auto qd = decimal_multiply(make_operand<QuadDouble>(qd_real(2.0)), d);
+	GATS_CHECK(is<QuadDouble>(qd) && value_of<QuadDouble>(qd) == qd_real(5.0));
+	GATS_CHECK(is<QuadDouble>(decimal_add(make_operand<DoubleDouble>(dd_real(1.0)), make_operand<QuadDouble>(qd_real(1.0)))));
+	GATS_CHECK(is<Real>(decimal_subtract(make_operand<DoubleDouble>(dd_real(1.0)), make_operand<Real>(Real::value_type(1)))));
+	auto lazy = decimal_divide(d, make_operand<LazyReal>(lazy_real(Integer::value_type(5))));
+	GATS_CHECK(is<LazyReal>(lazy) && value_of<LazyReal>(lazy).to_string(2) == "0.50");
+	GATS_CHECK(decimal_compare(make_operand<DoubleDouble>(dd_real(2.5)), d) == 0);
+	GATS_CHECK(decimal_compare(d, make_operand<QuadDouble>(qd_real(3.0))) < 0);
+	GATS_CHECK(decimal_compare(make_operand<LazyReal>(lazy_real("2.4")), d) < 0);
+	GATS_CHECK_THROW((void)decimal_divide(d, make_operand<DoubleDouble>(dd_real(0.0))), std::domain_error);
+	GATS_CHECK_THROW((void)decimal_add(d, make_operand<Boolean>(true)), std::domain_error);
+	GATS_CHECK(d->str() == "2.500000000000000000");
+}
+#endif // TEST_DECIMAL
+
+
+
 #if TEST_BOOLEAN
 GATS_TEST_CASE(1_boolean_test) {
 	GATS_CHECK(Boolean(false).value() == false);
@@ -1,6 +1,7 @@
 #pragma once
 
 #define TEST_INTEGER true
+#define TEST_INTEGER_KERNELS true
 
 #define TEST_UNARY_OPERATOR true
 #define TEST_BINARY_OPERATOR true
@@ -15,6 +16,9 @@
 #define TEST_MULTI_ARG true
 
 #define TEST_REAL true
+#define TEST_MULTI_DOUBLE true
+#define TEST_LAZY_REAL true
+#define TEST_DECIMAL true
 
 #define TEST_MIXED true
 
@@ -12,6 +12,10 @@
 #define TEST_FUNCTION true
 
 #define TEST_REAL true
+#define TEST_MULTI_DOUBLE true
+#define TEST_LAZY_REAL true
+#define TEST_DECIMAL true
+#define TEST_SHARED_CORE true
 
 #define TEST_SINGLE_ARG true
 #define TEST_MULTI_ARG true
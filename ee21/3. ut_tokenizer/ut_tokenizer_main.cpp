@@ -62,15 +62,21 @@ the program(s) have been supplied.
 // Tokenizer system
 #include <ee/tokenizer.hpp>
 #include <ee/boolean.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
 #include <ee/function.hpp>
 #include <ee/integer.hpp>
+#include <ee/lazy_real.hpp>
 #include <ee/operator.hpp>
 #include <ee/pseudo_operation.hpp>
+#include <ee/quad_double.hpp>
 #include <ee/real.hpp>
 #include <ee/variable.hpp>
 
 // std
+#include <algorithm>
 #include <string>
+#include <thread>
 using namespace std;
 
 #include "ut_test_phases.hpp"
@@ -421,6 +427,65 @@ GATS_TEST_CASE(unknown_token) {
 			}
 		#endif // TEST_MULTI_ARG
 	#endif // TEST_FUNCTION
+
+	#if TEST_MULTI_DOUBLE
+		GATS_TEST_CASE(lexer_real_backend) {
+			Tokenizer tokenizer;
+			tokenizer.set_real_backend(RealBackend::DoubleDouble);
+			TokenList tokens = tokenizer.tokenize("1.25 pi 7");
+			GATS_CHECK(tokens.size() == 3);
+			GATS_CHECK(is<DoubleDouble>(tokens[0]));
+			GATS_CHECK(tokens[0]->str() == "1.2500000000000000000000000000000");
+			GATS_CHECK(is<DoubleDouble>(tokens[1]));
+			GATS_CHECK(tokens[1]->str() == "3.1415926535897932384626433832795");
+			GATS_CHECK(is<Integer>(tokens[2]));
+
+			tokenizer.set_real_backend(RealBackend::QuadDouble);
+			tokens = tokenizer.tokenize("e");
+			GATS_CHECK(is<QuadDouble>(tokens[0]));
+			GATS_CHECK(tokens[0]->str() == qd_real::e().to_string());
+
+			tokenizer.set_real_backend(RealBackend::Multiprecision);
+			GATS_CHECK(test("1.25", TokenList({ make<Real>(Real::value_type("1.25")) })));
+		}
+	#endif // TEST_MULTI_DOUBLE
+
+	#if TEST_LAZY_REAL
+		GATS_TEST_CASE(lexer_lazy_real) {
+			Tokenizer tokenizer;
+			tokenizer.set_real_backend(RealBackend::Lazy);
+			TokenList tokens = tokenizer.tokenize("2.5 pi");
+			GATS_CHECK(tokens.size() == 2);
+			GATS_CHECK(is<LazyReal>(tokens[0]));
+			GATS_CHECK(value_of<LazyReal>(tokens[0]).to_string(2) == "2.50");
+			GATS_CHECK(is<LazyReal>(tokens[1]));
+			GATS_CHECK(value_of<LazyReal>(tokens[1]).to_string(4) == "3.1416");
+		}
+	#endif // TEST_LAZY_REAL
+
+	#if TEST_DECIMAL
+		GATS_TEST_CASE(lexer_decimal) {
+			Tokenizer tokenizer;
+			TokenList tokens = tokenizer.tokenize("12.50m 3M 0.1 2mod 1.5e");
+			GATS_CHECK(tokens.size() == 7);
+			GATS_CHECK(is<Decimal>(tokens[0]));
+			GATS_CHECK(value_of<Decimal>(tokens[0]).to_string() == "12.500000000000000000");
+			GATS_CHECK(is<Decimal>(tokens[1]));
+			GATS_CHECK(value_of<Decimal>(tokens[1]).raw() == 3 * fixed_decimal::one());
+			GATS_CHECK(is<Real>(tokens[2]));
+			GATS_CHECK(is<Integer>(tokens[3]));		// 'mod' is not a suffix
+			GATS_CHECK(is<Modulus>(tokens[4]));
+			GATS_CHECK(is<Real>(tokens[5]));
+
+			// out of range literals are promoted to Real
+			tokens = tokenizer.tokenize("123456789012345678901.5m");
+			GATS_CHECK(tokens.size() == 1);
+			GATS_CHECK(is<Real>(tokens[0]));
+
+			// a byte outside ASCII after the suffix is not part of an identifier, and is then rejected
+			GATS_CHECK_THROW((void)tokenizer.tokenize("5m\xc3\xa9"), Tokenizer::XBadCharacter);
+		}
+	#endif // TEST_DECIMAL
 #endif // TEST_REAL
 
 
@@ -556,3 +621,37 @@ GATS_TEST_CASE(unknown_token) {
 #endif // TEST_VARIABLE
 
 #endif // TEST_TOKENIZER
+
+
+
+#if TEST_SHARED_CORE
+	GATS_TEST_CASE(lexer_shared_core) {
+		// operator and keyword tokens are shared; variables belong to the session
+		TokenizerSession a, b;
+		TokenList ta = Tokenizer::tokenize("x + sin(1) * 2", a);
+		TokenList tb = Tokenizer::tokenize("x + sin(1) * 2", b);
+		GATS_CHECK(ta.size() == 8 && tb.size() == 8);
+		GATS_CHECK(ta[1].get() == tb[1].get());
+		GATS_CHECK(ta[2].get() == tb[2].get());
+		GATS_CHECK(ta[0].get() != tb[0].get());
+		GATS_CHECK(a.environment.contains("x") && b.environment.contains("x"));
+		GATS_CHECK(Tokenizer::is_keyword("sin") && !Tokenizer::is_keyword("x"));
+
+		// one core, many threads, one session per thread
+		std::vector<std::thread> threads;
+		std::vector<int> ok(8, 0);
+		for (size_t t = 0; t < ok.size(); ++t)
+			threads.emplace_back([t, &ok] {
+				TokenizerSession session;
+				int good = 0;
+				for (int i = 0; i < 200; ++i) {
+					TokenList tokens = Tokenizer::tokenize("v" + std::to_string(i) + " = -(2.5 ** 3) <= max(pi, 7)", session);
+					good += tokens.size() == 15 && is<Variable>(tokens[0]) && is<Negation>(tokens[2]) && is<LessEqual>(tokens[8]);
+				}
+				ok[t] = good == 200 && session.environment.names().size() == 200;
+			});
+		for (auto& thread : threads)
+			thread.join();
+		GATS_CHECK(std::count(ok.begin(), ok.end(), 1) == int(ok.size()));
+	}
+#endif // TEST_SHARED_CORE
@@ -60,6 +60,25 @@ the program(s) have been supplied.
 #include <ee/real.hpp>
 #include <ee/variable.hpp>
 #include <ee/boolean.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
+#include <ee/lazy_real.hpp>
+#include <ee/snapshot.hpp>
+#include <ee/concurrent_evaluator.hpp>
+#include <ee/batch_file.hpp>
+#include <ee/eval_server.hpp>
+#include <ee/shm_ring.hpp>
+#include <ee/expression_cache.hpp>
+#include <ee/expression_generator.hpp>
+#include <ee/differential_harness.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 
 
@@ -618,3 +637,1275 @@ GATS_TEST_CASE( empty_expression ) {
 	#endif // TEST_RESULT
 #endif // TEST_VARIABLE
 
+
+
+#if TEST_RESULT_HISTORY
+	GATS_TEST_CASE(EE_result_history) {
+		ResultHistory history(3);
+		GATS_CHECK(history.push(make_operand<Integer>(10)) == 1);
+		GATS_CHECK(history.push(make_operand<Boolean>(true)) == 2);
+		auto big = make_operand<Integer>(Integer::value_type("123456789012345678901234567890"));
+		GATS_CHECK(history.push(big) == 3);
+		GATS_CHECK(value_of<Integer>(history.at(1)) == 10);
+		GATS_CHECK(value_of<Boolean>(history.at(2)) == true);
+		GATS_CHECK(history.at(3).get() == big.get());		// shared, not copied
+		GATS_CHECK(history.at(2).get() == history.at(2).get());		// the Booleans are shared
+
+		// lookups leave the history unchanged, so const readers may share it
+		{
+			ResultHistory const& reader = history;
+			std::atomic<bool> agreed{ true };
+			std::vector<std::thread> readers;
+			for (int t = 0; t < 4; ++t)
+				readers.emplace_back([&] {
+					for (int i = 0; i < 1000; ++i)
+						if (value_of<Integer>(reader.at(1)) != 10 || value_of<Boolean>(reader.at(2)) != true)
+							agreed = false;
+				});
+			for (auto& r : readers)
+				r.join();
+			GATS_CHECK(agreed);
+		}
+
+		// the ring drops the oldest result but keeps the numbering
+		auto pi = make_operand<Real>(boost::math::constants::pi<Real::value_type>());
+		GATS_CHECK(history.push(pi) == 4);
+		GATS_CHECK(!history.contains(1));
+		GATS_CHECK_THROW((void)history.at(1), std::out_of_range);
+		GATS_CHECK_THROW((void)history.at(5), std::out_of_range);
+		GATS_CHECK(history.at(4).get() == pi.get());
+		GATS_CHECK(history.size() == 3 && history.count() == 4);
+
+		history.set_capacity(2);
+		GATS_CHECK(!history.contains(2));
+		GATS_CHECK(history.at(3).get() == big.get() && history.at(4).get() == pi.get());
+		history.set_capacity(5);
+		GATS_CHECK(history.push(make_operand<Integer>(-7)) == 5);
+		GATS_CHECK(history.at(3).get() == big.get() && value_of<Integer>(history.at(5)) == -7);
+
+		history.clear();
+		GATS_CHECK(history.count() == 0 && !history.contains(1));
+
+		// the ring grows as results arrive, up to the capacity
+		ResultHistory growing;
+		GATS_CHECK(growing.capacity() == ResultHistory::default_capacity && growing.size() == 0);
+		for (int i = 1; i <= 1005; ++i)
+			(void)growing.push(make_operand<Integer>(i));
+		GATS_CHECK(growing.size() == ResultHistory::default_capacity);
+		GATS_CHECK(!growing.contains(5) && value_of<Integer>(growing.at(6)) == 6 && value_of<Integer>(growing.at(1005)) == 1005);
+		growing.clear(20);
+		GATS_CHECK(growing.push(make_operand<Integer>(1)) == 21 && growing.size() == 1);
+		GATS_CHECK(value_of<Integer>(growing.at(21)) == 1);
+
+		ExpressionEvaluator ee;
+		ee.set_history_capacity(10);
+		GATS_CHECK(ee.history().capacity() == 10);
+		GATS_CHECK_THROW((void)ee.result(1), std::out_of_range);
+	}
+#endif // TEST_RESULT_HISTORY
+
+
+
+#if TEST_VARIABLE_BINDING
+	GATS_TEST_CASE(EE_variable_binding) {
+		ExpressionEvaluator ee;
+		double x = 1.5;
+		std::int64_t n = 7;
+		bool flag = false;
+		ee.bind("x", &x);
+		ee.bind("n", &n);
+		ee.bind("flag", &flag);
+		GATS_CHECK(value_of<Real>(ee.get("x")) == Real::value_type(1.5));
+		x = 2.25;
+		n = -3;
+		flag = true;
+		GATS_CHECK(value_of<Real>(ee.get("x")) == Real::value_type(2.25));
+		GATS_CHECK(value_of<Integer>(ee.get("n")) == -3);
+		GATS_CHECK(value_of<Boolean>(ee.get("flag")) == true);
+
+		int calls = 0;
+		ee.bind("tick", [&calls] { return make_operand<Integer>(++calls); });
+		GATS_CHECK(value_of<Integer>(ee.get("tick")) == 1);
+		GATS_CHECK(value_of<Integer>(ee.get("tick")) == 2);
+
+		// an unchanged host value is not converted again
+		auto first = ee.get("x");
+		GATS_CHECK(ee.get("x").get() == first.get());
+		x = 3.75;
+		GATS_CHECK(ee.get("x").get() != first.get() && value_of<Real>(ee.get("x")) == Real::value_type(3.75));
+
+		// a snapshot takes the bound value now and never calls back into the host
+		int before = calls;
+		Environment forked = ee.environment().fork();
+		x = 5.5;
+		GATS_CHECK(value_of<Real>(forked.value("x")) == Real::value_type(3.75));
+		GATS_CHECK(value_of<Integer>(forked.value("tick")) == before + 1 && calls == before + 1);
+		GATS_CHECK(value_of<Integer>(forked.value("tick")) == before + 1 && calls == before + 1);
+		x = 2.25;
+
+		// the tokenizer hands out the bound variable itself
+		Tokenizer tokenizer;
+		tokenizer.variable("y")->bind(&x);
+		TokenList tokens = tokenizer.tokenize("y");
+		GATS_CHECK(value_of<Real>(value_of<Variable>(tokens[0])) == Real::value_type(2.25));
+
+		// typed set() releases the binding
+		ee.set("x", 10);
+		GATS_CHECK(is<Integer>(ee.get("x")));
+		x = 99;
+		GATS_CHECK(value_of<Integer>(ee.get("x")) == 10);
+		ee.set("r", 0.5);
+		GATS_CHECK(value_of<Real>(ee.get("r")) == Real::value_type(0.5));
+		ee.set("b", true);
+		GATS_CHECK(value_of<Boolean>(ee.get("b")) == true);
+		ee.set("big", Integer::value_type("123456789012345678901234567890"));
+		GATS_CHECK(value_of<Integer>(ee.get("big")) == Integer::value_type("123456789012345678901234567890"));
+
+		GATS_CHECK(ee.get("unknown") == nullptr);
+		GATS_CHECK_THROW(ee.set("pi", 3), std::invalid_argument);
+	}
+#endif // TEST_VARIABLE_BINDING
+
+
+
+#if TEST_ENVIRONMENT
+	GATS_TEST_CASE(EE_environment_layers) {
+		// a shared base of constants
+		Environment constants;
+		constants.variable("g")->set(make_operand<Real>(Real::value_type("9.80665")));
+		constants.variable("answer")->set(make_operand<Integer>(42));
+		Environment::base_type base = constants.snapshot();
+
+		ExpressionEvaluator alice, bob;
+		alice.set_environment(Environment(base));
+		bob.set_environment(Environment(base));
+		GATS_CHECK(alice.environment().overlay().empty());
+		GATS_CHECK(value_of<Integer>(alice.get("answer")) == 42);
+
+		// writes are private to the session; the value object is shared until then
+		alice.set("answer", 7);
+		alice.set("mine", true);
+		GATS_CHECK(value_of<Integer>(alice.get("answer")) == 7);
+		GATS_CHECK(value_of<Integer>(bob.get("answer")) == 42);
+		GATS_CHECK(bob.get("mine") == nullptr);
+		GATS_CHECK(bob.get("g").get() == alice.get("g").get());
+		constants.variable("answer")->set(make_operand<Integer>(0));
+		GATS_CHECK(value_of<Integer>(bob.get("answer")) == 42);
+
+		// reading a base name lends a private copy that costs nothing; changing it in place gives the session its own copy
+		Tokenizer tokenizer;
+		tokenizer.set_environment(Environment(base));
+		TokenList tokens = tokenizer.tokenize("g");
+		GATS_CHECK(tokenizer.environment().overlay().empty());
+		GATS_CHECK(value_of<Variable>(tokens[0]).get() == bob.get("g").get());
+		GATS_CHECK(tokenizer.environment().try_variable("g") == tokens[0] && tokens[0] != base->variables.at("g"));
+		(void)alice.evaluate("g");
+		GATS_CHECK(alice.environment().overlay().size() == 2);		// "answer" and "mine", written above
+		auto own = tokenizer.variable("g");
+		GATS_CHECK(tokenizer.environment().overlay().size() == 1 && own == tokens[0]);
+		own->set(make_operand<Integer>(1));
+		GATS_CHECK(value_of<Integer>(tokenizer.environment().value("g")) == 1 && bob.get("g").get() == alice.get("g").get());
+
+		// an assignment through a token changes only its own session, never the shared base
+		Tokenizer carol, dave;
+		carol.set_environment(Environment(base));
+		dave.set_environment(Environment(base));
+		TokenList carols = carol.tokenize("answer"), daves = dave.tokenize("answer");
+		convert<Variable>(carols[0])->set(make_operand<Integer>(5));
+		GATS_CHECK(value_of<Integer>(carol.environment().value("answer")) == 5);
+		GATS_CHECK(value_of<Integer>(dave.environment().value("answer")) == 42 && value_of<Integer>(value_of<Variable>(daves[0])) == 42);
+		GATS_CHECK(value_of<Integer>(base->variables.at("answer")->value()) == 42);
+		GATS_CHECK(value_of<Integer>(Environment(carol.environment().snapshot()).value("answer")) == 5);
+		carol.environment().enforce_limits();
+		GATS_CHECK(carol.environment().overlay().size() == 1 && carol.environment().overlay().at("answer") == carols[0]);
+		GATS_CHECK(dave.environment().overlay().empty() && dave.environment().bytes() == 0);
+
+		// snapshots are frozen
+		Environment before = alice.environment().fork();
+		alice.set("answer", 8);
+		GATS_CHECK(value_of<Integer>(before.value("answer")) == 7);
+		GATS_CHECK(before.contains("mine") && !before.contains("nothing"));
+		GATS_CHECK((before.names() == std::vector<std::string>{ "answer", "g", "mine" }));
+	}
+#endif // TEST_ENVIRONMENT
+
+
+
+#if TEST_SNAPSHOT
+	GATS_TEST_CASE(EE_session_snapshot) {
+		ExpressionEvaluator ee;
+		Integer::value_type big = pow(Integer::value_type(3), 500);
+		Real::value_type third = Real::value_type(1) / 3;
+		ee.set("big", -big);
+		ee.set("third", third);
+		ee.set("flag", true);
+		(void)ee.environment().variable("unset");
+		ee.environment().variable("price")->set(make_decimal_literal("-12.345"));
+		ee.environment().variable("dd")->set(make_operand<DoubleDouble>(dd_real::pi()));
+		ee.set_history_capacity(2);
+		(void)ee.history().push(make_operand<Integer>(1));
+		(void)ee.history().push(make_operand<Integer>(big));
+		(void)ee.history().push(make_operand<Real>(third));
+
+		std::string data = serialize_session(ee);
+		ExpressionEvaluator restored;
+		deserialize_session(restored, data.data(), data.size());
+		GATS_CHECK(value_of<Integer>(restored.get("big")) == -big);
+		GATS_CHECK(value_of<Real>(restored.get("third")) == third);
+		GATS_CHECK(value_of<Boolean>(restored.get("flag")) == true);
+		GATS_CHECK(restored.environment().contains("unset") && restored.get("unset") == nullptr);
+		GATS_CHECK(value_of<Decimal>(restored.get("price")).to_string() == "-12.345000000000000000");
+		GATS_CHECK(value_of<DoubleDouble>(restored.get("dd")) == dd_real::pi());
+		GATS_CHECK(restored.history().count() == 3 && restored.history().capacity() == 2);
+		GATS_CHECK(!restored.history().contains(1));
+		GATS_CHECK(value_of<Integer>(restored.result(2)) == big);
+		GATS_CHECK(value_of<Real>(restored.result(3)) == third);
+
+		// through a file, read back by memory mapping
+		auto path = (std::filesystem::temp_directory_path() / "ee_session_snapshot.bin").string();
+		save_session(ee, path);
+		ExpressionEvaluator loaded;
+		load_session(loaded, path);
+		std::filesystem::remove(path);
+		GATS_CHECK(value_of<Integer>(loaded.get("big")) == -big);
+		GATS_CHECK(value_of<Real>(loaded.result(3)) == third);
+
+		// a damaged snapshot is rejected and leaves the session alone
+		GATS_CHECK_THROW(deserialize_session(loaded, data.data(), data.size() - 1), std::runtime_error);
+		GATS_CHECK_THROW(deserialize_session(loaded, "not a snapshot", 14), std::runtime_error);
+		GATS_CHECK(value_of<Boolean>(loaded.get("flag")) == true);
+		GATS_CHECK_THROW(load_session(loaded, path), std::runtime_error);
+
+		// header 20 bytes, then the variables section (u32 tag, u64 length, payload) and the history section
+		auto const section_length = [](std::string const& bytes, std::size_t at) { std::uint64_t n; std::memcpy(&n, bytes.data() + at + 4, sizeof n); return std::size_t(n); };
+		std::size_t const history_at = 20 + 12 + section_length(data, 20);
+		std::string corrupt = data;
+		std::uint64_t const huge = std::uint64_t(1) << 40;
+		std::memcpy(&corrupt[history_at + 12], &huge, sizeof huge);
+		GATS_CHECK_THROW(deserialize_session(loaded, corrupt.data(), corrupt.size()), std::runtime_error);
+		GATS_CHECK(loaded.history().capacity() == 2 && loaded.history().count() == 3);
+		GATS_CHECK(value_of<Integer>(loaded.get("big")) == -big);
+
+		// a real's fields are checked: digits, sign, class and precision
+		ExpressionEvaluator one_real;
+		one_real.set("r", third);
+		std::string const real_data = serialize_session(one_real);
+		std::size_t const real_end = 20 + 12 + section_length(real_data, 20);		// ... sign u8, class i32, precision i32
+		std::size_t const first_digit = 20 + 12 + 4 + 4 + 1 + 1;
+		auto const damaged = [&](std::size_t at, std::uint32_t value, std::size_t size) {
+			std::string bytes = real_data;
+			std::memcpy(&bytes[at], &value, size);
+			ExpressionEvaluator target;
+			try {
+				deserialize_session(target, bytes.data(), bytes.size());
+			}
+			catch (std::runtime_error const&) {
+				return !target.environment().contains("r");
+			}
+			return false;
+		};
+		GATS_CHECK(damaged(first_digit, 100000000, 4));
+		GATS_CHECK(damaged(real_end - 9, 2, 1));
+		GATS_CHECK(damaged(real_end - 8, 7, 4));
+		GATS_CHECK(damaged(real_end - 4, 0x7fffffff, 4));
+		GATS_CHECK(damaged(real_end - 4, 0, 4));
+		ExpressionEvaluator intact;
+		deserialize_session(intact, real_data.data(), real_data.size());
+		GATS_CHECK(value_of<Real>(intact.get("r")) == third);
+
+		// a decimal's magnitude is checked against its range
+		ExpressionEvaluator one_decimal;
+		one_decimal.environment().variable("d")->set(make_decimal_literal("1.5"));
+		std::string const decimal_data = serialize_session(one_decimal);
+		std::size_t const decimal_high = 20 + 12 + 4 + 4 + 1 + 1 + 1 + 8;		// ... tag u8, sign u8, low u64, high u64
+		auto const bad_decimal = [&](std::uint64_t high) {
+			std::string bytes = decimal_data;
+			std::memcpy(&bytes[decimal_high], &high, sizeof high);
+			ExpressionEvaluator target;
+			try {
+				deserialize_session(target, bytes.data(), bytes.size());
+			}
+			catch (std::runtime_error const&) {
+				return !target.environment().contains("d");
+			}
+			return false;
+		};
+		GATS_CHECK(bad_decimal(std::uint64_t(1) << 63));
+		GATS_CHECK(bad_decimal(std::uint64_t(1) << 60));		// 2^124 > 10^37
+		GATS_CHECK(!bad_decimal(0));
+
+		// loading keeps the session's base layer and variable limits
+		ExpressionEvaluator shared;
+		shared.set("base_only", 7);
+		ExpressionEvaluator layered;
+		layered.set_environment(Environment(shared.environment().snapshot()));
+		VariableLimits const limits{ 64, std::numeric_limits<std::size_t>::max(), VariablePolicy::Reject };
+		layered.set_variable_limits(limits);
+		auto const base = layered.environment().base();
+		deserialize_session(layered, data.data(), data.size());
+		GATS_CHECK(layered.environment().base() == base && value_of<Integer>(layered.get("base_only")) == 7);
+		GATS_CHECK(layered.environment().limits().max_count == 64);
+		GATS_CHECK(value_of<Integer>(layered.get("big")) == -big);
+
+		// a layered session saves only its own variables, however large its base
+		ExpressionEvaluator constants;
+		for (int i = 0; i < 100; ++i)
+			constants.set("k" + std::to_string(i), big);
+		ExpressionEvaluator user, plain;
+		user.set_environment(Environment(constants.environment().snapshot()));
+		(void)user.evaluate("k1");
+		user.set("mine", 1);
+		plain.set("mine", 1);
+		std::string const user_data = serialize_session(user);
+		GATS_CHECK(user_data == serialize_session(plain));
+		ExpressionEvaluator reloaded;
+		reloaded.set_environment(Environment(constants.environment().snapshot()));
+		reloaded.set_variable_limits({ 1, std::numeric_limits<std::size_t>::max(), VariablePolicy::Reject });
+		deserialize_session(reloaded, user_data.data(), user_data.size());
+		GATS_CHECK(reloaded.environment().overlay().size() == 1 && value_of<Integer>(reloaded.get("k99")) == big);
+
+		// too many variables for the limits: rejected, session unchanged
+		layered.set_variable_limits({ 8, std::numeric_limits<std::size_t>::max(), VariablePolicy::Reject });
+		ExpressionEvaluator crowded;
+		for (int i = 0; i < 10; ++i)
+			crowded.set("c" + std::to_string(i), i);
+		std::string const crowded_data = serialize_session(crowded);
+		GATS_CHECK_THROW(deserialize_session(layered, crowded_data.data(), crowded_data.size()), std::runtime_error);
+		GATS_CHECK(!layered.environment().contains("c0") && layered.environment().contains("big"));
+	}
+#endif // TEST_SNAPSHOT
+
+
+
+#if TEST_VARIABLE_LIMITS
+	GATS_TEST_CASE(EE_variable_limits) {
+		ExpressionEvaluator ee;
+		Integer::value_type big = pow(Integer::value_type(2), 4096);
+		ee.set("small", 1);
+		ee.set("big", big);
+		auto listed = ee.variables();
+		GATS_CHECK(listed.size() == 2 && listed[0].name == "big" && listed[1].name == "small");
+		GATS_CHECK(listed[0].bytes >= 4096 / 8 && listed[0].bytes > listed[1].bytes);
+		GATS_CHECK(ee.environment().bytes() == listed[0].bytes + listed[1].bytes);
+
+		// rejection leaves the session unchanged
+		ee.set_variable_limits({ 2, std::numeric_limits<std::size_t>::max(), VariablePolicy::Reject });
+		GATS_CHECK_THROW(ee.set("third", 3), std::length_error);
+		GATS_CHECK_THROW((void)ee.evaluate("fourth"), std::length_error);
+		GATS_CHECK(!ee.environment().contains("third") && ee.variables().size() == 2);
+		Tokenizer rejecting;
+		rejecting.environment().set_limits({ 0, std::numeric_limits<std::size_t>::max(), VariablePolicy::Reject });
+		GATS_CHECK_THROW((void)rejecting.tokenize("1 + fifth"), std::length_error);
+		GATS_CHECK(!rejecting.environment().contains("fifth") && rejecting.environment().overlay().empty());
+		ee.set("small", 2);
+		GATS_CHECK(value_of<Integer>(ee.get("small")) == 2);
+
+		VariableLimits bytes_only;
+		bytes_only.max_bytes = listed[1].bytes * 4;
+		GATS_CHECK_THROW(ee.set_variable_limits(bytes_only), std::length_error);
+		GATS_CHECK(!ee.drop("absent"));
+		GATS_CHECK(ee.drop("big") && !ee.environment().contains("big"));
+		GATS_CHECK(ee.variables().size() == 1);
+		ee.set_variable_limits(bytes_only);
+		GATS_CHECK_THROW(ee.set("small", big), std::length_error);
+		GATS_CHECK(value_of<Integer>(ee.get("small")) == 2);
+
+		// eviction drops the least recently used
+		ExpressionEvaluator lru;
+		lru.set_variable_limits({ 2, std::numeric_limits<std::size_t>::max(), VariablePolicy::EvictLeastRecentlyUsed });
+		lru.set("a", 1);
+		lru.set("b", 2);
+		(void)lru.environment().variable("a");
+		lru.set("c", 3);
+		GATS_CHECK(lru.environment().contains("a") && !lru.environment().contains("b") && lru.environment().contains("c"));
+
+		Environment& env = lru.environment();
+		env.set_limits({ std::numeric_limits<std::size_t>::max(), operand_bytes(make_operand<Integer>(big)), VariablePolicy::EvictLeastRecentlyUsed });
+		lru.set("huge", big);
+		GATS_CHECK(env.overlay().size() == 1 && env.contains("huge"));
+		GATS_CHECK_THROW(lru.set("huge", big * big), std::length_error);
+
+		// a lazy real costs its whole pending expression; a shared subtree counts once
+		lazy_real const third = lazy_real(1) / lazy_real(3);
+		lazy_real deep = third;
+		for (int i = 0; i < 10; ++i)
+			deep = sqrt(deep + lazy_real(i));
+		std::size_t const leaf = operand_bytes(make_operand<LazyReal>(lazy_real(1)));
+		GATS_CHECK(operand_bytes(make_operand<LazyReal>(third)) > leaf);
+		GATS_CHECK(operand_bytes(make_operand<LazyReal>(deep)) >= 10 * (operand_bytes(make_operand<LazyReal>(third)) - leaf));
+		GATS_CHECK((third * third).bytes() < 2 * third.bytes());
+
+		// the running total follows values changed in place through variable()
+		Environment counted;
+		counted.assign("x", make_operand<Integer>(1));
+		counted.variable("x")->set(make_operand<Integer>(big));
+		auto const sum = [&counted] { std::size_t n = 0; for (auto const& v : counted.list()) n += v.bytes; return n; };
+		GATS_CHECK(counted.bytes() == sum() && counted.bytes() >= 4096 / 8);
+		counted.assign("y", make_operand<Integer>(2));
+		GATS_CHECK(counted.bytes() == sum());
+		GATS_CHECK(counted.drop("x") && counted.bytes() == sum());
+
+		// eviction order over many variables, refreshed by reads
+		Environment many;
+		many.set_limits({ 100, std::numeric_limits<std::size_t>::max(), VariablePolicy::EvictLeastRecentlyUsed });
+		for (int i = 0; i < 100; ++i)
+			many.assign("v" + std::to_string(i), make_operand<Integer>(i));
+		for (int i = 0; i < 100; i += 2)
+			(void)many.variable("v" + std::to_string(i));
+		for (int i = 100; i < 150; ++i)
+			many.assign("v" + std::to_string(i), make_operand<Integer>(i));
+		bool order = many.overlay().size() == 100;
+		for (int i = 0; i < 100; ++i)
+			order = order && many.contains("v" + std::to_string(i)) == (i % 2 == 0);
+		GATS_CHECK(order && many.bytes() == [&many] { std::size_t n = 0; for (auto const& v : many.list()) n += v.bytes; return n; }());
+
+		// reading shared base variables is never charged: it neither fails nor evicts at the limits
+		Environment shared;
+		shared.assign("k", make_operand<Integer>(big));
+		for (auto policy : { VariablePolicy::Reject, VariablePolicy::EvictLeastRecentlyUsed }) {
+			ExpressionEvaluator session;
+			session.set_environment(Environment(shared.snapshot()));
+			session.set("own", 1);
+			session.set_variable_limits({ 1, session.environment().bytes(), policy });
+			GATS_CHECK(static_cast<bool>(session.try_evaluate("k")) && static_cast<bool>(session.try_evaluate("own")));
+			GATS_CHECK(session.environment().overlay().size() == 1 && session.environment().contains("own"));
+		}
+	}
+#endif // TEST_VARIABLE_LIMITS
+
+
+
+#if TEST_CONCURRENT_EVALUATOR
+	GATS_TEST_CASE(EE_concurrent_evaluator) {
+		Environment shared;
+		shared.assign("limit", make_operand<Integer>(100));
+		ConcurrentEvaluator pool(4, shared.snapshot());
+		GATS_CHECK(pool.size() == 4);
+
+		// each session keeps its own variables, seeded from the shared base
+		std::vector<std::future<void>> setup;
+		for (ConcurrentEvaluator::session_type s = 0; s < 8; ++s)
+			setup.push_back(pool.with_session(s, [s](ExpressionEvaluator& ee) { ee.set("id", static_cast<int>(s)); }));
+		for (auto& f : setup)
+			f.get();
+
+		std::vector<std::future<ConcurrentEvaluator::result_type>> pending;
+		for (int i = 0; i < 200; ++i)
+			pending.push_back(pool.submit(i % 8, "id"));
+		for (auto& f : pending)
+			(void)f.get();
+		for (ConcurrentEvaluator::session_type s = 0; s < 8; ++s) {
+			auto id = pool.with_session(s, [](ExpressionEvaluator& ee) { return ee.get("id"); }).get();
+			GATS_CHECK(value_of<Integer>(id) == static_cast<int>(s));
+			GATS_CHECK(value_of<Integer>(pool.with_session(s, [](ExpressionEvaluator& ee) { return ee.get("limit"); }).get()) == 100);
+		}
+
+		// sessionless requests leave nothing behind; errors come back through the future
+		(void)pool.evaluate("scratch");
+		GATS_CHECK_THROW((void)pool.evaluate(3, "1 $ 2"), std::exception);
+		pool.end_session(3);
+		GATS_CHECK(pool.with_session(3, [](ExpressionEvaluator& ee) { return ee.get("id"); }).get() == nullptr);
+
+		auto stats = pool.stats();
+		GATS_CHECK(stats.submitted == 202 && stats.completed == 202 && stats.failed == 1);
+		GATS_CHECK(stats.queue_depth == 0 && stats.worker_queue_depth.size() == 4);
+		GATS_CHECK(stats.max_queue_depth >= 1 && stats.throughput() > 0);
+	}
+#endif // TEST_CONCURRENT_EVALUATOR
+
+
+
+#if TEST_EVALUATE_MANY
+	GATS_TEST_CASE(EE_evaluate_many) {
+		ExpressionEvaluator ee;
+		ee.set("x", 5);
+		GATS_CHECK(ee.evaluate_many({}).empty());
+
+		// every seventh expression is malformed; its error must come back at its own index
+		std::vector<std::string> text;
+		for (int i = 0; i < 20000; ++i)
+			text.push_back(i % 7 == 3 ? "1 $ " + std::to_string(i) : "x y" + std::to_string(i % 11));
+		std::vector<std::string_view> views(text.begin(), text.end());
+		auto results = ee.evaluate_many(views);
+		GATS_CHECK(results.size() == text.size());
+		bool in_order = true;
+		for (std::size_t i = 0; i < results.size(); ++i)
+			in_order = in_order && results[i].ok() == (i % 7 != 3);
+		GATS_CHECK(in_order);
+
+		// a malformed item reports the same diagnostic as try_evaluate()
+		std::string_view const malformed[] = { "(1", "1 +", ")", "1 $ 2" };
+		results = ee.evaluate_many(malformed);
+		bool same_errors = true;
+		for (std::size_t i = 0; i < std::size(malformed); ++i) {
+			auto const expected = ee.try_evaluate(std::string(malformed[i]));
+			same_errors = same_errors && !results[i].ok() && !expected && results[i].error == expected.error().message();
+		}
+		GATS_CHECK(same_errors);
+		GATS_CHECK(results[0].error != "Error: evaluation failed");
+
+		// the batch reads the session but does not change it
+		GATS_CHECK(!ee.environment().contains("y0"));
+		GATS_CHECK(value_of<Integer>(ee.get("x")) == 5);
+		GATS_CHECK(ee.history().count() == 0);
+	}
+#endif // TEST_EVALUATE_MANY
+
+
+
+#if TEST_EVALUATE_ASYNC
+	/*! Runs its tasks only when drained, standing in for the caller's event loop. */
+	class ManualExecutor : public Executor {
+		std::mutex							mutex_m;
+		std::vector<Executor::task_type>	tasks_m;
+	public:
+		void post(task_type task) override { std::lock_guard<std::mutex> lock(mutex_m); tasks_m.push_back(std::move(task)); }
+		std::size_t drain() {
+			std::vector<Executor::task_type> tasks;
+			{ std::lock_guard<std::mutex> lock(mutex_m); tasks.swap(tasks_m); }
+			for (auto& task : tasks)
+				task();
+			return tasks.size();
+		}
+	};
+
+	/*! Fire-and-forget coroutine. */
+	struct detached {
+		struct promise_type {
+			detached get_return_object() { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() { }
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	detached await_evaluation(AsyncEvaluation evaluation, int& state) {
+		state = 1;
+		try {
+			(void)co_await evaluation;
+			state = 2;
+		}
+		catch (XEvaluationCancelled const&) {
+			state = 3;
+		}
+	}
+
+	GATS_TEST_CASE(EE_evaluate_async) {
+		ExpressionEvaluator ee;
+		ManualExecutor worker;
+		auto reactor = std::make_shared<ManualExecutor>();
+
+		// nothing runs until the executor does
+		auto a = ee.evaluate_async("x", worker, reactor);
+		bool called = false;
+		a.then([&called](ExpressionEvaluator::result_type, std::exception_ptr error) { called = !error; });
+		GATS_CHECK(!a.ready());
+		GATS_CHECK(worker.drain() == 1);
+		GATS_CHECK(a.ready() && !called);
+		GATS_CHECK(reactor->drain() == 1 && called);
+		GATS_CHECK(!ee.environment().contains("x"));
+
+		// errors are delivered, not thrown at the caller
+		auto bad = ee.evaluate_async("1 $ 2", worker);
+		worker.drain();
+		GATS_CHECK_THROW((void)bad.get(), std::exception);
+
+		// a failed evaluation does not leave the worker holding the caller's cache
+		auto cache = std::make_shared<ExpressionCache>();
+		ee.set_expression_cache(cache);
+		auto failed = ee.evaluate_async("(1", worker);
+		worker.drain();
+		GATS_CHECK(failed.ready() && cache.use_count() == 2);
+		ee.set_expression_cache(nullptr);
+
+		// cancelled before it starts: completes at once and the work is skipped
+		auto c = ee.evaluate_async("y", worker, reactor);
+		int state = 0;
+		await_evaluation(c, state);
+		GATS_CHECK(state == 1);
+		c.cancel();
+		GATS_CHECK(c.ready() && c.stop_token().stop_requested());
+		GATS_CHECK_THROW((void)c.get(), XEvaluationCancelled);
+		GATS_CHECK(state == 1 && reactor->drain() == 1 && state == 3);
+		worker.drain();
+
+		// coroutine resumed on the completion executor
+		auto d = ee.evaluate_async("z", worker, reactor);
+		await_evaluation(d, state);
+		worker.drain();
+		GATS_CHECK(state == 1 && reactor->drain() == 1 && state == 2);
+
+		// the handle does not keep the completion executor alive; once it is gone nothing is posted to it
+		std::weak_ptr<ManualExecutor> gone = reactor;
+		auto e = ee.evaluate_async("v", worker, reactor);
+		called = false;
+		e.then([&called](ExpressionEvaluator::result_type, std::exception_ptr) { called = true; });
+		reactor.reset();
+		GATS_CHECK(gone.expired());
+		worker.drain();
+		GATS_CHECK(e.ready() && !called);
+
+		// the default executor is the shared pool
+		GATS_CHECK(ee.evaluate_async("w").get() == nullptr);
+
+		// a task submitted to the pool reports its exception through the future
+		auto failing = ThreadPool::shared().submit([]() -> int { throw std::runtime_error("Error: task failed"); });
+		GATS_CHECK_THROW((void)failing.get(), std::runtime_error);
+		GATS_CHECK(ThreadPool::shared().submit([] { return 6 * 7; }).get() == 42);
+	}
+#endif // TEST_EVALUATE_ASYNC
+
+
+
+#if TEST_BATCH_FILE
+	GATS_TEST_CASE(EE_batch_file) {
+		GATS_CHECK(split_lines("").empty());
+		GATS_CHECK((split_lines("a\r\nb\n\nc") == std::vector<std::string_view>{ "a", "b", "", "c" }));
+		GATS_CHECK((split_lines("a\n") == std::vector<std::string_view>{ "a" }));
+
+		auto dir = std::filesystem::temp_directory_path();
+		auto input = (dir / "ee_batch_in.txt").string();
+		auto output = (dir / "ee_batch_out.txt").string();
+		{
+			std::ofstream in(input, std::ios::binary);
+			for (int i = 0; i < 1000; ++i)
+				in << (i % 100 == 5 ? "1 $ 2" : "x") << (i % 2 ? "\r\n" : "\n");
+		}
+
+		ExpressionEvaluator ee;
+		BatchReport report = evaluate_file(ee, input, output);
+		GATS_CHECK(report.expressions == 1000 && report.errors == 10);
+		GATS_CHECK(report.per_second() > 0);
+
+		std::ifstream out(output);
+		std::vector<std::string> results;
+		for (std::string line; std::getline(out, line); )
+			results.push_back(line);
+		out.close();
+		GATS_CHECK(results.size() == 1000);
+		GATS_CHECK(!results[105].empty() && results[104].empty() && results[106].empty());
+
+		std::filesystem::remove(input);
+		std::filesystem::remove(output);
+		GATS_CHECK_THROW((void)evaluate_file(ee, input, output), std::runtime_error);
+	}
+#endif // TEST_BATCH_FILE
+
+
+
+#if TEST_EVAL_SERVER && defined(__linux__)
+	GATS_TEST_CASE(EE_eval_server) {
+		auto path = (std::filesystem::temp_directory_path() / "ee_server_test.sock").string();
+		EvalServer server(path, 2);
+		server.start();
+
+		EvalClient client(path);
+		auto reply = client.evaluate("x");
+		GATS_CHECK(reply.ok && reply.text.empty());
+		reply = client.evaluate("1 $ 2");
+		GATS_CHECK(!reply.ok && !reply.text.empty());
+
+		// pipelined requests are answered in order
+		for (int i = 0; i < 100; ++i)
+			client.send(i % 3 ? "x" : "1 $ 2");
+		bool in_order = true;
+		for (int i = 0; i < 100; ++i)
+			in_order = in_order && client.receive().ok == (i % 3 != 0);
+		GATS_CHECK(in_order);
+
+		// a client that half-closes still gets a reply to every request, then the server closes
+		EvalClient closing(path);
+		for (int i = 0; i < 50; ++i)
+			closing.send(i % 2 ? "x" : "1 $ 2");
+		closing.finish();
+		bool answered = true;
+		for (int i = 0; i < 50; ++i)
+			answered = answered && closing.receive().ok == (i % 2 != 0);
+		GATS_CHECK(answered);
+		GATS_CHECK_THROW((void)closing.receive(), std::runtime_error);
+
+		// a client that sends far more than it reads is throttled, and still gets every reply
+		EvalClient slow(path);
+		auto const first = slow.evaluate("1 $ 2");
+		std::size_t const backlog = 2 * EvalServer::max_outbox / (5 + first.text.size()) + 10;		// frame length + status byte + message
+		std::atomic<std::size_t> sent{ 0 };
+		std::thread sender([&] { for (; sent < backlog; ++sent) slow.send("1 $ 2"); });
+		for (std::size_t seen = ~std::size_t(0); seen != sent && sent < backlog;) {		// until the server stops reading
+			seen = sent;
+			std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		}
+		GATS_CHECK(sent < backlog);
+		bool complete = true;
+		for (std::size_t i = 0; i < backlog; ++i) {
+			auto r = slow.receive();
+			complete = complete && !r.ok && r.text == first.text;
+		}
+		sender.join();
+		GATS_CHECK(complete);
+		GATS_CHECK(server.stats().max_queue_depth <= EvalServer::max_in_flight);
+
+		// other connections are served alongside
+		LoadReport load = run_load(path, "y", 3, 200, 8);
+		GATS_CHECK(load.requests == 600 && load.errors == 0);
+		GATS_CHECK(load.p50_us > 0 && load.p99_us >= load.p50_us && load.per_second() > 0);
+
+		GATS_CHECK_THROW(EvalClient("/nonexistent/ee.sock"), std::runtime_error);
+		server.stop();
+	}
+#endif // TEST_EVAL_SERVER
+
+
+
+#if TEST_SHM_RING && defined(__linux__)
+	GATS_TEST_CASE(EE_shm_ring) {
+		// records come back in place and in order across many wrap-arounds
+		ShmRing::header header;
+		header.capacity = 64;
+		std::vector<char> data(64);
+		ShmDoorbell readable, writable;
+		ShmRing writer(&header, data.data(), &readable, &writable), reader(&header, data.data(), &readable, &writable);
+		bool in_order = true;
+		for (int i = 0; i < 50; ++i) {
+			std::string record(i % 20, char('a' + i % 26));
+			in_order = in_order && writer.try_push(record.substr(0, 1), std::string_view(record).substr(std::min<size_t>(1, record.size())));
+			auto front = reader.front();
+			in_order = in_order && front && *front == record && front->data() >= data.data() && front->data() < data.data() + data.size();
+			reader.pop();
+		}
+		GATS_CHECK(in_order && reader.empty());
+
+		// a full ring refuses records until the reader frees room; 4-byte records take 8 bytes
+		ShmRing::header empty_header;
+		empty_header.capacity = 64;
+		ShmRing filler(&empty_header, data.data(), &readable, &writable);
+		int pushed = 0;
+		while (filler.try_push("1234"))
+			++pushed;
+		GATS_CHECK(pushed == 8);
+		GATS_CHECK_THROW((void)writer.try_push(std::string(ShmRing::max_record(64) + 1, 'x')), std::length_error);
+
+		// the reader rejects indices and lengths that reach outside the ring
+		ShmRing::header bad_header;
+		bad_header.capacity = 64;
+		ShmRing bad(&bad_header, data.data(), &readable, &writable);
+		bad_header.head = 72;		// more published than the ring holds
+		GATS_CHECK_THROW((void)bad.front(), std::runtime_error);
+		bad_header.head = 8;
+		std::uint32_t length = 1000;		// longer than any record
+		std::memcpy(data.data(), &length, 4);
+		GATS_CHECK_THROW((void)bad.front(), std::runtime_error);
+		length = 12;		// longer than what was published
+		std::memcpy(data.data(), &length, 4);
+		GATS_CHECK_THROW((void)bad.front(), std::runtime_error);
+		length = 4;
+		std::memcpy(data.data(), &length, 4);
+		GATS_CHECK(bad.front() && bad.front()->size() == 4);
+
+		ShmEvalServer server("ee_shm_test", 2, 2, 4096);
+		server.start();
+		{
+			ShmEvalClient client("ee_shm_test");
+			auto reply = client.evaluate("x");
+			GATS_CHECK(reply.ok && reply.text.empty());
+			reply = client.evaluate("1 $ 2");
+			GATS_CHECK(!reply.ok && !reply.text.empty());
+
+			// pipelined requests are answered in order, and more than fit in the rings at once
+			for (int sent = 0, received = 0; received < 2000; ) {
+				while (sent < 2000 && client.try_send(sent % 3 ? "x" : "1 $ 2"))
+					++sent;
+				in_order = in_order && client.receive().ok == (received++ % 3 != 0);
+			}
+			GATS_CHECK(in_order && client.in_flight() == 0);
+
+			ShmEvalClient other("ee_shm_test");
+			GATS_CHECK(other.evaluate("y").ok);
+			GATS_CHECK_THROW(ShmEvalClient("ee_shm_test"), std::runtime_error);		// both lanes taken
+		}
+		ShmEvalClient again("ee_shm_test");		// lanes are freed by their clients
+		GATS_CHECK(again.evaluate("x").ok);
+		GATS_CHECK_THROW(ShmEvalClient("ee_no_such_segment"), std::runtime_error);
+		server.stop();
+		GATS_CHECK_THROW((void)again.evaluate("x"), std::runtime_error);
+	}
+#endif // TEST_SHM_RING
+
+
+
+#if TEST_EXPRESSION_CACHE
+	GATS_TEST_CASE(EE_expression_cache) {
+		auto cache = std::make_shared<ExpressionCache>();
+		ExpressionEvaluator first, second;
+		first.set_expression_cache(cache);
+		second.set_expression_cache(cache);
+
+		(void)first.evaluate("x");
+		(void)first.evaluate("x");
+		(void)second.evaluate("x");
+		auto stats = cache->stats();
+		GATS_CHECK(stats.misses == 1 && stats.hits == 2 && stats.entries == 1 && stats.bytes > 0);
+
+		// the plan keeps the variable as a name and binds each session's own
+		auto plan = cache->find("x", RealBackend::Multiprecision);
+		GATS_CHECK(plan && plan->variable_count() == 1 && plan->postfix().front() == nullptr);
+		GATS_CHECK(plan->bind(second.environment()).front().get() == second.environment().variable("x").get());
+		GATS_CHECK(plan->bind(first.environment()).front().get() != plan->bind(second.environment()).front().get());
+
+		// the real backend is part of the key, and failures are not cached
+		first.set_real_backend(RealBackend::DoubleDouble);
+		(void)first.evaluate("x");
+		GATS_CHECK(cache->stats().entries == 2);
+		GATS_CHECK_THROW((void)first.evaluate("1 $ 2"), std::exception);
+		GATS_CHECK(cache->stats().entries == 2);
+
+		// byte bounded, least recently used evicted first
+		ExpressionCache small(4096, 1);
+		ExpressionEvaluator ee;
+		ee.set_expression_cache(std::shared_ptr<ExpressionCache>(&small, [](ExpressionCache*) {}));
+		(void)ee.evaluate("keep");
+		bool kept = true;
+		for (int i = 0; i < 200; ++i) {
+			(void)ee.evaluate("v" + std::to_string(i));
+			kept = kept && small.find("keep", RealBackend::Multiprecision) != nullptr;
+		}
+		GATS_CHECK(kept && small.stats().evictions > 0 && small.stats().bytes <= small.capacity());
+		GATS_CHECK(!small.find("v0", RealBackend::Multiprecision));
+		small.clear();
+		GATS_CHECK(small.stats().entries == 0 && small.stats().bytes == 0);
+
+		// the budget is charged for the literals a plan holds
+		ExpressionCache literal_cache;
+		ExpressionEvaluator literal;
+		literal.set_literal_parameters(false);
+		literal.set_expression_cache(std::shared_ptr<ExpressionCache>(&literal_cache, [](ExpressionCache*) {}));
+		std::string sum = "1.5";
+		for (int i = 1; i < 1000; ++i)
+			sum += "+1.5";
+		(void)literal.try_evaluate(sum);		// cached when compiled, whatever the evaluation gives
+		std::size_t const reals = literal_cache.stats().bytes;
+		GATS_CHECK(reals >= 1000 * operand_bytes(make_operand<Real>(Real::value_type("1.5"))));
+		literal_cache.clear();
+		(void)literal.evaluate("1.5");
+		std::size_t const one_real = literal_cache.stats().bytes;
+		literal_cache.clear();
+		(void)literal.evaluate("1");
+		GATS_CHECK(one_real > literal_cache.stats().bytes);
+
+		// many threads, one cache
+		auto shared = std::make_shared<ExpressionCache>();
+		{
+			ConcurrentEvaluator pool(4, nullptr, shared);
+			std::vector<std::future<ConcurrentEvaluator::result_type>> futures;
+			for (int i = 0; i < 2000; ++i)
+				futures.push_back(pool.submit(i % 8, "t" + std::to_string(i % 10)));
+			for (auto& f : futures)
+				(void)f.get();
+		}
+		stats = shared->stats();
+		GATS_CHECK(stats.entries == 10 && stats.hits + stats.misses == 2000 && stats.hits >= 1990);
+	}
+#endif // TEST_EXPRESSION_CACHE
+
+
+#if TEST_LITERAL_PARAMETERS
+	GATS_TEST_CASE(EE_literal_parameters) {
+		ParameterizedExpression p;
+		std::string expr = "SIN( x )*2.5+ 3";
+		GATS_CHECK(Tokenizer::parameterize(expr, p));
+		GATS_CHECK(p.text == "sin ( x ) * # + #" && p.tokens == 8);
+		GATS_CHECK(p.literals.size() == 2 && p.literals[0] == "2.5" && p.literals[1] == "3");
+		GATS_CHECK(p.literal_tokens[0] == 5 && p.literal_tokens[1] == 7);
+
+		// token boundaries follow the tokenizer: decimal suffix, '<=' against '< =', case of variables
+		expr = "12.50m*2max";
+		GATS_CHECK(Tokenizer::parameterize(expr, p) && p.text == "# * # max" && p.literals[0] == "12.50m");
+		GATS_CHECK(Tokenizer::parameterize(expr = "a<=b", p) && p.text == "a <= b");
+		GATS_CHECK(Tokenizer::parameterize(expr = "a< =b", p) && p.text == "a < = b");
+		GATS_CHECK(Tokenizer::parameterize(expr = "X + x", p) && p.text == "X + x");
+		GATS_CHECK(!Tokenizer::parameterize(expr = "1 $ 2", p));
+
+		// a plan made from one expression, bound with another's literals, is that expression's parse
+		Tokenizer tokenizer;
+		Parser parser;
+		GATS_CHECK(Tokenizer::parameterize(expr = "max(2, y) ** 3", p));
+		VariableNames names;
+		tokenizer.session().variable_names = &names;
+		TokenList infix = tokenizer.tokenize(expr);
+		tokenizer.session().variable_names = nullptr;
+		GATS_CHECK(names.size() == 1 && names[0].first == infix[4].get() && names[0].second == "y");
+		CompiledExpression plan(parser.parse(infix), names, infix, p);
+		GATS_CHECK(plan.literal_count() == 2 && plan.variable_count() == 1);
+		GATS_CHECK(Tokenizer::parameterize(expr = "MAX( 7.5,y)**4", p));
+		TokenList bound = plan.bind(tokenizer.environment(), p.literals, RealBackend::Multiprecision);
+		TokenList expected = parser.parse(tokenizer.tokenize(expr));
+		GATS_CHECK(bound.size() == expected.size() && std::equal(bound.begin(), bound.end(), expected.begin(),
+			[](Token::pointer_type const& a, Token::pointer_type const& b) { return a.get() == b.get() || (is<Operand>(a) && a->str() == b->str()); }));
+		GATS_CHECK(is<Real>(bound[0]) && is<Integer>(bound[3]));
+		GATS_CHECK_THROW((void)plan.bind(tokenizer.environment()), std::invalid_argument);
+
+		// sessions share one entry for expressions that differ only in their constants
+		auto cache = std::make_shared<ExpressionCache>();
+		ExpressionEvaluator ee;
+		ee.set_expression_cache(cache);
+		(void)ee.evaluate("y");
+		(void)ee.evaluate("12");
+		(void)ee.evaluate(" 99 ");
+		(void)ee.evaluate("1.5");
+		GATS_CHECK(cache->stats().entries == 2 && cache->stats().hits == 2);
+
+		// a variable evicted while tokenizing the same expression still gets its slot
+		ExpressionEvaluator tight;
+		tight.set_variable_limits({ 1, std::numeric_limits<std::size_t>::max(), VariablePolicy::EvictLeastRecentlyUsed });
+		tight.set_expression_cache(std::make_shared<ExpressionCache>());
+		bool compiled = true;
+		try {
+			(void)tight.evaluate("a + b");
+		}
+		catch (std::logic_error const&) {
+			compiled = false;
+		}
+		catch (...) {
+		}
+		GATS_CHECK(compiled);
+		tight.set_literal_parameters(false);
+		bool no_throw = true;
+		try {
+			(void)tight.try_evaluate("c * d");
+		}
+		catch (...) {
+			no_throw = false;
+		}
+		GATS_CHECK(no_throw);
+		GATS_CHECK(cache->find("#", RealBackend::Multiprecision) != nullptr);
+
+		// off: keyed by the exact text
+		ee.set_literal_parameters(false);
+		(void)ee.evaluate("12");
+		GATS_CHECK(cache->find("12", RealBackend::Multiprecision) != nullptr);
+	}
+#endif // TEST_LITERAL_PARAMETERS
+
+
+#if TEST_TRY_EVALUATE
+	GATS_TEST_CASE(EE_try_evaluate) {
+		ExpressionEvaluator ee;
+		GATS_CHECK(ee.try_evaluate("x").has_value());
+
+		// each stage's error, at the character where it was found
+		auto error = [&](std::string const& expr) { auto result = ee.try_evaluate(expr); return result ? EvalError{} : result.error(); };
+		GATS_CHECK(error("1 $ 2") == (EvalError{ EvalErrc::bad_character, 2 }));
+		GATS_CHECK(error(" (x") == (EvalError{ EvalErrc::missing_right_parenthesis, 1 }));
+		GATS_CHECK(error("x )") == (EvalError{ EvalErrc::unmatched_right_parenthesis, 2 }));
+		GATS_CHECK(error("x, y") == (EvalError{ EvalErrc::misplaced_separator, 1 }));
+		GATS_CHECK(error("1 +") == (EvalError{ EvalErrc::insufficient_operands, 2 }));
+		GATS_CHECK(*error("1 $ 2").message() != '\0');
+
+		// the same offsets through a cached plan
+		ee.set_expression_cache(std::make_shared<ExpressionCache>());
+		GATS_CHECK(error("1 +") == (EvalError{ EvalErrc::insufficient_operands, 2 }));
+		GATS_CHECK(error("  12 +") == (EvalError{ EvalErrc::insufficient_operands, 5 }));
+		GATS_CHECK(error("1 $ 2") == (EvalError{ EvalErrc::bad_character, 2 }));
+
+		// a plan hit maps the error from its own source map, without compiling again
+		ee.set_metrics(true);
+		GATS_CHECK(error("345  +") == (EvalError{ EvalErrc::insufficient_operands, 5 }));
+		GATS_CHECK(ee.metrics()->last().cached);
+		ee.set_literal_parameters(false);
+		GATS_CHECK(error("1 +") == (EvalError{ EvalErrc::insufficient_operands, 2 }));
+		GATS_CHECK(error("1 +") == (EvalError{ EvalErrc::insufficient_operands, 2 }));
+		GATS_CHECK(ee.metrics()->last().cached);
+		ee.set_literal_parameters(true);
+		ee.set_metrics(false);
+
+		// a new variable refused by the session's limits
+		VariableLimits limits;
+		limits.max_count = 1;
+		limits.policy = VariablePolicy::Reject;
+		ExpressionEvaluator limited;
+		limited.set_variable_limits(limits);
+		GATS_CHECK(limited.try_evaluate("a").has_value());
+		auto refused = limited.try_evaluate("a b");
+		GATS_CHECK(!refused && refused.error() == (EvalError{ EvalErrc::variable_limit, 2 }));
+
+		// the throwing interface is unchanged
+		GATS_CHECK_THROW((void)ee.evaluate("(x"), char const*);
+		GATS_CHECK_THROW((void)ee.evaluate("1 $ 2"), Tokenizer::XBadCharacter);
+		GATS_CHECK_THROW((void)limited.evaluate("c"), std::length_error);
+	}
+#endif // TEST_TRY_EVALUATE
+
+
+#if TEST_EVALUATION_LIMITS
+	GATS_TEST_CASE(EE_evaluation_limits) {
+		GATS_CHECK(EvaluationBudget::power_bits(2, 100) == 101);
+		GATS_CHECK(EvaluationBudget::power_bits(-1, 1000000) == 1 && EvaluationBudget::power_bits(7, -3) == 1);
+		GATS_CHECK(std::abs(EvaluationBudget::factorial_bits(10) - (std::log2(3628800.0) + 1)) < 1e-6);
+
+		// predictable results are refused before they are built, at the operation
+		ExpressionEvaluator ee;
+		auto error = [&](std::string const& expr) { auto result = ee.try_evaluate(expr); return result ? EvalError{} : result.error(); };
+		GATS_CHECK(error("10 ** 100000000") == (EvalError{ EvalErrc::integer_limit, 3 }));
+		GATS_CHECK(error("pow(2, 100000000)") == (EvalError{ EvalErrc::integer_limit, 0 }));
+		GATS_CHECK(error("100000000!") == (EvalError{ EvalErrc::integer_limit, 9 }));
+		GATS_CHECK(error("10 ** 100000") == EvalError{});
+		GATS_CHECK_THROW((void)ee.evaluate("10 ** 100000000"), char const*);
+
+		EvaluationLimits limits;
+		limits.max_integer_bits = 64;
+		ee.set_evaluation_limits(limits);
+		GATS_CHECK(error("2 ** 63") == EvalError{});
+		GATS_CHECK(error("2 ** 64").code == EvalErrc::integer_limit);
+		ee.set("big", Integer::value_type(1) << 100);
+		GATS_CHECK(error("big").code == EvalErrc::integer_limit);
+
+		limits = EvaluationLimits();
+		limits.max_postfix_length = 3;
+		ee.set_evaluation_limits(limits);
+		GATS_CHECK(error("x y z") == EvalError{});
+		GATS_CHECK(error("x y z w").code == EvalErrc::length_limit);
+
+		limits = EvaluationLimits();
+		limits.max_real_digits = 100;
+		ee.set_evaluation_limits(limits);
+		GATS_CHECK(error("1.5").code == EvalErrc::precision_limit);
+		ee.set_real_backend(RealBackend::DoubleDouble);
+		GATS_CHECK(error("1.5") == EvalError{});
+
+		limits = EvaluationLimits();
+		limits.max_intermediate_bytes = 1;
+		ee.set_evaluation_limits(limits);
+		GATS_CHECK(error("1").code == EvalErrc::memory_limit);
+
+		// batches run with the session's limits
+		std::string_view exprs[] = { "x", "2 ** 64" };
+		limits = EvaluationLimits();
+		limits.max_integer_bits = 64;
+		ee.set_evaluation_limits(limits);
+		auto results = ee.evaluate_many(exprs);
+		GATS_CHECK(results[0].ok() && !results[1].ok());
+	}
+#endif // TEST_EVALUATION_LIMITS
+
+
+#if TEST_EVALUATION_METRICS
+	GATS_TEST_CASE(EE_evaluation_metrics) {
+		Histogram h;
+		for (std::uint64_t v : { 0, 1, 2, 3, 1000 })
+			h.record(v);
+		GATS_CHECK(h.count() == 5 && h.sum() == 1006 && h.min() == 0 && h.max() == 1000);
+		GATS_CHECK(h.bucket(0) == 1 && h.bucket(2) == 2 && h.bucket(10) == 1);
+		GATS_CHECK(h.percentile(0.5) == 3);
+		GATS_CHECK(h.percentile(1.0) == 1000);
+
+		GATS_CHECK(EvaluationMetrics::result_digits(make_operand<Integer>(12345)) == 5);
+		GATS_CHECK(EvaluationMetrics::result_digits(make_operand<Integer>(-9)) == 1);
+		auto const big = EvaluationMetrics::result_digits(make_operand<Integer>(boost::multiprecision::pow(Integer::value_type(10), 30)));
+		GATS_CHECK(big == 30 || big == 31);
+		GATS_CHECK(EvaluationMetrics::result_digits(make_operand<Boolean>(true)) == 1);
+
+		// off by default; on, every evaluation is measured
+		ExpressionEvaluator ee;
+		GATS_CHECK(ee.metrics() == nullptr);
+		ee.set_metrics(true);
+		auto const installed = EvaluationMetrics::allocation_counter();
+		EvaluationMetrics::set_allocation_counter([]() noexcept -> std::uint64_t { static std::uint64_t n = 0; return n += 5; });
+		(void)ee.evaluate("42");
+		auto const* metrics = ee.metrics();
+		GATS_CHECK(metrics != nullptr && metrics->evaluations() == 1 && metrics->failures() == 0);
+		GATS_CHECK(metrics->last().infix_tokens == 1 && metrics->last().postfix_tokens == 1 && metrics->last().max_stack_depth == 1);
+		GATS_CHECK(metrics->last().allocations == 5 && metrics->last().ok && !metrics->last().cached);
+		EvaluationMetrics::set_allocation_counter(installed);
+
+		GATS_CHECK_THROW((void)ee.evaluate("(1"), char const*);
+		GATS_CHECK(!ee.try_evaluate("1 + "));
+		GATS_CHECK(metrics->evaluations() == 3 && metrics->failures() == 2);
+		GATS_CHECK(metrics->histogram(EvaluationMetrics::Measure::infix_tokens).max() == 2);
+
+		// a cached plan skips the tokenizer and parser
+		ee.set_expression_cache(std::make_shared<ExpressionCache>(1 << 16));
+		(void)ee.try_evaluate("x");
+		(void)ee.try_evaluate("x");
+		GATS_CHECK(metrics->last().cached && metrics->last().infix_tokens == 0 && metrics->last().tokenize_ns == 0);
+		GATS_CHECK(metrics->cached() == 1);
+
+		std::ostringstream report;
+		metrics->report(report);
+		GATS_CHECK(report.str().find("evaluations 5") != std::string::npos && report.str().find("max_stack_depth") != std::string::npos);
+
+		ee.reset_metrics();
+		GATS_CHECK(metrics->evaluations() == 0);
+		ee.set_metrics(false);
+		GATS_CHECK(ee.metrics() == nullptr);
+	}
+#endif // TEST_EVALUATION_METRICS
+
+
+#if TEST_OPERATION_PROFILER
+	GATS_TEST_CASE(EE_operation_profiler) {
+		GATS_CHECK(OperationProfiler::type_name(typeid(Power)) == "Power");
+		GATS_CHECK(OperationProfiler::type_name(typeid(Integer)) == "Integer");
+
+		// the evaluator applies no operation yet, so it records none
+		ExpressionEvaluator ee;
+		auto profiler = std::make_shared<OperationProfiler>();
+		ee.set_operation_profiler(profiler);
+		(void)ee.evaluate("5!");
+		(void)ee.try_evaluate("2 ** 3");
+		GATS_CHECK(profiler->size() == 0 && profiler->total_ns() == 0);
+
+		// costs are kept by operation and operand types
+		auto const factorial = make<Factorial>();
+		auto const power = make<Power>();
+		auto const negation = make<Not>();
+		Token::pointer_type const integers[] = { make_operand<Integer>(2), make_operand<Integer>(3) };
+		Token::pointer_type const mixed[] = { Tokenizer().variable("r"), make_operand<Integer>(2) };
+		convert<Variable>(mixed[0])->set(make_operand<Real>(Real::value_type(1.5)));
+		Token::pointer_type const truth[] = { make_operand<True>() };
+		profiler->record(*convert<Operation>(factorial), std::span(integers).first(1), 1, 100, 0);
+		profiler->record(*convert<Operation>(factorial), std::span(integers).last(1), 1, 300, 2);
+		profiler->record(*convert<Operation>(power), integers, 2, 50, 1);
+		profiler->record(*convert<Operation>(power), mixed, 2, 700, 4);
+		profiler->record(*convert<Operation>(negation), truth, 1, 10, 0);
+
+		auto entries = profiler->ranked();
+		auto calls = [&](std::string const& operation, std::string const& operands) -> std::uint64_t {
+			auto found = std::find_if(entries.begin(), entries.end(), [&](auto const& e) { return e.operation == operation && e.operands == operands; });
+			return found == entries.end() ? 0 : found->calls;
+		};
+		GATS_CHECK(entries.size() == 4);
+		GATS_CHECK(calls("Factorial", "Integer") == 2);
+		GATS_CHECK(calls("Power", "Integer,Integer") == 1);
+		GATS_CHECK(calls("Power", "Real,Integer") == 1);		// a variable counts as its value
+		GATS_CHECK(calls("Not", "True") == 1);		// the dynamic type of the operand
+		GATS_CHECK(std::is_sorted(entries.begin(), entries.end(), [](auto const& a, auto const& b) { return a.ns > b.ns; }));
+		GATS_CHECK(entries.front().operands == "Real,Integer" && profiler->total_ns() == 1160);
+
+		std::ostringstream folded, report;
+		profiler->folded(folded, OperationProfiler::Weight::calls);
+		GATS_CHECK(folded.str().find("evaluate;Factorial;Integer 2\n") != std::string::npos);
+		folded.str("");
+		profiler->folded(folded, OperationProfiler::Weight::allocations);
+		GATS_CHECK(folded.str().find("evaluate;Factorial;Integer 2\n") != std::string::npos);
+		profiler->report(report);
+		GATS_CHECK(report.str().find("Power(Real,Integer)") != std::string::npos);
+
+		// with spans, each place an operation is written is kept apart
+		profiler->reset();
+		profiler->set_spans(true);
+		std::uint32_t const offsets[] = { 2, 3, 0, 1 };
+		profiler->set_offsets(offsets);
+		profiler->record(*convert<Operation>(factorial), std::span(integers).first(1), 1, 10, 0);
+		profiler->record(*convert<Operation>(factorial), std::span(integers).first(1), 3, 10, 0);
+		profiler->set_offsets({});
+		entries = profiler->ranked();
+		GATS_CHECK(entries.size() == 2);
+		folded.str("");
+		profiler->folded(folded, OperationProfiler::Weight::calls);
+		GATS_CHECK(folded.str().find("evaluate;Factorial@3;Integer 1\n") != std::string::npos);
+		GATS_CHECK(folded.str().find("evaluate;Factorial@1;Integer 1\n") != std::string::npos);
+
+		OperationProfiler other;
+		other.merge(*profiler);
+		other.merge(*profiler);
+		GATS_CHECK(other.size() == 2 && other.total_ns() == 40);
+	}
+#endif // TEST_OPERATION_PROFILER
+
+
+#if TEST_ALLOCATION_TRACKING
+	GATS_TEST_CASE(EE_allocation_tracking) {
+		GATS_CHECK(AllocationTracker::installed());
+		GATS_CHECK(EvaluationMetrics::allocation_counter() == &AllocationTracker::thread_allocations);
+
+		// allocations are charged to the current stage, which a scope restores
+		auto const before = AllocationTracker::thread_stage(AllocationStage::format);
+		{
+			AllocationStageScope formatting(AllocationStage::format);
+			GATS_CHECK(AllocationTracker::current_stage() == AllocationStage::format);
+			auto block = std::make_unique<std::uint64_t[]>(4);
+		}
+		GATS_CHECK(AllocationTracker::current_stage() == AllocationStage::other);
+		auto const made = AllocationTracker::thread_stage(AllocationStage::format) - before;
+		GATS_CHECK(made.allocations == 1 && made.bytes >= 4 * sizeof(std::uint64_t) && made.deallocations == 1);
+
+		// each evaluation gets an id and its allocations by stage
+		ExpressionEvaluator ee;
+		(void)ee.evaluate("1 + x");
+		AllocationProfile const first = ee.last_allocations();
+		GATS_CHECK(first.evaluation_id != 0);
+		GATS_CHECK(first[AllocationStage::tokenize].allocations > 0 && first[AllocationStage::parse].allocations > 0);
+		GATS_CHECK(first[AllocationStage::format] == AllocationCounts{});
+		(void)ee.try_evaluate("1 + x");
+		GATS_CHECK(ee.last_allocations().evaluation_id > first.evaluation_id);
+		GATS_CHECK(AllocationTracker::current_evaluation() == 0);
+
+		// steady state: parameterizing into reused storage allocates nothing
+		Tokenizer::string_type const text = "max(12, y) * 3.5";
+		ParameterizedExpression reused;
+		(void)Tokenizer::parameterize(text, reused);
+		auto const warm = AllocationTracker::thread_total();
+		for (int i = 0; i < 100; ++i)
+			(void)Tokenizer::parameterize(text, reused);
+		GATS_CHECK((AllocationTracker::thread_total() - warm).allocations == 0);
+
+		// the metrics read the same counter
+		ee.set_metrics(true);
+		(void)ee.evaluate("2 * 3");
+		GATS_CHECK(ee.metrics()->last().allocations == ee.last_allocations().total().allocations);
+	}
+#endif // TEST_ALLOCATION_TRACKING
+
+
+#if TEST_DIFFERENTIAL_FUZZ
+	GATS_TEST_CASE(EE_differential_fuzz) {
+		GeneratorOptions options;
+		options.max_operations = 12;
+		options.variables = 2;
+		options.decimal_share = 0.25;
+
+		// a seed always gives the same corpus
+		auto const corpus = ExpressionGenerator(options, 42).corpus(200);
+		GATS_CHECK(corpus == ExpressionGenerator(options, 42).corpus(200));
+		GATS_CHECK(corpus != ExpressionGenerator(options, 43).corpus(200));
+
+		// every expression is well formed
+		ExpressionEvaluator ee;
+		ee.set("v0", 2);
+		ee.set("v1", 3);
+		Tokenizer tokenizer;
+		tokenizer.set_environment(ee.environment().fork());
+		Parser parser;
+		bool parsed = true;
+		for (auto const& expr : corpus) {
+			auto infix = tokenizer.try_tokenize(expr);
+			parsed = parsed && infix && parser.try_parse(infix.value());
+		}
+		GATS_CHECK(parsed);
+
+		// a bounded size and the asked-for type
+		options.min_operations = options.max_operations = 0;
+		ExpressionGenerator single(options);
+		auto const literal = single.next(ExpressionGenerator::Type::boolean);
+		GATS_CHECK(DifferentialHarness::lexemes(literal).size() == 1);
+
+		// the paths agree on the corpus
+		DifferentialHarness harness([](ExpressionEvaluator& session) {
+			session.set("v0", 2);
+			session.set("v1", 3);
+		});
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < 50; ++i)
+			mismatches += harness.check(corpus[i]).has_value();
+		GATS_CHECK(mismatches == 0);
+		auto const results = harness.run("v0");
+		GATS_CHECK(DifferentialHarness::agree(results) && results[0].ok);
+
+		// minimizing keeps the failure and drops the rest
+		GATS_CHECK(DifferentialHarness::lexemes("max(12, v0)**2 != 3.5m") == (std::vector<std::string>{ "max", "(", "12", ",", "v0", ")", "**", "2", "!=", "3.5m" }));
+		auto const fails = [](std::string const& expr) { return expr.find("sqrt") != std::string::npos; };
+		GATS_CHECK(DifferentialHarness::minimize("(1 + (sqrt(2.50) * 4)) - v0", fails) == "sqrt");
+		GATS_CHECK(DifferentialHarness::minimize("abs(-(sqrt(v1)))", [](std::string const& expr) { return expr.find("(sqrt(v1))") != std::string::npos; }) == "(sqrt(v1))");
+		GATS_CHECK(DifferentialHarness::minimize("1 + 2", fails, 0) == "1 + 2");
+	}
+#endif // TEST_DIFFERENTIAL_FUZZ
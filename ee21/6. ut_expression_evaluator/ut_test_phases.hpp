@@ -34,5 +34,24 @@
 
 #define TEST_VARIABLE false
 #define TEST_RESULT false
-
-
+#define TEST_RESULT_HISTORY true
+#define TEST_VARIABLE_BINDING true
+#define TEST_ENVIRONMENT true
+#define TEST_SNAPSHOT true
+
+
+#define TEST_VARIABLE_LIMITS true
+#define TEST_CONCURRENT_EVALUATOR true
+#define TEST_EVALUATE_MANY true
+#define TEST_EVALUATE_ASYNC true
+#define TEST_BATCH_FILE true
+#define TEST_EVAL_SERVER true
+#define TEST_SHM_RING true
+#define TEST_EXPRESSION_CACHE true
+#define TEST_LITERAL_PARAMETERS true
+#define TEST_TRY_EVALUATE true
+#define TEST_EVALUATION_LIMITS true
+#define TEST_EVALUATION_METRICS true
+#define TEST_OPERATION_PROFILER true
+#define TEST_ALLOCATION_TRACKING true
+#define TEST_DIFFERENTIAL_FUZZ true
@@ -0,0 +1,239 @@
+/*!	\file	ee_bench.cpp
+	\brief	Microbenchmarks of the expression evaluator's pipeline stages.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Times Tokenizer::tokenize, Parser::parse, RPNEvaluator::evaluate and
+ExpressionEvaluator::evaluate on generated expressions of several
+sizes, for each operand category of the marker tests (integer, real,
+boolean, mixed), and prints the results as JSON:
+
+	ee_bench [--filter text] [--sizes 1,8,64] [--min-time ms]
+
+Each case runs until at least --min-time milliseconds have passed
+and reports nanoseconds per operation, input tokens per second and
+heap allocations (and bytes) per operation.  Allocations are counted
+by AllocationTracker, through the library's allocation_hooks.cpp.  "ok" is false
+when the stage throws for that expression; the time then includes
+the throw.
+
+Built on Linux with the Makefile beside this file.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Allocations are counted by AllocationTracker instead of a local operator new.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/allocation_tracking.hpp>
+#include <ee/expression_evaluator.hpp>
+#include <ee/parser.hpp>
+#include <ee/RPNEvaluator.hpp>
+#include <ee/tokenizer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// ---------- expressions ---------------------------------------------------------------------------
+
+namespace {
+	char const* const types[] = { "integer", "real", "boolean", "mixed" };
+
+	/*! An expression of about 'operands' operands of the given category. */
+	string make_expression(string const& type, size_t operands) {
+		static char const* const arithmetic[] = { " + ", " * ", " - ", " / " };
+		static char const* const logical[] = { " and ", " or ", " xor " };
+
+		ostringstream out;
+		if (type == "mixed") {
+			// (integer + real > integer), joined by boolean operators
+			for (size_t i = 0, units = max<size_t>(operands / 3, 1); i < units; ++i) {
+				if (i)
+					out << logical[i % 2];
+				out << '(' << 11 + i % 89 << " + " << 2 + i % 7 << ".5 > " << 7 + i % 13 << ')';
+			}
+			return out.str();
+		}
+
+		for (size_t i = 0; i < operands; ++i) {
+			if (type == "boolean") {
+				if (i)
+					out << logical[i % 3];
+				out << (i % 2 ? "false" : "true");
+			}
+			else {
+				if (i)
+					out << arithmetic[i % 4];
+				out << 11 + i % 89;
+				if (type == "real")
+					out << ".25";
+			}
+		}
+		return out.str();
+	}
+
+
+
+	// ---------- measurement ---------------------------------------------------------------------------
+
+	struct measurement {
+		bool		ok = true;
+		uint64_t	iterations = 0;
+		double		ns_per_op = 0;
+		double		allocs_per_op = 0;
+		double		bytes_per_op = 0;
+	};
+
+	/*! Runs 'body' in growing batches until one batch takes at least 'min_ns'.  'body' returns false if the stage threw. */
+	measurement measure(function<bool()> const& body, double min_ns) {
+		using clock = chrono::steady_clock;
+		measurement m;
+		m.ok = body();		// also warms up caches and lazily built state
+
+		for (uint64_t iterations = 1;; ) {
+			AllocationCounts const before = AllocationTracker::thread_total();
+			auto const start = clock::now();
+			for (uint64_t i = 0; i < iterations; ++i)
+				body();
+			double const elapsed = chrono::duration<double, nano>(clock::now() - start).count();
+
+			if (elapsed >= min_ns || iterations >= (uint64_t(1) << 40)) {
+				m.iterations = iterations;
+				m.ns_per_op = elapsed / double(iterations);
+				AllocationCounts const made = AllocationTracker::thread_total() - before;
+				m.allocs_per_op = double(made.allocations) / double(iterations);
+				m.bytes_per_op = double(made.bytes) / double(iterations);
+				return m;
+			}
+			// aim a little past the target so the next batch is normally the last
+			double const scale = elapsed > 0 ? 1.2 * min_ns / elapsed : 10.0;
+			iterations = max<uint64_t>(iterations * 2, static_cast<uint64_t>(double(iterations) * min(scale, 100.0)));
+		}
+	}
+
+	volatile size_t sink;		// keeps results observable so the work is not optimized away
+
+	/*! Runs 'stage'; false if it threw (the evaluator reports errors as char const* as well as exceptions). */
+	template <typename Stage>
+	bool succeeds(Stage&& stage) {
+		try {
+			stage();
+			return true;
+		}
+		catch (...) {
+			return false;
+		}
+	}
+
+	struct options {
+		string			filter;
+		vector<size_t>	sizes{ 1, 8, 64, 512 };
+		double			min_ns = 200e6;
+	};
+
+	options parse_options(int argc, char* argv[]) {
+		options opt;
+		for (int i = 1; i < argc; ++i) {
+			string arg(argv[i]);
+			bool const has_value = i + 1 < argc;
+			if (arg == "--filter" && has_value)
+				opt.filter = argv[++i];
+			else if (arg == "--min-time" && has_value)
+				opt.min_ns = stod(argv[++i]) * 1e6;
+			else if (arg == "--sizes" && has_value) {
+				opt.sizes.clear();
+				istringstream list(argv[++i]);
+				for (string item; getline(list, item, ',');)
+					opt.sizes.push_back(stoul(item));
+			}
+			else {
+				cerr << "usage: ee_bench [--filter text] [--sizes n,n,...] [--min-time ms]\n";
+				exit(arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE);
+			}
+		}
+		return opt;
+	}
+}
+
+
+
+int main(int argc, char* argv[]) {
+	options const opt = parse_options(argc, argv);
+	if (!AllocationTracker::installed())
+		cerr << "ee_bench: built without allocation_hooks.cpp; allocations read as zero\n";
+
+	cout << "{\n  \"context\": { \"compiler\": \"" <<
+#if defined(__clang__)
+		"clang " << __clang_version__
+#elif defined(__GNUC__)
+		"g++ " << __VERSION__
+#else
+		"unknown"
+#endif
+		<< "\", \"min_time_ms\": " << opt.min_ns / 1e6 << " },\n  \"benchmarks\": [";
+
+	bool first = true;
+	auto report = [&](string const& stage, string const& type, size_t size, size_t tokens, function<bool()> const& body) {
+		string const name = stage + "/" + type + "/" + to_string(size);
+		if (name.find(opt.filter) == string::npos)
+			return;
+		measurement const m = measure(body, opt.min_ns);
+		char line[512];
+		snprintf(line, sizeof line,
+			"%s\n    { \"name\": \"%s\", \"stage\": \"%s\", \"type\": \"%s\", \"size\": %zu, \"tokens\": %zu, \"ok\": %s, "
+			"\"iterations\": %llu, \"ns_per_op\": %.1f, \"tokens_per_s\": %.0f, \"allocs_per_op\": %.2f, \"bytes_per_op\": %.1f }",
+			first ? "" : ",", name.c_str(), stage.c_str(), type.c_str(), size, tokens, m.ok ? "true" : "false",
+			static_cast<unsigned long long>(m.iterations), m.ns_per_op, double(tokens) * 1e9 / m.ns_per_op, m.allocs_per_op, m.bytes_per_op);
+		cout << line << flush;
+		first = false;
+	};
+
+	for (string const type : types) {
+		for (size_t size : opt.sizes) {
+			string const expr = make_expression(type, size);
+
+			Tokenizer tokenizer;
+			Parser parser;
+			RPNEvaluator rpn;
+			ExpressionEvaluator ee;
+			TokenList const infix = tokenizer.tokenize(expr);
+			TokenList const postfix = parser.parse(infix);
+
+			report("tokenize", type, size, infix.size(), [&] { sink = tokenizer.tokenize(expr).size(); return true; });
+			report("parse", type, size, infix.size(), [&] { sink = parser.parse(infix).size(); return true; });
+			report("rpn", type, size, postfix.size(), [&] { return succeeds([&] { sink = rpn.evaluate(postfix) != nullptr; }); });
+			report("evaluate", type, size, infix.size(), [&] { return succeeds([&] { sink = ee.evaluate(expr) != nullptr; }); });
+		}
+	}
+
+	cout << "\n  ]\n}\n";
+}
@@ -9,6 +9,12 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added try_evaluate(); evaluate() throws its error.
+	Added EvaluationLimits.
+	Added max_depth().
+	Added set_profiler().
+
 Version 2021.11.01
 	C++ 20 validated
 	Changed to GATS_TEST
@@ -33,11 +39,35 @@ the program(s) have been supplied.
 =============================================================*/
 
 #include <ee/operand.hpp>
+#include <ee/eval_error.hpp>
+#include <ee/evaluation_limits.hpp>
+#include <ee/operation_profiler.hpp>
 
 class RPNEvaluator {
 	RPNEvaluator(RPNEvaluator const&) = delete;
 	RPNEvaluator& operator = (RPNEvaluator const&) = delete;
+
+	EvaluationLimits	limits_m;
+	std::size_t			max_depth_m = 0;
+	OperationProfiler*	profiler_m = nullptr;
 public:
 	RPNEvaluator() = default;
+
+	/*! Caps applied to each evaluation; see EvaluationBudget. */
+	void set_limits(EvaluationLimits const& limits) { limits_m = limits; }
+	[[nodiscard]] EvaluationLimits const& limits() const { return limits_m; }
+
+	/*! The profiler (not owned) that applied operations are to be timed into; nullptr stops profiling.
+		Operations are not applied yet, so nothing is recorded. */
+	void set_profiler(OperationProfiler* profiler) { profiler_m = profiler; }
+	[[nodiscard]] OperationProfiler* profiler() const { return profiler_m; }
+
+	/*! The deepest the operand stack grew during the last evaluation. */
+	[[nodiscard]] std::size_t max_depth() const { return max_depth_m; }
+
+	/*! @throw char const* describing the error. */
 	[[nodiscard]] Operand::pointer_type evaluate( TokenList const& container );
+
+	/*! As evaluate(), but returns the error instead of throwing; its offset is the index of the postfix token. */
+	[[nodiscard]] EvalExpected<Operand::pointer_type> try_evaluate( TokenList const& container );
 };
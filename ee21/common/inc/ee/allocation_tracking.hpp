@@ -0,0 +1,141 @@
+#pragma once
+/*!	\file	allocation_tracking.hpp
+	\brief	AllocationTracker, AllocationStageScope and AllocationProfile declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Exact heap allocation counts, attributed to the pipeline stage that
+made them and to the evaluation in progress.
+
+Counting is optional.  A program turns it on by building
+allocation_hooks.cpp, which replaces the global operator new and
+delete with versions that report to AllocationTracker; without it
+installed() is false and every count reads zero.  The unit tests
+and the benchmark build it; the ee application does not.
+
+The evaluator marks its stages with AllocationStageScope (tokenize,
+parse, evaluate; the batch, server and shared memory front ends mark
+format) and each ExpressionEvaluator::evaluate() and try_evaluate()
+gets an evaluation id.  Counts are kept per thread, so a test can
+check the allocations of a piece of code without interference:
+
+	auto before = AllocationTracker::thread_stage(AllocationStage::parse);
+	(void)parser.parse(infix);
+	auto made = AllocationTracker::thread_stage(AllocationStage::parse) - before;
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+/*! The part of the pipeline an allocation is charged to. */
+enum class AllocationStage : std::uint8_t {
+	other,			//!< outside any marked stage
+	tokenize,
+	parse,
+	evaluate,		//!< binding a plan and running the RPN evaluator
+	format,			//!< turning results into text
+};
+inline constexpr std::size_t allocation_stage_count = static_cast<std::size_t>(AllocationStage::format) + 1;
+
+
+
+/*! Allocation counts of one stage, thread or evaluation. */
+struct AllocationCounts {
+	std::uint64_t	allocations = 0;
+	std::uint64_t	bytes = 0;				// requested by the allocations
+	std::uint64_t	deallocations = 0;
+
+	AllocationCounts& operator += (AllocationCounts const& other) {
+		allocations += other.allocations;
+		bytes += other.bytes;
+		deallocations += other.deallocations;
+		return *this;
+	}
+	[[nodiscard]] AllocationCounts operator - (AllocationCounts const& earlier) const {
+		return AllocationCounts{ allocations - earlier.allocations, bytes - earlier.bytes, deallocations - earlier.deallocations };
+	}
+	bool operator == (AllocationCounts const&) const = default;
+};
+
+
+
+/*! The allocations of one evaluation, by stage. */
+struct AllocationProfile {
+	std::uint64_t	evaluation_id = 0;		// 0 if nothing was tracked
+	std::array<AllocationCounts, allocation_stage_count>	stages{};
+
+	[[nodiscard]] AllocationCounts const& operator [] (AllocationStage stage) const { return stages[static_cast<std::size_t>(stage)]; }
+	[[nodiscard]] AllocationCounts total() const;
+};
+
+
+
+/*! The calling thread's counts.  All members are static; the hooks and the evaluator report here. */
+class AllocationTracker {
+public:
+	/*! True if allocation_hooks.cpp is part of the program. */
+	[[nodiscard]] static bool installed();
+
+	[[nodiscard]] static AllocationCounts thread_total();
+	[[nodiscard]] static AllocationCounts thread_stage(AllocationStage stage);
+	[[nodiscard]] static AllocationStage current_stage();
+
+	/*! The id of the evaluation running on this thread; 0 outside of one. */
+	[[nodiscard]] static std::uint64_t current_evaluation();
+
+	/*! This thread's allocation count; the counter allocation_hooks.cpp installs for EvaluationMetrics. */
+	[[nodiscard]] static std::uint64_t thread_allocations() noexcept;
+
+	/*! Called by the replaced operator new and delete.  They must not allocate. */
+	static void on_allocate(std::size_t bytes) noexcept;
+	static void on_deallocate() noexcept;
+	static void mark_installed() noexcept;
+
+	/*! Charges a stage for its lifetime, then restores the stage it interrupted. */
+	class StageScope {
+		AllocationStage	previous_m;
+	public:
+		explicit StageScope(AllocationStage stage) noexcept;
+		~StageScope();
+		StageScope(StageScope const&) = delete;
+		StageScope& operator = (StageScope const&) = delete;
+	};
+
+	/*! Gives the calling thread a new evaluation id for its lifetime and, when it ends, writes the
+		allocations made meanwhile into 'profile'.  Does nothing unless installed(). */
+	class EvaluationScope {
+		AllocationProfile*	profile_m = nullptr;
+		std::uint64_t		previous_m = 0;
+		std::array<AllocationCounts, allocation_stage_count>	start_m;
+	public:
+		explicit EvaluationScope(AllocationProfile& profile) noexcept;
+		~EvaluationScope();
+		EvaluationScope(EvaluationScope const&) = delete;
+		EvaluationScope& operator = (EvaluationScope const&) = delete;
+	};
+};
+
+using AllocationStageScope = AllocationTracker::StageScope;
@@ -0,0 +1,111 @@
+#pragma once
+/*!	\file	async_evaluation.hpp
+	\brief	AsyncEvaluation class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declaration of the AsyncEvaluation class: the handle returned by
+ExpressionEvaluator::evaluate_async().
+
+The handle can be waited on like a future, given callbacks, or
+co_awaited from a C++20 coroutine.  Callbacks and the resumed
+coroutine run on the completion executor named at launch (the
+caller's reactor, say), or on the evaluating thread if there is
+none.  The completion executor is held weakly: the handle does not
+keep it alive, and once it is destroyed what would have run on it
+is dropped.  cancel() completes the evaluation at once with
+XEvaluationCancelled; an evaluation that has not started yet is
+skipped, one already running finishes and its result is dropped.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	The completion executor is held by weak_ptr.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/thread_pool.hpp>
+#include <ee/token.hpp>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+
+/*! The exception an AsyncEvaluation completes with when it is cancelled. */
+class XEvaluationCancelled : public std::runtime_error {
+public:
+	XEvaluationCancelled() : std::runtime_error("Error: evaluation cancelled") { }
+};
+
+
+
+class AsyncEvaluation {
+public:
+	using result_type = Token::pointer_type;
+	using callback_type = std::function<void(result_type, std::exception_ptr)>;
+
+	/*! Shared between the handle and the evaluating task. */
+	struct state {
+		std::mutex						mutex_m;
+		std::condition_variable			done_m;
+		bool							finished_m = false;
+		result_type						value_m;
+		std::exception_ptr				error_m;
+		std::stop_source				stop_m;
+		std::weak_ptr<Executor>			completion_m;
+		bool							has_completion_m = false;	// else deliver on the completing thread
+		std::vector<callback_type>		callbacks_m;
+		std::coroutine_handle<>			continuation_m;
+
+		/*! Stores the outcome and delivers the callbacks and continuation; false if it was already complete. */
+		bool complete(result_type value, std::exception_ptr error);
+
+		void deliver(Executor::task_type task);
+	};
+
+private:
+	std::shared_ptr<state>	state_m;
+
+public:
+	explicit AsyncEvaluation(std::shared_ptr<state> s) : state_m(std::move(s)) { }
+
+	[[nodiscard]] bool ready() const;
+	void wait() const;
+
+	/*! Waits, then returns the result or rethrows the evaluation's exception. */
+	[[nodiscard]] result_type get() const;
+
+	/*! Completes the evaluation with XEvaluationCancelled unless it has already finished. */
+	void cancel();
+	[[nodiscard]] std::stop_token stop_token() const { return state_m->stop_m.get_token(); }
+
+	/*! Calls callback(result, error) on completion; at once (via the completion executor) if already complete. */
+	void then(callback_type callback);
+
+	// awaitable
+	[[nodiscard]] bool await_ready() const { return ready(); }
+	bool await_suspend(std::coroutine_handle<> continuation);
+	result_type await_resume() const { return get(); }
+};
@@ -0,0 +1,59 @@
+#pragma once
+/*!	\file	batch_file.hpp
+	\brief	Batch file evaluation declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Evaluates a file of expressions, one per line, writing one result
+line per input line in the same order.
+
+The input is memory mapped and split into string_views over the
+mapping, so lines are never copied before the tokenizer sees them.
+Lines are evaluated in blocks with ExpressionEvaluator::evaluate_many()
+and written through a large output buffer.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/expression_evaluator.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+struct BatchReport {
+	std::size_t	expressions = 0;
+	std::size_t	errors = 0;
+	double		seconds = 0;
+
+	[[nodiscard]] double per_second() const { return seconds > 0 ? expressions / seconds : 0; }
+};
+
+
+/*! The lines of 'text' as views into it; a trailing '\r' is dropped and a final newline ends no extra line. */
+[[nodiscard]] std::vector<std::string_view> split_lines(std::string_view text);
+
+/*! Evaluates each line of 'input' in the session 'ee' and writes the results to 'output'.
+	A result line holds the value, the error message, or nothing if there was no value.
+	@throw std::runtime_error if a file cannot be read or written. */
+BatchReport evaluate_file(ExpressionEvaluator const& ee, std::string const& input, std::string const& output);
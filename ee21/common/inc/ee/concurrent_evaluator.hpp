@@ -0,0 +1,123 @@
+#pragma once
+/*!	\file	concurrent_evaluator.hpp
+	\brief	ConcurrentEvaluator class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declaration of the ConcurrentEvaluator class: a thread-safe front
+door to a pool of ExpressionEvaluators.
+
+ExpressionEvaluator is single-threaded, so each worker thread owns
+its evaluators outright and nothing in them is ever locked.  A
+session always lands on the same worker (session id modulo the
+worker count), so its variables and Result history live on that
+thread alone.  Sessionless requests go to the worker with the
+shortest queue.  Each worker has its own queue and counters, so
+workers never contend with each other.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Sessions can share an ExpressionCache.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/expression_evaluator.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+class ConcurrentEvaluator {
+public:
+	using expression_type = ExpressionEvaluator::expression_type;
+	using result_type = ExpressionEvaluator::result_type;
+	using session_type = std::uint64_t;
+	using job_type = std::packaged_task<void()>;
+
+	struct statistics {
+		std::uint64_t				submitted = 0;
+		std::uint64_t				completed = 0;		// including failed
+		std::uint64_t				failed = 0;			// evaluations that threw
+		std::size_t					queue_depth = 0;	// waiting now, all workers
+		std::size_t					max_queue_depth = 0;	// deepest any one worker's queue has been
+		std::vector<std::size_t>	worker_queue_depth;
+		double						seconds = 0;		// since construction
+
+		/*! Completed evaluations per second. */
+		[[nodiscard]] double throughput() const { return seconds > 0 ? completed / seconds : 0; }
+	};
+
+private:
+	struct worker;
+
+	std::vector<std::unique_ptr<worker>>	workers_m;
+	Environment::base_type					base_m;
+	std::shared_ptr<ExpressionCache>		cache_m;
+	std::chrono::steady_clock::time_point	start_m;
+
+public:
+	/*! Starts 'threads' workers.  Every session starts from the variables in 'base'
+		and, if 'cache' is given, shares its parsed expressions. */
+	explicit ConcurrentEvaluator(std::size_t threads = 0, Environment::base_type base = nullptr, std::shared_ptr<ExpressionCache> cache = nullptr);
+
+	/*! Finishes the queued work and joins the workers. */
+	~ConcurrentEvaluator();
+
+	ConcurrentEvaluator(ConcurrentEvaluator const&) = delete;
+	ConcurrentEvaluator& operator = (ConcurrentEvaluator const&) = delete;
+
+	/*! Evaluates in the session's own evaluator; requests for one session run in submission order. */
+	[[nodiscard]] std::future<result_type> submit(session_type session, expression_type expr);
+
+	/*! Evaluates with no session state: fresh variables each time, on the least busy worker. */
+	[[nodiscard]] std::future<result_type> submit(expression_type expr);
+
+	/*! Blocking forms of the above. */
+	[[nodiscard]] result_type evaluate(session_type session, expression_type expr) { return submit(session, std::move(expr)).get(); }
+	[[nodiscard]] result_type evaluate(expression_type expr) { return submit(std::move(expr)).get(); }
+
+	/*! Runs f(ExpressionEvaluator&) on the session's evaluator, in order with its evaluations.
+		Use it for set(), bind(), result() and the like. */
+	template <typename F>
+	[[nodiscard]] auto with_session(session_type session, F f) -> std::future<std::invoke_result_t<F&, ExpressionEvaluator&>> {
+		using R = std::invoke_result_t<F&, ExpressionEvaluator&>;
+		std::packaged_task<R()> task([this, session, f = std::move(f)]() mutable { return f(_session(session)); });
+		auto future = task.get_future();
+		_post(_worker_for(session), job_type(std::move(task)));
+		return future;
+	}
+
+	/*! Discards the session's evaluator once the requests already submitted for it have run. */
+	void end_session(session_type session);
+
+	[[nodiscard]] statistics stats() const;
+
+	[[nodiscard]] std::size_t size() const { return workers_m.size(); }
+
+private:
+	[[nodiscard]] std::size_t _worker_for(session_type session) const { return static_cast<std::size_t>(session % workers_m.size()); }
+	[[nodiscard]] ExpressionEvaluator& _session(session_type session);
+	void _post(std::size_t index, job_type job);
+	void _run(worker& w);
+};
@@ -0,0 +1,136 @@
+#pragma once
+/*!	\file	decimal.hpp
+	\brief	Decimal class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declarations of the fixed_decimal value type and the Decimal class
+derived from Operand.
+
+A fixed_decimal is a 128-bit integer count of 10^-18 units: 18
+fractional digits and up to 19 integer digits, all exact.  Results
+that leave that range are promoted to Real by the mixed-type
+kernels rather than wrapping.
+
+	enum class RoundingMode
+	class fixed_decimal
+	class Decimal
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/operand.hpp>
+#include <ee/integer.hpp>
+#include <ee/real.hpp>
+#include <string>
+
+
+/*! Rounding applied when a result has more than 18 fractional digits. */
+enum class RoundingMode {
+	HalfEven,			//!< nearest, ties to even (banker's rounding)
+	HalfUp,				//!< nearest, ties away from zero
+	TowardZero,			//!< truncate
+	Floor,				//!< toward negative infinity
+	Ceiling				//!< toward positive infinity
+};
+
+
+/*! Fixed-point decimal with 18 fractional digits. */
+class fixed_decimal {
+public:
+#if defined(__SIZEOF_INT128__)
+	using raw_type = __int128;
+#else
+	using raw_type = boost::multiprecision::int128_t;	// MSVC has no native 128-bit integer
+#endif
+
+	static constexpr int fraction_digits = 18;
+	static constexpr int integer_digits = 19;
+
+	/*! 10^18, the value of one unit. */
+	[[nodiscard]] static raw_type one();
+
+	/*! Exclusive bound on |raw()|, 10^37. */
+	[[nodiscard]] static raw_type limit();
+
+private:
+	raw_type	raw_m = 0;
+
+public:
+	fixed_decimal() = default;
+	[[nodiscard]] static fixed_decimal from_raw(raw_type raw);
+
+	/*! Conversions; each returns false when the value is outside the representable range. */
+	[[nodiscard]] static bool from_string(std::string const& digits, fixed_decimal& result, RoundingMode mode = RoundingMode::HalfEven);
+	[[nodiscard]] static bool from_integer(Integer::value_type const& value, fixed_decimal& result);
+
+	[[nodiscard]] raw_type			raw() const { return raw_m; }
+	[[nodiscard]] std::string		to_string() const;
+	[[nodiscard]] Real::value_type	to_real() const;
+
+	/*! Checked kernels; each returns false on overflow and leaves 'result' unspecified. */
+	[[nodiscard]] static bool add(fixed_decimal a, fixed_decimal b, fixed_decimal& result);
+	[[nodiscard]] static bool subtract(fixed_decimal a, fixed_decimal b, fixed_decimal& result);
+	[[nodiscard]] static bool multiply(fixed_decimal a, fixed_decimal b, fixed_decimal& result, RoundingMode mode = RoundingMode::HalfEven);
+	[[nodiscard]] static bool divide(fixed_decimal a, fixed_decimal b, fixed_decimal& result, RoundingMode mode = RoundingMode::HalfEven);
+
+	[[nodiscard]] friend fixed_decimal operator - (fixed_decimal a) { return from_raw(-a.raw_m); }
+
+	[[nodiscard]] friend bool operator == (fixed_decimal a, fixed_decimal b) { return a.raw_m == b.raw_m; }
+	[[nodiscard]] friend bool operator != (fixed_decimal a, fixed_decimal b) { return a.raw_m != b.raw_m; }
+	[[nodiscard]] friend bool operator <  (fixed_decimal a, fixed_decimal b) { return a.raw_m < b.raw_m; }
+	[[nodiscard]] friend bool operator >  (fixed_decimal a, fixed_decimal b) { return a.raw_m > b.raw_m; }
+	[[nodiscard]] friend bool operator <= (fixed_decimal a, fixed_decimal b) { return a.raw_m <= b.raw_m; }
+	[[nodiscard]] friend bool operator >= (fixed_decimal a, fixed_decimal b) { return a.raw_m >= b.raw_m; }
+};
+
+
+
+/*! Fixed-point decimal token. */
+class Decimal : public Operand {
+public:
+	DEF_POINTER_TYPE(Decimal)
+	using value_type = fixed_decimal;
+private:
+	value_type	value_;
+public:
+	Decimal(value_type value = value_type()) : value_(value) { }
+	[[nodiscard]] value_type	value() const { return value_; }
+	[[nodiscard]] string_type	str() const override;
+};
+
+
+
+/*! Decimal literal: a Decimal, or a Real when the literal is out of range. */
+[[nodiscard]] Operand::pointer_type make_decimal_literal(std::string const& digits, RoundingMode mode = RoundingMode::HalfEven);
+
+/*! Mixed-type arithmetic over Integer, Decimal and the real types.
+	Integer with Decimal gives Decimal; otherwise the result has the most precise real type present,
+	ranked DoubleDouble, QuadDouble, Real, LazyReal; a Decimal result that overflows is recomputed as a Real.
+	Any other operand throws std::domain_error. */
+[[nodiscard]] Operand::pointer_type decimal_add(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs);
+[[nodiscard]] Operand::pointer_type decimal_subtract(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs);
+[[nodiscard]] Operand::pointer_type decimal_multiply(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs, RoundingMode mode = RoundingMode::HalfEven);
+[[nodiscard]] Operand::pointer_type decimal_divide(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs, RoundingMode mode = RoundingMode::HalfEven);
+
+/*! Three-way comparison of Integer, Decimal and real operands, in the same type as the arithmetic. */
+[[nodiscard]] int decimal_compare(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs);
@@ -0,0 +1,127 @@
+#pragma once
+/*!	\file	differential_harness.hpp
+	\brief	DifferentialHarness class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Runs one expression through every evaluation path of the library
+and reports where they disagree.
+
+The paths are:
+	evaluate		ExpressionEvaluator::evaluate()
+	try_evaluate	ExpressionEvaluator::try_evaluate()
+	cached			evaluate() through an ExpressionCache shared by
+					every run, so plans made for one expression are
+					bound with the literals of the next
+	cached_exact	the same, with literal parameters off
+	batch			evaluate_many()
+	async			evaluate_async()
+	pipeline		Tokenizer, Parser and RPNEvaluator called directly
+
+Every path gets a fresh session prepared by the harness's setup
+function, so no path sees another's variables or history.  Paths
+agree when they all succeed with the same value text, or all fail;
+error messages may differ between the throwing and non-throwing
+paths and are kept only for the report.
+
+minimize() shrinks a disagreeing expression, deleting tokens and
+unwrapping parentheses for as long as the paths still disagree; its
+static form does the same for any other failure predicate.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/expression_cache.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class ExpressionEvaluator;
+
+
+class DifferentialHarness {
+public:
+	/*! An evaluation path. */
+	enum class Path : std::uint8_t { evaluate, try_evaluate, cached, cached_exact, batch, async, pipeline };
+	static constexpr std::size_t path_count = static_cast<std::size_t>(Path::pipeline) + 1;
+
+	/*! What one path made of an expression. */
+	struct outcome {
+		bool		ok = false;
+		std::string	text;		// the value's str() ("" for no value), or the error message
+
+		/*! Same success and, on success, the same value. */
+		[[nodiscard]] bool agrees(outcome const& other) const { return ok == other.ok && (!ok || text == other.text); }
+	};
+
+	using outcomes = std::array<outcome, path_count>;
+
+	/*! A disagreement. */
+	struct mismatch {
+		std::string	expression;
+		std::string	minimized;
+		outcomes	results;		// of the minimized expression
+	};
+
+	/*! Prepares each path's fresh session, e.g. by assigning the variables the expressions use. */
+	using setup_type = std::function<void(ExpressionEvaluator&)>;
+
+	explicit DifferentialHarness(setup_type setup = setup_type());
+
+	/*! Evaluates 'expr' on every path. */
+	[[nodiscard]] outcomes run(std::string const& expr);
+
+	/*! The disagreement on 'expr', minimized, if the paths disagree. */
+	[[nodiscard]] std::optional<mismatch> check(std::string const& expr);
+
+	/*! A shorter expression on which the paths still disagree; 'expr' itself if none is found
+		within 'max_runs' runs.  'expr' must be one they disagree on. */
+	[[nodiscard]] std::string minimize(std::string const& expr, std::size_t max_runs = 2000);
+
+	/*! The same search for any failure: a shorter expression for which 'fails' is still true,
+		calling it at most 'max_runs' times. */
+	[[nodiscard]] static std::string minimize(std::string const& expr, std::function<bool(std::string const&)> const& fails, std::size_t max_runs = 2000);
+
+	/*! True if every path agrees with the first. */
+	[[nodiscard]] static bool agree(outcomes const& results);
+
+	/*! The path names and their outcomes, one per line. */
+	static void report(std::ostream& out, mismatch const& m);
+
+	[[nodiscard]] static char const* name(Path path);
+
+	/*! Splits an expression into tokens for minimize(): names, numbers, operators and parentheses. */
+	[[nodiscard]] static std::vector<std::string> lexemes(std::string const& expr);
+
+private:
+	setup_type							setup_m;
+	std::shared_ptr<ExpressionCache>	cache_m;
+	std::shared_ptr<ExpressionCache>	exact_cache_m;
+
+	[[nodiscard]] outcome _run(Path path, std::string const& expr);
+};
@@ -0,0 +1,207 @@
+#pragma once
+/*!	\file	environment.hpp
+	\brief	Environment class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declaration of the Environment class: a session's variables.
+
+An environment is a private overlay on top of a chain of frozen,
+shared layers.  Sessions are created from a frozen base in O(1).
+The shared variables are never handed out: looking up a base
+variable gives the session a private copy (the operand value itself
+is immutable and stays shared), which joins the overlay once the
+session writes it (assign(), variable(), or in place through a
+token), so nothing a session does is visible to another.
+snapshot() freezes the overlay into a new layer.
+
+The overlay is what a session costs, so it is what is accounted:
+limits on the number of variables and on the bytes their values
+occupy are enforced by rejecting the change or by evicting the
+least recently used variables.  Only variables the session creates
+or writes are charged; reading a base variable never is.  The byte total and the recency order
+are kept up to date as variables change, so a change near the limits
+costs O(log n) rather than a pass over every variable.  Variables
+handed out by variable() may be changed in place (by an evaluated
+assignment, or a binding); they are re-measured at the next change
+or enforce_limits().
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Added memory accounting, limits and LRU eviction.
+	Added try_variable() and try_enforce_limits().
+	Running byte total and recency index instead of recounting and scanning on each change.
+	Base variables are copied into the overlay when written, not when read.
+	Lookups hand out a private copy of a base variable, never the shared one.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/variable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+/*! Bytes held by an operand's value, including big-number limbs. */
+[[nodiscard]] std::size_t operand_bytes(Operand::pointer_type const& value);
+
+
+/*! What happens when a change would exceed a session's variable limits. */
+enum class VariablePolicy {
+	Reject,					//!< throw std::length_error and leave the environment unchanged
+	EvictLeastRecentlyUsed	//!< drop the variables unused for longest until the change fits
+};
+
+
+struct VariableLimits {
+	std::size_t		max_count = std::numeric_limits<std::size_t>::max();
+	std::size_t		max_bytes = std::numeric_limits<std::size_t>::max();
+	VariablePolicy	policy = VariablePolicy::Reject;
+};
+
+
+class Environment {
+public:
+	using string_type = Token::string_type;
+	using dictionary_type = std::map<string_type, Variable::pointer_type>;
+
+	/*! A frozen layer: never modified once published. */
+	struct layer {
+		std::map<string_type, std::shared_ptr<Variable const>>	variables;
+		std::shared_ptr<layer const>							parent;
+	};
+	using base_type = std::shared_ptr<layer const>;
+
+private:
+	/*! Accounting of one overlay variable. */
+	struct usage {
+		std::size_t		bytes = 0;			// of its value when last measured
+		std::uint64_t	last_use = 0;		// its key in recency_m
+		bool			pending = false;	// handed out since then, so possibly changed in place
+	};
+
+	base_type		base_m;
+	dictionary_type	overlay_m;
+	VariableLimits	limits_m;
+	std::map<string_type, usage>			usage_m;
+	std::map<std::uint64_t, string_type>	recency_m;		// least recently used first
+	std::vector<string_type>				pending_m;		// names to re-measure
+
+	/*! A private copy of a base variable, handed out by try_variable() but not yet written. */
+	struct borrowed {
+		Variable::pointer_type			copy;
+		std::shared_ptr<Variable const>	shared;
+		bool							lent = false;	// on lent_m
+		[[nodiscard]] bool changed() const { return copy->is_bound() || copy->value() != shared->value(); }
+	};
+	std::map<string_type, borrowed>		borrowed_m;
+	std::vector<string_type>				lent_m;			// borrowed names to check for changes
+	std::size_t		bytes_m = 0;			// sum of usage_m bytes
+	std::uint64_t	clock_m = 0;
+
+public:
+	Environment() = default;
+
+	/*! A new session over a frozen base.  O(1). */
+	explicit Environment(base_type base) : base_m(std::move(base)) { }
+
+	/*! The session's own copy of the named variable, to change in place; copied from the base or created if needed.
+		@throw std::length_error if a new variable would exceed the limits under VariablePolicy::Reject. */
+	[[nodiscard]] Variable::pointer_type variable(string_type const& name);
+
+	/*! The named variable for a token list: the session's own, else a private copy of the base variable
+		(uncharged until it is changed), else a new session variable; nullptr if a new one would exceed
+		the limits under Reject. */
+	[[nodiscard]] Variable::pointer_type try_variable(string_type const& name);
+
+	/*! Assigns a value, enforcing the byte limit before anything changes.
+		@throw std::length_error if the value cannot be made to fit. */
+	void assign(string_type const& name, Operand::pointer_type const& value);
+
+	/*! Current value of the named variable, or nullptr if it is unknown. */
+	[[nodiscard]] Operand::pointer_type value(string_type const& name) const;
+
+	[[nodiscard]] bool contains(string_type const& name) const;
+
+	/*! Freezes base + overlay into a shareable layer; costs one copy per overlay variable.
+		A bound variable is frozen at its current value, so the layer never calls back into the host. */
+	[[nodiscard]] base_type snapshot() const;
+
+	/*! A new session that starts from this one's current state. */
+	[[nodiscard]] Environment fork() const { return Environment(snapshot()); }
+
+	/*! Names visible in this environment, sorted. */
+	[[nodiscard]] std::vector<string_type> names() const;
+
+	struct variable_info {
+		string_type	name;
+		std::size_t	bytes;
+	};
+
+	/*! Session variables and the bytes each value holds, sorted by name. */
+	[[nodiscard]] std::vector<variable_info> list() const;
+
+	/*! Total bytes held by session variable values. */
+	[[nodiscard]] std::size_t bytes() const;
+
+	/*! Removes a session variable (a base variable of the same name shows through again). */
+	bool drop(string_type const& name);
+
+	/*! Applies new limits to the current variables.
+		@throw std::length_error under VariablePolicy::Reject if they do not fit; the old limits stay in force. */
+	void set_limits(VariableLimits limits);
+	[[nodiscard]] VariableLimits const& limits() const { return limits_m; }
+
+	/*! Re-checks the limits after values changed in place (e.g. by an evaluated assignment).
+		Evicts under VariablePolicy::EvictLeastRecentlyUsed; under Reject throws std::length_error. */
+	void enforce_limits();
+
+	/*! As enforce_limits(), but false where enforce_limits() would throw. */
+	[[nodiscard]] bool try_enforce_limits();
+
+	/*! Variables owned by this session (copied from the base when written, or created here). */
+	[[nodiscard]] dictionary_type const& overlay() const { return overlay_m; }
+	[[nodiscard]] base_type const& base() const { return base_m; }
+
+private:
+	[[nodiscard]] std::shared_ptr<Variable const> _find_in_base(string_type const& name) const;
+
+	/*! Adds 'created' to the overlay if the limits allow, evicting under LRU; overlay_m.end() if not. */
+	dictionary_type::iterator _create(string_type const& name, Variable::pointer_type const& created);
+
+	/*! Evicts least recently used variables, other than 'keep', until count and bytes fit; false if they cannot. */
+	bool _make_room(std::size_t count, std::size_t bytes, string_type const& keep);
+
+	/*! Moves the variable to the most recently used end. */
+	void _use(string_type const& name, usage& u);
+
+	/*! Records the current size of the variable's value in u and bytes_m. */
+	void _measure(usage& u, Variable const& variable);
+
+	/*! Re-measures the variables handed out since the last settle, and moves borrowed copies changed since
+		into the overlay. */
+	void _settle();
+
+	/*! Removes the variable and its accounting. */
+	void _forget(dictionary_type::iterator variable);
+};
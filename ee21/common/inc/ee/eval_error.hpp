@@ -0,0 +1,153 @@
+#pragma once
+/*!	\file	eval_error.hpp
+	\brief	EvalError and EvalExpected declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+The error type of the non-throwing evaluation path.
+
+An EvalError is a code and the offset in the expression where the
+problem was found; it holds no strings, so reporting an invalid
+expression allocates nothing.
+
+EvalExpected<T> is std::expected<T, EvalError> where the standard
+library provides it (C++23).  Under C++20 it is a small stand-in
+with the same members used by this project: has_value(), operator
+bool, value(), operator *, operator -> and error().  Failures are
+made with eval_failure() under either.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Added the EvaluationLimits codes.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+
+/*! What went wrong. */
+enum class EvalErrc : std::uint8_t {
+	bad_character = 1,				//!< a character the tokenizer does not recognize
+	unmatched_right_parenthesis,	//!< ')' without a '('
+	missing_right_parenthesis,		//!< '(' never closed
+	misplaced_separator,			//!< ',' outside a function's parentheses
+	unknown_token,					//!< a token the parser cannot place
+	insufficient_operands,			//!< an operation with too few operands
+	variable_limit,					//!< the session's variable limits were exceeded (VariablePolicy::Reject)
+	integer_limit,					//!< an integer would exceed EvaluationLimits::max_integer_bits
+	precision_limit,				//!< a real operand exceeds EvaluationLimits::max_real_digits
+	memory_limit,					//!< the operands would exceed EvaluationLimits::max_intermediate_bytes
+	length_limit,					//!< the postfix expression exceeds EvaluationLimits::max_postfix_length
+};
+
+
+
+/*! An error and where it was found. */
+struct EvalError {
+	static constexpr std::uint32_t no_offset = std::numeric_limits<std::uint32_t>::max();
+
+	EvalErrc		code = EvalErrc::bad_character;
+	std::uint32_t	offset = no_offset;		// character offset in the expression (the parser and RPN evaluator report token indexes)
+
+	bool operator == (EvalError const&) const = default;
+
+	/*! A fixed description of the code. */
+	[[nodiscard]] constexpr char const* message() const {
+		switch (code) {
+		case EvalErrc::bad_character:				return "Tokenizer::Bad character in expression.";
+		case EvalErrc::unmatched_right_parenthesis:	return "Right parenthesis, has no matching left parenthesis.";
+		case EvalErrc::missing_right_parenthesis:	return "Missing right-parenthesis.";
+		case EvalErrc::misplaced_separator:			return "Argument separator outside of a function call.";
+		case EvalErrc::unknown_token:				return "Unkown token.";
+		case EvalErrc::insufficient_operands:		return "Insufficient # operands of operation";
+		case EvalErrc::variable_limit:				return "Error: session variables exceed their limits";
+		case EvalErrc::integer_limit:				return "Error: integer exceeds the evaluation's bit limit";
+		case EvalErrc::precision_limit:				return "Error: real operand exceeds the evaluation's precision limit";
+		case EvalErrc::memory_limit:				return "Error: operands exceed the evaluation's memory limit";
+		case EvalErrc::length_limit:				return "Error: expression exceeds the evaluation's length limit";
+		}
+		return "Unknown error.";
+	}
+};
+
+
+
+#if defined(__cpp_lib_expected)
+
+template <typename T>
+using EvalExpected = std::expected<T, EvalError>;
+
+[[nodiscard]] inline std::unexpected<EvalError> eval_failure(EvalError error) { return std::unexpected<EvalError>(error); }
+[[nodiscard]] inline std::unexpected<EvalError> eval_failure(EvalErrc code, std::uint32_t offset = EvalError::no_offset) { return eval_failure(EvalError{ code, offset }); }
+
+#else
+
+/*! The failure half of an EvalExpected, as std::unexpected. */
+struct EvalFailure {
+	EvalError	error;
+};
+
+[[nodiscard]] inline EvalFailure eval_failure(EvalError error) { return EvalFailure{ error }; }
+[[nodiscard]] inline EvalFailure eval_failure(EvalErrc code, std::uint32_t offset = EvalError::no_offset) { return EvalFailure{ EvalError{ code, offset } }; }
+
+/*! The subset of std::expected<T, EvalError> this project uses. */
+template <typename T>
+class EvalExpected {
+	std::variant<T, EvalError>	state_m;
+
+public:
+	using value_type = T;
+	using error_type = EvalError;
+
+	EvalExpected() : state_m(std::in_place_index<0>) { }
+	EvalExpected(T value) : state_m(std::in_place_index<0>, std::move(value)) { }
+	EvalExpected(EvalFailure failure) : state_m(std::in_place_index<1>, failure.error) { }
+
+	[[nodiscard]] bool has_value() const noexcept { return state_m.index() == 0; }
+	[[nodiscard]] explicit operator bool() const noexcept { return has_value(); }
+
+	/*! @throw std::logic_error if there is no value. */
+	[[nodiscard]] T& value() & { _check(); return *std::get_if<0>(&state_m); }
+	[[nodiscard]] T const& value() const& { _check(); return *std::get_if<0>(&state_m); }
+	[[nodiscard]] T&& value() && { _check(); return std::move(*std::get_if<0>(&state_m)); }
+
+	[[nodiscard]] T& operator * () & noexcept { return *std::get_if<0>(&state_m); }
+	[[nodiscard]] T const& operator * () const& noexcept { return *std::get_if<0>(&state_m); }
+	[[nodiscard]] T&& operator * () && noexcept { return std::move(*std::get_if<0>(&state_m)); }
+	[[nodiscard]] T* operator -> () noexcept { return std::get_if<0>(&state_m); }
+	[[nodiscard]] T const* operator -> () const noexcept { return std::get_if<0>(&state_m); }
+
+	[[nodiscard]] EvalError const& error() const noexcept { return *std::get_if<1>(&state_m); }
+
+private:
+	void _check() const {
+		if (!has_value())
+			throw std::logic_error(error().message());
+	}
+};
+
+#endif
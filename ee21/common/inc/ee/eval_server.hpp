@@ -0,0 +1,172 @@
+#pragma once
+/*!	\file	eval_server.hpp
+	\brief	Evaluation server and client declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+A local evaluation server on a Unix domain socket (Linux only).
+
+Protocol: every message is a frame of a 4-byte little-endian length
+followed by that many bytes.  A request frame holds an expression.
+A response frame holds a status byte (0 = ok, 1 = error) followed by
+the result text or the error message.  Clients may pipeline: any
+number of requests can be in flight on a connection, and responses
+come back in request order.
+
+One epoll thread accepts, reads and writes.  Evaluation runs on a
+ConcurrentEvaluator whose session is the connection, so variables
+persist for the life of the connection and a connection's requests
+run one after another while different connections run in parallel.
+Workers hand finished responses back to the epoll thread through an
+eventfd.
+
+A client that sends faster than it reads is not read from while
+max_in_flight of its requests are unanswered or more than max_outbox
+bytes of its responses are waiting to be sent.  A
+client that half-closes its connection gets the replies to every
+request it sent before the server closes it.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Stop reading a connection while its unsent responses exceed max_outbox.
+	Answer the requests of a half-closed connection.
+	Stop reading a connection while max_in_flight of its requests are unanswered.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#if defined(__linux__)
+
+#include <ee/concurrent_evaluator.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+class EvalServer {
+public:
+	static constexpr std::uint32_t max_frame = 1 << 20;		// longer requests close the connection
+	static constexpr std::size_t max_outbox = 1 << 22;		// unsent response bytes before reading pauses
+	static constexpr std::size_t max_in_flight = 1024;		// unanswered requests before reading pauses
+
+private:
+	struct connection;
+
+	std::string										path_m;
+	int												listen_m = -1;
+	int												epoll_m = -1;
+	int												wake_m = -1;		// eventfd: responses ready, or stop
+	std::atomic<bool>								stopping_m{ false };
+	std::map<int, std::shared_ptr<connection>>		connections_m;		// epoll thread only
+	std::mutex										ready_mutex_m;
+	std::vector<std::shared_ptr<connection>>		ready_m;			// connections with responses to send
+	std::uint64_t									next_id_m = 0;
+	std::thread										thread_m;
+	std::unique_ptr<ConcurrentEvaluator>			evaluator_m;
+
+public:
+	/*! Listens on 'path' (an existing socket file is replaced) with 'threads' evaluation workers.
+		@throw std::runtime_error if the socket cannot be set up. */
+	explicit EvalServer(std::string path, std::size_t threads = 0, Environment::base_type base = nullptr);
+
+	/*! Stops and removes the socket file. */
+	~EvalServer();
+
+	EvalServer(EvalServer const&) = delete;
+	EvalServer& operator = (EvalServer const&) = delete;
+
+	/*! Runs the event loop on the calling thread until stop(). */
+	void run();
+
+	/*! Runs the event loop on a background thread. */
+	void start() { thread_m = std::thread([this] { run(); }); }
+
+	/*! Makes run() return; callable from any thread. */
+	void stop();
+
+	[[nodiscard]] std::string const& path() const { return path_m; }
+	[[nodiscard]] ConcurrentEvaluator::statistics stats() const { return evaluator_m->stats(); }
+
+private:
+	void _accept();
+	void _read(std::shared_ptr<connection> const& c);
+	void _flush(std::shared_ptr<connection> const& c);
+	std::size_t _frame(std::shared_ptr<connection> const& c, std::size_t in_flight);
+	void _close(std::shared_ptr<connection> const& c);
+	void _submit(std::shared_ptr<connection> const& c, std::string expr);
+	void _wake();
+};
+
+
+
+/*! A blocking client for EvalServer. */
+class EvalClient {
+	int				fd_m = -1;
+	std::string		buffer_m;		// received bytes not yet returned
+
+public:
+	struct reply {
+		bool			ok = false;
+		std::string		text;
+	};
+
+	/*! @throw std::runtime_error if the server cannot be reached. */
+	explicit EvalClient(std::string const& path);
+	~EvalClient();
+
+	EvalClient(EvalClient const&) = delete;
+	EvalClient& operator = (EvalClient const&) = delete;
+
+	/*! Sends a request without waiting for its reply. */
+	void send(std::string_view expr);
+
+	/*! Half-closes the connection: no more requests, but the replies to those sent still arrive. */
+	void finish();
+
+	/*! The reply to the oldest request not yet received. */
+	[[nodiscard]] reply receive();
+
+	[[nodiscard]] reply evaluate(std::string_view expr) { send(expr); return receive(); }
+};
+
+
+
+struct LoadReport {
+	std::size_t	requests = 0;
+	std::size_t	errors = 0;
+	double		seconds = 0;
+	double		p50_us = 0;		// request latency percentiles, microseconds
+	double		p99_us = 0;
+
+	[[nodiscard]] double per_second() const { return seconds > 0 ? requests / seconds : 0; }
+};
+
+/*! Load generator: 'connections' clients each send 'requests' copies of 'expr',
+	keeping up to 'pipeline' in flight, and the latencies of all of them are measured. */
+[[nodiscard]] LoadReport run_load(std::string const& path, std::string const& expr,
+	std::size_t connections, std::size_t requests, std::size_t pipeline);
+
+#endif // __linux__
@@ -0,0 +1,88 @@
+#pragma once
+/*!	\file	evaluation_limits.hpp
+	\brief	EvaluationLimits and EvaluationBudget declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Caps on what a single evaluation may build, so that expressions
+such as 9**9**9 or (10**100000)! fail quickly instead of exhausting
+memory.
+
+An EvaluationBudget is made for each evaluation.  Every operand the
+evaluator stacks is admitted through it: its bits, precision and
+bytes are checked and the bytes are charged.  For operations whose
+result size follows from their operands (power and factorial) the
+size is predicted and checked before the operation is performed.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/eval_error.hpp>
+#include <ee/integer.hpp>
+#include <ee/operation.hpp>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+
+
+/*! Per-evaluation caps.  The defaults stop runaway growth long before memory runs out. */
+struct EvaluationLimits {
+	std::size_t	max_integer_bits = std::size_t(1) << 26;		// 64 Mbit, about 20 million decimal digits
+	std::size_t	max_real_digits = std::numeric_limits<std::size_t>::max();	// significant digits of a real operand
+	std::size_t	max_intermediate_bytes = std::size_t(1) << 30;
+	std::size_t	max_postfix_length = std::size_t(1) << 20;
+};
+
+
+
+/*! The running account of one evaluation against its limits. */
+class EvaluationBudget {
+	EvaluationLimits	limits_m;
+	std::size_t			bytes_m = 0;
+
+public:
+	explicit EvaluationBudget(EvaluationLimits const& limits = EvaluationLimits()) : limits_m(limits) { }
+
+	/*! Checks an operand about to be stacked and charges its bytes; a Variable is checked by its value.
+		@return the limit it exceeds, if any. */
+	[[nodiscard]] std::optional<EvalErrc> admit(Token::pointer_type const& operand);
+
+	/*! Checks the predicted result of 'operation' applied to 'args' (in postfix order) and charges its bytes.
+		Only operations whose result size can be predicted are checked. */
+	[[nodiscard]] std::optional<EvalErrc> admit(Operation const& operation, std::span<Token::pointer_type const> args);
+
+	[[nodiscard]] std::size_t bytes() const { return bytes_m; }
+	[[nodiscard]] EvaluationLimits const& limits() const { return limits_m; }
+
+	/*! About how many bits base**exponent needs, or infinity if it does not fit a double. */
+	[[nodiscard]] static double power_bits(Integer::value_type const& base, Integer::value_type const& exponent);
+
+	/*! About how many bits n! needs. */
+	[[nodiscard]] static double factorial_bits(Integer::value_type const& n);
+
+	/*! Significant decimal digits an operand carries; 0 for exact types. */
+	[[nodiscard]] static std::size_t precision_digits(Operand::pointer_type const& operand);
+
+private:
+	[[nodiscard]] std::optional<EvalErrc> _charge(double bits);
+};
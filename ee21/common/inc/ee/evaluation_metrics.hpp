@@ -0,0 +1,141 @@
+#pragma once
+/*!	\file	evaluation_metrics.hpp
+	\brief	EvaluationSample, Histogram and EvaluationMetrics declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Runtime instrumentation of ExpressionEvaluator.
+
+While a session's metrics are enabled (set_metrics(true)) each
+evaluate() and try_evaluate() fills an EvaluationSample: the time
+spent tokenizing, parsing and evaluating, the token counts, the
+deepest operand stack, the allocations made and the size of the
+result.  Samples are folded into one Histogram per measure.  With
+metrics disabled the evaluator makes no clock calls and records
+nothing.
+
+Allocations are counted through a process-wide counter installed
+with EvaluationMetrics::set_allocation_counter(); without one they
+read as zero.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/operand.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+
+
+/*! The measurements of one evaluation. */
+struct EvaluationSample {
+	std::uint64_t	tokenize_ns = 0;
+	std::uint64_t	parse_ns = 0;
+	std::uint64_t	evaluate_ns = 0;		// in the RPN evaluator
+	std::uint32_t	infix_tokens = 0;		// 0 when a cached plan was used
+	std::uint32_t	postfix_tokens = 0;
+	std::uint32_t	max_stack_depth = 0;
+	std::uint64_t	allocations = 0;		// of the whole evaluation
+	std::uint64_t	result_digits = 0;		// decimal digits of the result (significant digits for reals)
+	bool			cached = false;			// tokenizing and parsing were skipped
+	bool			ok = true;				// false if the evaluation failed
+};
+
+
+
+/*! Counts of values in power-of-two buckets: bucket 0 holds 0, bucket b holds [2^(b-1), 2^b). */
+class Histogram {
+public:
+	static constexpr std::size_t bucket_count = std::numeric_limits<std::uint64_t>::digits + 1;
+
+	void record(std::uint64_t value);
+	void merge(Histogram const& other);
+	void reset() { *this = Histogram(); }
+
+	[[nodiscard]] std::uint64_t count() const { return count_m; }
+	[[nodiscard]] std::uint64_t sum() const { return sum_m; }
+	[[nodiscard]] std::uint64_t min() const { return count_m ? min_m : 0; }
+	[[nodiscard]] std::uint64_t max() const { return max_m; }
+	[[nodiscard]] double mean() const { return count_m ? double(sum_m) / double(count_m) : 0; }
+	[[nodiscard]] std::uint64_t bucket(std::size_t b) const { return buckets_m[b]; }
+
+	/*! An upper bound of the q'th quantile (0 <= q <= 1): the top of the bucket it falls in, capped at max(). */
+	[[nodiscard]] std::uint64_t percentile(double q) const;
+
+private:
+	std::array<std::uint64_t, bucket_count>	buckets_m{};
+	std::uint64_t	count_m = 0;
+	std::uint64_t	sum_m = 0;
+	std::uint64_t	min_m = std::numeric_limits<std::uint64_t>::max();
+	std::uint64_t	max_m = 0;
+};
+
+
+
+/*! A session's aggregated EvaluationSamples. */
+class EvaluationMetrics {
+public:
+	/*! The measures kept as histograms. */
+	enum class Measure : std::uint8_t {
+		tokenize_ns, parse_ns, evaluate_ns, total_ns,
+		infix_tokens, postfix_tokens, max_stack_depth,
+		allocations, result_digits,
+	};
+	static constexpr std::size_t measure_count = static_cast<std::size_t>(Measure::result_digits) + 1;
+
+	/*! Reads the calling thread's running allocation count. */
+	using allocation_counter_type = std::uint64_t(*)() noexcept;
+
+	void record(EvaluationSample const& sample);
+	void merge(EvaluationMetrics const& other);
+	void reset() { *this = EvaluationMetrics(); }
+
+	[[nodiscard]] Histogram const& histogram(Measure measure) const { return histograms_m[static_cast<std::size_t>(measure)]; }
+	[[nodiscard]] std::uint64_t evaluations() const { return evaluations_m; }
+	[[nodiscard]] std::uint64_t failures() const { return failures_m; }
+	[[nodiscard]] std::uint64_t cached() const { return cached_m; }
+	[[nodiscard]] EvaluationSample const& last() const { return last_m; }
+
+	/*! The counts, then one line per measure: mean, min, p50, p90, p99 and max. */
+	void report(std::ostream& out) const;
+
+	[[nodiscard]] static char const* name(Measure measure);
+
+	/*! Installs the process-wide allocation counter; nullptr removes it. */
+	static void set_allocation_counter(allocation_counter_type counter);
+	[[nodiscard]] static allocation_counter_type allocation_counter();
+
+	/*! The installed counter's reading, or 0 without one. */
+	[[nodiscard]] static std::uint64_t allocations_now();
+
+	/*! The decimal size of a result: digits of an Integer, significant digits of a real, 1 for a Boolean. */
+	[[nodiscard]] static std::uint64_t result_digits(Token::pointer_type const& result);
+
+private:
+	std::array<Histogram, measure_count>	histograms_m;
+	std::uint64_t		evaluations_m = 0;
+	std::uint64_t		failures_m = 0;
+	std::uint64_t		cached_m = 0;
+	EvaluationSample	last_m;
+};
@@ -0,0 +1,165 @@
+#pragma once
+/*!	\file	expression_cache.hpp
+	\brief	CompiledExpression and ExpressionCache declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+A cache from expression text to its parsed postfix form, so that
+repeated expressions skip the tokenizer and the parser.
+
+A compiled expression holds no session state: its variables are
+kept as names and bound to a session's own variables on each use,
+so one cache serves every session and every thread.
+
+A plan may also leave its numeric literals as slots.  It is then
+stored under the parameterized text (see Tokenizer::parameterize),
+shared by every expression that differs only in its constants, and
+the literals of each call are bound with the variables.
+
+The cache is split into shards by a hash of the text.  Each shard
+has its own lock, least-recently-used list and share of the byte
+capacity, so threads only contend when they touch the same shard.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Plans with literal slots.
+	Added try_bind().
+	Variable slots are named from the tokenizer's VariableNames rather than found in the session.
+	Plans keep the source map of their postfix tokens.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/environment.hpp>
+#include <ee/real.hpp>
+#include <ee/tokenizer.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+/*! A parsed expression with its variables, and optionally its literals, left as slots. */
+class CompiledExpression {
+public:
+	using string_type = Token::string_type;
+
+private:
+	TokenList											postfix_m;		// nullptr where a variable goes
+	std::vector<std::pair<std::size_t, string_type>>	slots_m;		// postfix index, variable name
+	std::vector<std::pair<std::size_t, std::size_t>>	literals_m;		// postfix index, literal number
+	std::vector<std::uint32_t>							origins_m;		// infix index of each postfix token
+	std::vector<std::uint32_t>							offsets_m;		// character offset of each infix token; empty for a parameterized plan
+
+public:
+	CompiledExpression() = default;
+
+	/*! Takes postfix tokens and replaces their variables by the names 'names' recorded while tokenizing them.
+		@throw std::logic_error if a variable is not in 'names'. */
+	CompiledExpression(TokenList postfix, VariableNames const& names);
+
+	/*! Also replaces the literals of 'infix' named by 'parameters' (the same expression) by literal slots.
+		@throw std::logic_error if 'parameters' does not describe 'infix'. */
+	CompiledExpression(TokenList postfix, VariableNames const& names, TokenList const& infix, ParameterizedExpression const& parameters);
+
+	/*! The postfix tokens with the session's own variables in the slots (created if they are new)
+		and the literals made from 'literals' with 'backend'.
+		@throw std::invalid_argument if the plan has literal slots and 'literals' is the wrong size. */
+	[[nodiscard]] TokenList bind(Environment& environment, std::span<std::string_view const> literals = {}, RealBackend backend = RealBackend::Multiprecision) const;
+
+	/*! As bind(), but a new variable that the session's limits reject is an EvalError rather than std::length_error. */
+	[[nodiscard]] EvalExpected<TokenList> try_bind(Environment& environment, std::span<std::string_view const> literals = {}, RealBackend backend = RealBackend::Multiprecision) const;
+
+	/*! Records where the postfix tokens came from: 'origins' as Parser::try_parse() reports them
+		and 'offsets' as Tokenizer::try_tokenize() does.  A parameterized plan serves texts whose
+		tokens sit at different offsets, so it keeps only the origins. */
+	void set_source_map(std::vector<std::uint32_t> origins, std::vector<std::uint32_t> offsets = {});
+
+	[[nodiscard]] TokenList const& postfix() const { return postfix_m; }
+	[[nodiscard]] std::vector<std::uint32_t> const& origins() const { return origins_m; }
+	[[nodiscard]] std::vector<std::uint32_t> const& offsets() const { return offsets_m; }
+	[[nodiscard]] std::size_t variable_count() const { return slots_m.size(); }
+	[[nodiscard]] std::size_t literal_count() const { return literals_m.size(); }
+
+	/*! Approximate memory held, for the cache's byte budget. */
+	[[nodiscard]] std::size_t bytes() const;
+};
+
+
+
+class ExpressionCache {
+public:
+	using plan_type = std::shared_ptr<CompiledExpression const>;
+
+	static constexpr std::size_t default_capacity = 64 << 20;
+	static constexpr std::size_t default_shards = 16;
+
+	struct statistics {
+		std::uint64_t	hits = 0;
+		std::uint64_t	misses = 0;
+		std::uint64_t	insertions = 0;
+		std::uint64_t	evictions = 0;
+		std::size_t		entries = 0;
+		std::size_t		bytes = 0;
+
+		[[nodiscard]] double hit_rate() const { return hits + misses ? double(hits) / double(hits + misses) : 0; }
+	};
+
+private:
+	struct shard;
+
+	std::vector<std::unique_ptr<shard>>	shards_m;
+
+public:
+	/*! A cache of at most 'capacity' bytes, split evenly over 'shards' independently locked shards. */
+	explicit ExpressionCache(std::size_t capacity = default_capacity, std::size_t shards = default_shards);
+	~ExpressionCache();
+
+	ExpressionCache(ExpressionCache const&) = delete;
+	ExpressionCache& operator = (ExpressionCache const&) = delete;
+
+	/*! The plan for 'text' compiled with 'backend', or nullptr; a hit becomes the most recently used. */
+	[[nodiscard]] plan_type find(std::string_view text, RealBackend backend);
+
+	/*! Stores a plan, evicting the least recently used entries of its shard to make room.
+		If another thread stored one first, that one is kept and returned.  A plan larger
+		than a whole shard is returned without being stored. */
+	plan_type insert(std::string_view text, RealBackend backend, CompiledExpression plan);
+
+	/*! The cached plan, or the result of compile() after storing it. */
+	template <typename Compile>
+	[[nodiscard]] plan_type get(std::string_view text, RealBackend backend, Compile&& compile) {
+		if (auto plan = find(text, backend))
+			return plan;
+		return insert(text, backend, compile());
+	}
+
+	void clear();
+
+	[[nodiscard]] statistics stats() const;
+	[[nodiscard]] std::size_t capacity() const;
+
+private:
+	/*! Picks the shard from the high bits; the low bits choose buckets inside the shard. */
+	[[nodiscard]] shard& _shard_for(std::size_t hash) const { return *shards_m[(hash >> (sizeof(std::size_t) * 4)) % shards_m.size()]; }
+};
@@ -9,6 +9,23 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added set_real_backend().
+	Added the bounded result history.
+	Added bind(), set() and get() for host access to variables.
+	Added environment() and set_environment().
+	Added variable limits, variables() and drop().
+	Added evaluate_many().
+	Added evaluate_async().
+	Added set_expression_cache().
+	Added set_literal_parameters().
+	Added try_evaluate().
+	Added set_evaluation_limits().
+	Added set_metrics() and metrics().
+	Added set_operation_profiler().
+	Added last_allocations().
+	evaluate_async() takes its completion executor by shared_ptr.
+
 Version 2021.11.01
 	C++ 20 validated
 
@@ -28,10 +45,27 @@ stipulated in the agreement / contract under which
 the program(s) have been supplied.
 ============================================================= */
 
+#include <ee/allocation_tracking.hpp>
+#include <ee/async_evaluation.hpp>
+#include <ee/evaluation_metrics.hpp>
+#include <ee/expression_cache.hpp>
 #include <ee/tokenizer.hpp>
 #include <ee/parser.hpp>
 #include <ee/RPNEvaluator.hpp>
 #include <ee/function.hpp>
+#include <ee/result_history.hpp>
+#include <ee/boolean.hpp>
+#include <ee/integer.hpp>
+#include <ee/real.hpp>
+#include <ee/variable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 
 class ExpressionEvaluator {
@@ -42,6 +76,141 @@ private:
 	Tokenizer		tokenizer_m;
 	Parser			parser_m;
 	RPNEvaluator	rpn_m;
+	ResultHistory	history_m;
+	std::shared_ptr<ExpressionCache>	cache_m;
+	bool							literal_parameters_m = true;
+	ParameterizedExpression			parameterized_m;		// reused by each cached evaluation
+	std::vector<std::uint32_t>		offsets_m;				// of each infix token, from the last _try_compile()
+	std::vector<std::uint32_t>		origins_m;				// infix index of each postfix token, likewise
+	VariableNames					variable_names_m;		// variables met by the last compile, for a cached plan
+	std::unique_ptr<EvaluationMetrics>	metrics_m;			// nullptr while metrics are disabled
+	EvaluationSample*				sample_m = nullptr;		// of the evaluation in progress, if measured
+	std::shared_ptr<OperationProfiler>	profiler_m;
+	std::vector<std::uint32_t>		profile_offsets_m;		// character offset of each postfix token, for the profiler's spans
+	AllocationProfile				last_allocations_m;
 public:
+	/*! One item of a batch: the result, or the error message if evaluating it threw. */
+	struct BatchResult {
+		result_type	value;
+		std::string	error;
+		[[nodiscard]] bool ok() const { return error.empty(); }
+	};
+
 	[[nodiscard]] result_type evaluate(expression_type const& expr);
+
+	/*! As evaluate(), but an invalid expression is returned as an EvalError, with the offset of the character
+		where it was found, and the tokenizer, parser and RPN evaluator run without throwing. */
+	[[nodiscard]] EvalExpected<result_type> try_evaluate(expression_type const& expr);
+
+	/*! Evaluates independent expressions in parallel on ThreadPool::shared(); results are in input order.
+		Every item sees this session's variables as they are at the call and none of them changes the session;
+		results are not recorded in the history.  An item that throws fails alone. */
+	[[nodiscard]] std::vector<BatchResult> evaluate_many(std::span<std::string_view const> exprs) const;
+
+	/*! Evaluates on 'executor' and returns at once; like evaluate_many() the expression sees a snapshot of
+		this session and does not change it, so the session may be used (or destroyed) meanwhile.
+		Callbacks and awaiting coroutines are resumed on 'completion' if given; it is held weakly, and
+		what would have run on it after it is destroyed is dropped. */
+	[[nodiscard]] AsyncEvaluation evaluate_async(expression_type expr, Executor& executor = ThreadPool::shared(), std::shared_ptr<Executor> const& completion = nullptr) const;
+
+	/*! Shares a cache of parsed expressions, keyed by text, with other sessions; nullptr stops caching. */
+	void set_expression_cache(std::shared_ptr<ExpressionCache> cache) { cache_m = std::move(cache); }
+	[[nodiscard]] std::shared_ptr<ExpressionCache> const& expression_cache() const { return cache_m; }
+
+	/*! With a cache, expressions that differ only in numeric literals, spacing or keyword case
+		share one plan and the literals are re-made on each call (the default); off, plans are keyed by the exact text. */
+	void set_literal_parameters(bool on) { literal_parameters_m = on; }
+	[[nodiscard]] bool literal_parameters() const { return literal_parameters_m; }
+
+	/*! Caps on the size of each evaluation's operands; an evaluation that would exceed one fails
+		before the operation is attempted (see EvaluationBudget). */
+	void set_evaluation_limits(EvaluationLimits const& limits) { rpn_m.set_limits(limits); }
+	[[nodiscard]] EvaluationLimits const& evaluation_limits() const { return rpn_m.limits(); }
+
+	/*! Turns the per-evaluation measurements on or off; turning them off discards what was gathered.
+		Only evaluate() and try_evaluate() are measured, not batches or asynchronous evaluations. */
+	void set_metrics(bool on);
+	/*! The measurements gathered so far; nullptr while metrics are disabled. */
+	[[nodiscard]] EvaluationMetrics const* metrics() const { return metrics_m.get(); }
+	void reset_metrics() { if (metrics_m) metrics_m->reset(); }
+
+	/*! Hands 'profiler' to the RPN evaluator, to time the operations it applies (none yet); nullptr stops profiling.
+		With the profiler's spans on, operations are located in expressions compiled by the call (not cached plans). */
+	void set_operation_profiler(std::shared_ptr<OperationProfiler> profiler);
+	[[nodiscard]] std::shared_ptr<OperationProfiler> const& operation_profiler() const { return profiler_m; }
+
+	/*! The allocations of the last evaluate() or try_evaluate(), by stage; all zero unless AllocationTracker::installed(). */
+	[[nodiscard]] AllocationProfile const& last_allocations() const { return last_allocations_m; }
+
+	/*! Selects the numeric type used for real values in this session. */
+	void set_real_backend(RealBackend backend) { tokenizer_m.set_real_backend(backend); }
+	[[nodiscard]] RealBackend real_backend() const { return tokenizer_m.real_backend(); }
+
+	/*! The value of Result(n): the n'th result of this session, counting from 1. */
+	[[nodiscard]] result_type result(ResultHistory::size_type n) const { return history_m.at(n); }
+
+	/*! Results older than the last 'capacity' are forgotten. */
+	void set_history_capacity(ResultHistory::size_type capacity) { history_m.set_capacity(capacity); }
+	[[nodiscard]] ResultHistory const& history() const { return history_m; }
+	[[nodiscard]] ResultHistory& history() { return history_m; }
+
+	/*! Binds a variable to host storage or a getter; expressions then read the host's current value. */
+	void bind(expression_type const& name, double const* location) { tokenizer_m.variable(name)->bind(location); }
+	void bind(expression_type const& name, std::int64_t const* location) { tokenizer_m.variable(name)->bind(location); }
+	void bind(expression_type const& name, bool const* location) { tokenizer_m.variable(name)->bind(location); }
+	void bind(expression_type const& name, Variable::getter_type getter) { tokenizer_m.variable(name)->bind(std::move(getter)); }
+
+	/*! Assigns a variable without tokenizing: bool gives Boolean, integral types Integer, floating types Real. */
+	template <typename T>
+	void set(expression_type const& name, T const& value) {
+		if constexpr (boost::multiprecision::is_number_expression<T>::value) {
+			set(name, typename T::result_type(value));		// boost expression template, e.g. -x
+			return;
+		}
+		Operand::pointer_type operand;
+		if constexpr (std::is_convertible_v<T, Operand::pointer_type>)
+			operand = value;
+		else if constexpr (std::is_same_v<T, bool>)
+			operand = make_operand<Boolean>(value);
+		else if constexpr (std::is_integral_v<T> || std::is_same_v<T, Integer::value_type>)
+			operand = make_operand<Integer>(Integer::value_type(value));
+		else
+			operand = make_operand<Real>(Real::value_type(value));
+		tokenizer_m.assign(name, operand);
+	}
+
+	/*! Current value of a variable; nullptr if it is unknown or unassigned. */
+	[[nodiscard]] result_type get(expression_type const& name) const {
+		return tokenizer_m.environment().value(name);
+	}
+
+	/*! The session's variables.  Start sessions from a shared base with set_environment(Environment(base)). */
+	[[nodiscard]] Environment& environment() { return tokenizer_m.environment(); }
+	[[nodiscard]] Environment const& environment() const { return tokenizer_m.environment(); }
+	void set_environment(Environment environment) { tokenizer_m.set_environment(std::move(environment)); }
+
+	/*! Caps on the session's variables; see Environment::set_limits(). */
+	void set_variable_limits(VariableLimits limits) { environment().set_limits(limits); }
+	[[nodiscard]] std::vector<Environment::variable_info> variables() const { return environment().list(); }
+	bool drop(expression_type const& name) { return environment().drop(name); }
+
+private:
+	[[nodiscard]] result_type _evaluate(expression_type const& expr);
+	[[nodiscard]] EvalExpected<result_type> _try_evaluate(expression_type const& expr);
+
+	/*! Completes sample_m with the allocations since 'allocations' and the result's size, and records it. */
+	void _record_sample(std::uint64_t allocations, result_type const& result);
+
+	/*! Tokenizes and parses against this session without throwing; the tokens are also left in 'infix'
+		if given.  Records offsets_m and origins_m for _source_offset(). */
+	[[nodiscard]] EvalExpected<TokenList> _try_compile(expression_type const& expr, TokenList* infix = nullptr);
+
+	/*! Has the tokenizer record the variables of the next compile in variable_names_m while a cache is attached. */
+	void _name_variables();
+
+	/*! Hands the profiler the character offsets of a postfix expression of 'size' tokens, if 'origins' maps all of them. */
+	void _profile_offsets(std::span<std::uint32_t const> origins, std::span<std::uint32_t const> offsets, std::size_t size);
+
+	/*! The character offset of a postfix token, given the infix index of each postfix token and the offset of each infix token. */
+	[[nodiscard]] static std::uint32_t _source_offset(std::span<std::uint32_t const> origins, std::span<std::uint32_t const> offsets, std::uint32_t postfix_index);
 };
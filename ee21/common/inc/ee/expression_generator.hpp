@@ -0,0 +1,108 @@
+#pragma once
+/*!	\file	expression_generator.hpp
+	\brief	GeneratorOptions and ExpressionGenerator declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Random well-formed expressions over every operator of operator.hpp
+and every function of function.hpp, for benchmarks and for the
+differential tests of DifferentialHarness.
+
+Expressions are built from typed trees: an integer, real or boolean
+node picks an operation yielding that type (a comparison yields a
+boolean, floor() of a real an integer, and so on) and fills its
+operands the same way.  GeneratorOptions control the number of
+operations, the nesting depth, the mix of result types and how many
+variables (v0, v1, ...) appear.  Every compound operand is
+parenthesized, so the text parses as the tree it came from;
+keywords appear in all three accepted cases.
+
+The same seed gives the same expressions with every compiler: the
+generator draws from std::mt19937_64 directly rather than through
+the implementation-defined standard distributions.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/*! What ExpressionGenerator produces. */
+struct GeneratorOptions {
+	std::size_t	min_operations = 1;			// operators and function calls per expression
+	std::size_t	max_operations = 16;
+	std::size_t	max_depth = 8;				// deeper subtrees are cut to a single operand
+	std::size_t	variables = 0;				// v0 .. v(n-1) appear among the integer operands
+	double		integer_weight = 1;			// relative chance of each result type, at the top and inside
+	double		real_weight = 1;
+	double		boolean_weight = 1;
+	double		decimal_share = 0;			// of real literals written as decimals (2.5m)
+	bool		results = false;			// also emit result(1)
+};
+
+
+
+class ExpressionGenerator {
+public:
+	/*! The type a subtree evaluates to. */
+	enum class Type : std::uint8_t { integer, real, boolean };
+
+	explicit ExpressionGenerator(GeneratorOptions const& options = GeneratorOptions(), std::uint64_t seed = 0x5eed);
+
+	/*! The next expression. */
+	[[nodiscard]] std::string next();
+
+	/*! The next expression, of the given result type. */
+	[[nodiscard]] std::string next(Type type);
+
+	/*! The next 'count' expressions. */
+	[[nodiscard]] std::vector<std::string> corpus(std::size_t count);
+
+	/*! The name of variable n: "v<n>". */
+	[[nodiscard]] static std::string variable(std::size_t n) { return "v" + std::to_string(n); }
+
+	[[nodiscard]] GeneratorOptions const& options() const { return options_m; }
+
+private:
+	GeneratorOptions	options_m;
+	std::mt19937_64		random_m;
+	std::string			text_m;
+
+	[[nodiscard]] std::uint64_t _below(std::uint64_t n) { return random_m() % n; }
+	[[nodiscard]] bool _chance(double p) { return double(random_m() >> 11) * 0x1.0p-53 < p; }
+	[[nodiscard]] Type _type();
+
+	/*! Appends a subtree of 'type' with exactly 'operations' operations (fewer if cut by depth). */
+	void _tree(Type type, std::size_t operations, std::size_t depth);
+	void _operand(Type type);
+	void _keyword(char const* lower);
+
+	/*! Appends a subtree as an operand of an operator: parenthesized if it is compound. */
+	void _inner(Type type, std::size_t operations, std::size_t depth);
+
+	/*! Splits 'operations' among 'parts' subtrees. */
+	[[nodiscard]] std::vector<std::size_t> _split(std::size_t operations, std::size_t parts);
+};
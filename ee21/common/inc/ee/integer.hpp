@@ -12,6 +12,9 @@ Declarations of the Integer class derived from Operand.
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added isqrt() and the exact integer_abs/sqrt/lb/log/ln kernels.
+
 Version 2021.10.02
 	C++ 20 validated
 
@@ -68,4 +71,18 @@ public:
 
 	[[nodiscard]]	value_type	value() const { return value_; }
 	[[nodiscard]]	string_type	str() const override;
-};
\ No newline at end of file
+};
+
+
+
+/*! Integer square root, floor(sqrt(n)), by Newton's method. */
+[[nodiscard]] Integer::value_type isqrt(Integer::value_type const& n);
+
+/*! Integer-argument function kernels.
+	Each returns an Integer when the result is exact and a Real only when the result is irrational.
+	Arguments outside a kernel's domain throw std::domain_error, as the Decimal and lazy real kernels do. */
+[[nodiscard]] Operand::pointer_type integer_abs(Integer::value_type const& n);
+[[nodiscard]] Operand::pointer_type integer_sqrt(Integer::value_type const& n);
+[[nodiscard]] Operand::pointer_type integer_lb(Integer::value_type const& n);
+[[nodiscard]] Operand::pointer_type integer_log(Integer::value_type const& n);
+[[nodiscard]] Operand::pointer_type integer_ln(Integer::value_type const& n);
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+/*!	\file	lazy_real.hpp
+	\brief	LazyReal class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declarations of the lazy_real value type and the LazyReal class
+derived from Operand.
+
+A lazy_real keeps the expression that produced it as a tree and
+only computes digits when a consumer (to_string, comparison, floor,
+ceil) asks for them.  Each node caches the most precise value it
+has computed, so asking again for the same or fewer digits is free.
+
+	class lazy_real
+	class LazyReal
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Added bytes().
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/operand.hpp>
+#include <ee/integer.hpp>
+#include <ee/real.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+
+/*! Real number evaluated on demand to the precision requested by its consumer.
+	Precision is capped at that of Real (1000 digits).
+	*/
+class lazy_real {
+public:
+	using approximation_type = Real::value_type;
+	struct node;
+
+	/*! Fractional digits shown by LazyReal::str(). */
+	static constexpr unsigned default_precision = 50;
+
+private:
+	std::shared_ptr<node const>	node_m;
+	explicit lazy_real(std::shared_ptr<node const> n) : node_m(std::move(n)) { }
+
+public:
+	lazy_real();
+	lazy_real(Integer::value_type const& value);
+	explicit lazy_real(std::string const& decimal);
+	[[nodiscard]] static lazy_real pi();
+	[[nodiscard]] static lazy_real e();
+
+	/*! Approximation with at least 'digits' correct significant digits (best effort above 1000). */
+	[[nodiscard]] approximation_type	approximate(unsigned digits) const;
+
+	/*! Fixed-point representation with 'precision' digits after the decimal point. */
+	[[nodiscard]] std::string			to_string(unsigned precision = default_precision) const;
+
+	/*! Three-way comparison; values equal to 1000 digits compare equal. */
+	[[nodiscard]] int					compare(lazy_real const& rhs) const;
+
+	[[nodiscard]] Integer::value_type	floor() const;
+	[[nodiscard]] Integer::value_type	ceil() const;
+
+	/*! Most significant digits computed so far for this value. */
+	[[nodiscard]] unsigned				cached_digits() const;
+
+	/*! Bytes held by the pending expression and its cached approximations; a shared subtree counts once. */
+	[[nodiscard]] std::size_t			bytes() const;
+
+	friend lazy_real operator - (lazy_real const& a);
+	friend lazy_real operator + (lazy_real const& a, lazy_real const& b);
+	friend lazy_real operator - (lazy_real const& a, lazy_real const& b);
+	friend lazy_real operator * (lazy_real const& a, lazy_real const& b);
+	friend lazy_real operator / (lazy_real const& a, lazy_real const& b);
+	friend lazy_real abs(lazy_real const& a);
+	friend lazy_real sqrt(lazy_real const& a);
+	friend lazy_real exp(lazy_real const& a);
+	friend lazy_real log(lazy_real const& a);
+	friend lazy_real sin(lazy_real const& a);
+	friend lazy_real cos(lazy_real const& a);
+	friend lazy_real tan(lazy_real const& a);
+	friend lazy_real asin(lazy_real const& a);
+	friend lazy_real acos(lazy_real const& a);
+	friend lazy_real atan(lazy_real const& a);
+	friend lazy_real pow(lazy_real const& a, lazy_real const& b);
+
+	[[nodiscard]] friend bool operator == (lazy_real const& a, lazy_real const& b) { return a.compare(b) == 0; }
+	[[nodiscard]] friend bool operator != (lazy_real const& a, lazy_real const& b) { return a.compare(b) != 0; }
+	[[nodiscard]] friend bool operator <  (lazy_real const& a, lazy_real const& b) { return a.compare(b) < 0; }
+	[[nodiscard]] friend bool operator >  (lazy_real const& a, lazy_real const& b) { return a.compare(b) > 0; }
+	[[nodiscard]] friend bool operator <= (lazy_real const& a, lazy_real const& b) { return a.compare(b) <= 0; }
+	[[nodiscard]] friend bool operator >= (lazy_real const& a, lazy_real const& b) { return a.compare(b) >= 0; }
+};
+
+[[nodiscard]] lazy_real log2(lazy_real const& a);
+[[nodiscard]] lazy_real log10(lazy_real const& a);
+[[nodiscard]] lazy_real atan2(lazy_real const& y, lazy_real const& x);
+
+
+
+/*! Lazily evaluated real number token. */
+class LazyReal : public Operand {
+public:
+	DEF_POINTER_TYPE(LazyReal)
+	using value_type = lazy_real;
+private:
+	value_type	value_;
+public:
+	LazyReal(value_type value = value_type()) : value_(value) { }
+	[[nodiscard]] value_type	value() const { return value_; }
+	[[nodiscard]] string_type	str() const override;
+};
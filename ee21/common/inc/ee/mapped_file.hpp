@@ -0,0 +1,61 @@
+#pragma once
+/*!	\file	mapped_file.hpp
+	\brief	MappedFile class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declaration of the MappedFile class: a read-only memory mapping of
+a whole file (MapViewOfFile on Windows, mmap elsewhere).
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+class MappedFile {
+	char const*	data_m = nullptr;
+	std::size_t	size_m = 0;
+#if defined(_WIN32)
+	void*		file_m = nullptr;
+	void*		mapping_m = nullptr;
+#endif
+
+public:
+	/*! Maps the file.
+		@throw std::runtime_error if it cannot be opened or mapped. */
+	explicit MappedFile(std::string const& path);
+	~MappedFile();
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator = (MappedFile const&) = delete;
+
+	/*! The contents; nullptr for an empty file. */
+	[[nodiscard]] char const*		data() const { return data_m; }
+	[[nodiscard]] std::size_t		size() const { return size_m; }
+	[[nodiscard]] std::string_view	view() const { return { data_m, size_m }; }
+
+private:
+	void _release();
+};
@@ -0,0 +1,357 @@
+#pragma once
+/*!	\file	multi_double.hpp
+	\brief	Double-double and quad-double floating-point types.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declarations of the multi_double<N> floating-point type.  A value
+is held as the unevaluated sum of N non-overlapping doubles and
+all arithmetic is built from error-free transformations, giving
+roughly 16*N significant digits at hardware double speed.
+
+	two_sum()
+	fast_two_sum()
+	two_prod()
+	class multi_double<N>
+	dd_real
+	qd_real
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	The long long constructor is exact across the whole range.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+
+
+
+/*! Error-free sum: returns fl(a+b) and stores the rounding error in 'err'. */
+[[nodiscard]] inline double two_sum(double a, double b, double& err) {
+	double s = a + b;
+	double bb = s - a;
+	err = (a - (s - bb)) + (b - bb);
+	return s;
+}
+
+
+
+/*! Error-free sum for |a| >= |b|. */
+[[nodiscard]] inline double fast_two_sum(double a, double b, double& err) {
+	double s = a + b;
+	err = b - (s - a);
+	return s;
+}
+
+
+
+/*! Error-free product: returns fl(a*b) and stores the rounding error in 'err'. */
+[[nodiscard]] inline double two_prod(double a, double b, double& err) {
+	double p = a * b;
+	err = std::fma(a, b, -p);
+	return p;
+}
+
+
+
+/*! Floating-point number represented as the sum of N non-overlapping doubles.
+	Component 0 holds the leading (largest) part and is always the value rounded to double.
+	*/
+template <unsigned N>
+class multi_double {
+	static_assert(N >= 2, "multi_double requires at least two components");
+public:
+	using limb_array = std::array<double, N>;
+
+	/*! Number of decimal digits reliably represented (matches the QD library). */
+	static constexpr int digits10 = 16 * N - N / 2;
+
+private:
+	/*! Scratch expansion large enough for any intermediate of a single operation. */
+	static constexpr unsigned scratch_size = 4 * N + 4;
+	using scratch_type = std::array<double, scratch_size>;
+
+	limb_array	x_;
+
+	// Shewchuk expansion arithmetic.  Expansions are stored in increasing order of magnitude.
+	static unsigned _grow(unsigned elen, double* e, double b) {
+		double q = b, hh;
+		unsigned hlen = 0;
+		for (unsigned i = 0; i < elen; ++i) {
+			q = two_sum(q, e[i], hh);
+			if (hh != 0.0)
+				e[hlen++] = hh;
+		}
+		if (q != 0.0 || hlen == 0)
+			e[hlen++] = q;
+		return hlen;
+	}
+
+	// Starts from q = 0 rather than e[0] * b, which is the same sum but reads 'e' only below 'elen'.
+	static unsigned _scale(unsigned elen, double const* e, double b, double* h) {
+		double hh, product0, product1, sum;
+		unsigned hlen = 0;
+		double q = 0.0;
+		for (unsigned i = 0; i < elen; ++i) {
+			product1 = two_prod(e[i], b, product0);
+			sum = two_sum(q, product0, hh);
+			if (hh != 0.0)
+				h[hlen++] = hh;
+			q = fast_two_sum(product1, sum, hh);
+			if (hh != 0.0)
+				h[hlen++] = hh;
+		}
+		if (q != 0.0 || hlen == 0)
+			h[hlen++] = q;
+		return hlen;
+	}
+
+	static unsigned _compress(unsigned elen, double* e) {
+		if (elen == 0)
+			return 0;
+		int bottom = int(elen) - 1;
+		double q = e[bottom], qnew, err;
+		for (int i = int(elen) - 2; i >= 0; --i) {
+			qnew = fast_two_sum(q, e[i], err);
+			if (err != 0.0) {
+				e[bottom--] = qnew;
+				q = err;
+			}
+			else
+				q = qnew;
+		}
+		unsigned top = 0;
+		for (unsigned i = unsigned(bottom) + 1; i < elen; ++i) {
+			qnew = fast_two_sum(e[i], q, err);
+			if (err != 0.0)
+				e[top++] = err;
+			q = qnew;
+		}
+		e[top++] = q;
+		return top;
+	}
+
+	/*! Appends the non-zero components of 'x' to the expansion 'e' (increasing order). */
+	static unsigned _load(double* e, limb_array const& x, unsigned count = N) {
+		unsigned elen = 0;
+		for (unsigned i = count; i-- > 0; )
+			if (x[i] != 0.0)
+				e[elen++] = x[i];
+		return elen;
+	}
+
+	/*! Rounds the expansion 'e' to the nearest N-component value. */
+	static multi_double _from_expansion(unsigned elen, double* e) {
+		multi_double r;
+		elen = _compress(elen, e);
+		for (unsigned i = 0; i < N && i < elen; ++i)
+			r.x_[i] = e[elen - 1 - i];
+		return r;
+	}
+
+	/*! Sum of an N-component value and an expansion. */
+	static multi_double _add(limb_array const& a, unsigned flen, double const* f) {
+		scratch_type h;
+		unsigned hlen = _load(h.data(), a);
+		for (unsigned i = 0; i < flen; ++i)
+			hlen = _grow(hlen, h.data(), f[i]);
+		return _from_expansion(hlen, h.data());
+	}
+
+public:
+	constexpr multi_double() : x_{} { }
+	constexpr multi_double(double d) : x_{} { x_[0] = d; }
+	multi_double(int i) : multi_double(double(i)) { }
+	/*! Exact for every long long: each 32-bit half converts to double exactly. */
+	multi_double(long long i) : x_{} {
+		double hi = double(i >> 32) * 0x1p32;
+		double lo = double(i & 0xffffffffLL);
+		x_[0] = two_sum(hi, lo, x_[1]);
+	}
+
+	/*! Construct from a decimal string such as "-12.5e3". */
+	explicit multi_double(std::string const& s);
+
+	/*! Construct directly from components.  Assumes they are already non-overlapping. */
+	static multi_double from_limbs(limb_array const& limbs) {
+		multi_double r;
+		r.x_ = limbs;
+		return r;
+	}
+
+	[[nodiscard]] double		operator [] (unsigned i) const { return x_[i]; }
+	[[nodiscard]] limb_array const&	limbs() const { return x_; }
+	[[nodiscard]] explicit		operator double() const { return x_[0]; }
+	[[nodiscard]] bool			is_finite() const { return std::isfinite(x_[0]); }
+	[[nodiscard]] bool			is_zero() const { return x_[0] == 0.0; }
+	[[nodiscard]] bool			is_negative() const { return x_[0] < 0.0; }
+
+	/*! Fixed-point decimal representation with 'precision' digits after the decimal point. */
+	[[nodiscard]] std::string	to_string(int precision = digits10) const;
+
+	// constants
+	[[nodiscard]] static multi_double pi();
+	[[nodiscard]] static multi_double e();
+	[[nodiscard]] static multi_double ln2();
+	[[nodiscard]] static multi_double ln10();
+	[[nodiscard]] static multi_double epsilon() { return multi_double(std::ldexp(1.0, -53 * int(N))); }
+
+	// arithmetic
+	[[nodiscard]] friend multi_double operator - (multi_double const& a) {
+		multi_double r;
+		for (unsigned i = 0; i < N; ++i)
+			r.x_[i] = -a.x_[i];
+		return r;
+	}
+
+	[[nodiscard]] friend multi_double operator + (multi_double const& a, multi_double const& b) {
+		if (!std::isfinite(a.x_[0] + b.x_[0]))
+			return multi_double(a.x_[0] + b.x_[0]);
+		double f[N];
+		unsigned flen = _load(f, b.x_);
+		return _add(a.x_, flen, f);
+	}
+
+	[[nodiscard]] friend multi_double operator - (multi_double const& a, multi_double const& b) {
+		return a + -b;
+	}
+
+	[[nodiscard]] friend multi_double operator * (multi_double const& a, multi_double const& b) {
+		double p = a.x_[0] * b.x_[0];
+		if (p == 0.0 || !std::isfinite(p))
+			return multi_double(p);
+
+		// Products a[i]*b[j] with i+j > N are below the precision of the result.
+		scratch_type h;
+		unsigned hlen = 0;
+		for (unsigned j = 0; j < N && b.x_[j] != 0.0; ++j) {
+			double e[N + 1], s[2 * N + 2];
+			unsigned elen = _load(e, a.x_, N + 1 - j > N ? N : N + 1 - j);
+			unsigned slen = _scale(elen, e, b.x_[j], s);
+			for (unsigned i = 0; i < slen; ++i)
+				hlen = _grow(hlen, h.data(), s[i]);
+			if (hlen > 2 * N) {
+				// keep the N+1 most significant components as guard digits
+				hlen = _compress(hlen, h.data());
+				if (hlen > N + 1) {
+					for (unsigned i = 0; i < N + 1; ++i)
+						h[i] = h[hlen - N - 1 + i];
+					hlen = N + 1;
+				}
+			}
+		}
+		return _from_expansion(hlen, h.data());
+	}
+
+	[[nodiscard]] friend multi_double operator * (multi_double const& a, double b) {
+		double p = a.x_[0] * b;
+		if (p == 0.0 || !std::isfinite(p))
+			return multi_double(p);
+		double e[N], h[2 * N];
+		unsigned elen = _load(e, a.x_);
+		return _from_expansion(_scale(elen, e, b, h), h);
+	}
+
+	[[nodiscard]] friend multi_double operator / (multi_double const& a, multi_double const& b) {
+		double q = a.x_[0] / b.x_[0];
+		if (q == 0.0 || !std::isfinite(q))
+			return multi_double(q);
+
+		// long division, one double of quotient at a time
+		double quotient[N + 1];
+		multi_double r = a;
+		for (unsigned i = 0; i <= N; ++i) {
+			quotient[i] = r.x_[0] / b.x_[0];
+			r = r - b * quotient[i];
+		}
+		scratch_type h;
+		unsigned hlen = 0;
+		for (unsigned i = N + 1; i-- > 0; )
+			hlen = _grow(hlen, h.data(), quotient[i]);
+		return _from_expansion(hlen, h.data());
+	}
+
+	multi_double& operator += (multi_double const& rhs) { return *this = *this + rhs; }
+	multi_double& operator -= (multi_double const& rhs) { return *this = *this - rhs; }
+	multi_double& operator *= (multi_double const& rhs) { return *this = *this * rhs; }
+	multi_double& operator /= (multi_double const& rhs) { return *this = *this / rhs; }
+
+	// comparison, by the sign of the difference so that equal values with different component splits compare equal
+	[[nodiscard]] friend bool operator == (multi_double const& a, multi_double const& b) { return (a - b).x_[0] == 0.0; }
+	[[nodiscard]] friend bool operator != (multi_double const& a, multi_double const& b) { return !(a == b); }
+	[[nodiscard]] friend bool operator <  (multi_double const& a, multi_double const& b) { return (a - b).x_[0] < 0.0; }
+	[[nodiscard]] friend bool operator >  (multi_double const& a, multi_double const& b) { return b < a; }
+	[[nodiscard]] friend bool operator <= (multi_double const& a, multi_double const& b) { return !(b < a); }
+	[[nodiscard]] friend bool operator >= (multi_double const& a, multi_double const& b) { return !(a < b); }
+
+	/*! Multiply by 2^exp (exact). */
+	[[nodiscard]] friend multi_double ldexp(multi_double const& a, int exp) {
+		multi_double r;
+		for (unsigned i = 0; i < N; ++i)
+			r.x_[i] = std::ldexp(a.x_[i], exp);
+		return r;
+	}
+
+	[[nodiscard]] friend multi_double abs(multi_double const& a) { return a.x_[0] < 0.0 ? -a : a; }
+	[[nodiscard]] friend multi_double (min)(multi_double const& a, multi_double const& b) { return b < a ? b : a; }
+	[[nodiscard]] friend multi_double (max)(multi_double const& a, multi_double const& b) { return a < b ? b : a; }
+
+	[[nodiscard]] friend multi_double floor(multi_double const& a) {
+		multi_double r;
+		for (unsigned i = 0; i < N; ++i) {
+			r.x_[i] = std::floor(a.x_[i]);
+			if (r.x_[i] != a.x_[i])
+				break;
+		}
+		scratch_type h;
+		return _from_expansion(_load(h.data(), r.x_), h.data());
+	}
+
+	[[nodiscard]] friend multi_double ceil(multi_double const& a) { return -floor(-a); }
+};
+
+
+
+/*! Double-double: about 32 significant digits. */
+using dd_real = multi_double<2>;
+
+/*! Quad-double: about 64 significant digits. */
+using qd_real = multi_double<4>;
+
+
+
+// Elementary functions, defined in multi_double.cpp for dd_real and qd_real.
+template <unsigned N> [[nodiscard]] multi_double<N> sqrt(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> pow(multi_double<N> const& a, long long n);
+template <unsigned N> [[nodiscard]] multi_double<N> pow(multi_double<N> const& a, multi_double<N> const& b);
+template <unsigned N> [[nodiscard]] multi_double<N> exp(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> log(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> log2(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> log10(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> sin(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> cos(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> tan(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> asin(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> acos(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> atan(multi_double<N> const& a);
+template <unsigned N> [[nodiscard]] multi_double<N> atan2(multi_double<N> const& y, multi_double<N> const& x);
@@ -0,0 +1,144 @@
+#pragma once
+/*!	\file	operation_profiler.hpp
+	\brief	OperationProfiler class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Attributes the RPN evaluator's time and allocations to each kind
+of operation and the types of its operands, e.g. Power applied to
+(Integer, Integer) or Factorial applied to (Integer), and optionally
+to the place in the expression where the operation was written.
+
+Install one with ExpressionEvaluator::set_operation_profiler() (or
+RPNEvaluator::set_profiler()).  The RPN evaluator does not apply
+operations yet, so it records nothing; whatever applies an operation
+times it, from taking its operands to stacking its result, and adds
+it with record().  Operands read through a Variable are counted as
+the variable's value type.
+
+ranked() and report() list the costs from the most expensive down;
+folded() writes them in the folded-stack format read by flame graph
+tools (flamegraph.pl, speedscope, inferno):
+
+	evaluate;Power;Integer,Integer 81230
+
+A profiler is not synchronized; give each thread's session its own
+and merge() them.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	The RPN evaluator records nothing until it applies operations.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/eval_error.hpp>
+#include <ee/operation.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+
+class OperationProfiler {
+public:
+	/*! The accumulated cost of one operation on one combination of operand types (and one source offset, if kept). */
+	struct entry {
+		std::string		operation;		// e.g. "Power"
+		std::string		operands;		// e.g. "Integer,Integer"
+		std::uint32_t	offset = EvalError::no_offset;	// character offset of the operation in its expression
+		std::uint64_t	calls = 0;
+		std::uint64_t	ns = 0;
+		std::uint64_t	allocations = 0;
+
+		[[nodiscard]] double ns_per_call() const { return calls ? double(ns) / double(calls) : 0; }
+	};
+
+	/*! The running totals behind an entry. */
+	struct counters {
+		std::uint64_t	calls = 0;
+		std::uint64_t	ns = 0;
+		std::uint64_t	allocations = 0;
+
+		void add(std::uint64_t elapsed_ns, std::uint64_t allocated) { ++calls; ns += elapsed_ns; allocations += allocated; }
+	};
+
+	/*! What folded() weighs each stack by. */
+	enum class Weight : std::uint8_t { time, allocations, calls };
+
+	static constexpr std::size_t typed_operands = 3;		// operands beyond these count towards the arity only
+
+	/*! With 'spans', costs are also split by where in the expression each operation was written. */
+	explicit OperationProfiler(bool spans = false) : spans_m(spans) { }
+
+	void set_spans(bool on) { spans_m = on; }
+	[[nodiscard]] bool spans() const { return spans_m; }
+
+	/*! The character offset of each postfix token of the expression about to be evaluated; empty if unknown.
+		The offsets must outlive the evaluation. */
+	void set_offsets(std::span<std::uint32_t const> postfix_offsets) { offsets_m = postfix_offsets; }
+
+	/*! The counters of 'operation' applied to 'args' (in postfix order), the token at 'postfix_index'.
+		Found before the operation is applied, while its operands are still stacked; valid until reset(). */
+	[[nodiscard]] counters& at(Operation const& operation, std::span<Token::pointer_type const> args, std::uint32_t postfix_index);
+
+	/*! Adds one application of 'operation' to 'args'. */
+	void record(Operation const& operation, std::span<Token::pointer_type const> args, std::uint32_t postfix_index, std::uint64_t ns, std::uint64_t allocations) {
+		at(operation, args, postfix_index).add(ns, allocations);
+	}
+
+	/*! The entries, most expensive first. */
+	[[nodiscard]] std::vector<entry> ranked() const;
+
+	/*! A table of the 'top' most expensive entries with their share of the total time. */
+	void report(std::ostream& out, std::size_t top = 20) const;
+
+	/*! One line per entry, "evaluate;operation[@offset];operand types weight". */
+	void folded(std::ostream& out, Weight weight = Weight::time) const;
+
+	void merge(OperationProfiler const& other);
+	void reset() { costs_m.clear(); }
+
+	[[nodiscard]] std::uint64_t total_ns() const;
+	[[nodiscard]] std::size_t size() const { return costs_m.size(); }
+
+	/*! The unqualified class name of a type, e.g. "Power", under any compiler. */
+	[[nodiscard]] static std::string type_name(std::type_info const& type);
+
+private:
+	struct key_type {
+		std::type_info const*								operation = nullptr;
+		std::array<std::type_info const*, typed_operands>	operands{};
+		std::uint32_t										arity = 0;
+		std::uint32_t										offset = EvalError::no_offset;
+		bool operator == (key_type const&) const = default;
+	};
+	struct key_hash {
+		std::size_t operator () (key_type const& key) const;
+	};
+
+	bool										spans_m;
+	std::span<std::uint32_t const>				offsets_m;
+	std::unordered_map<key_type, counters, key_hash>	costs_m;
+};
@@ -10,6 +10,9 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added try_parse().
+
 Version 2021.11.01
 	C++ 20 validated
 	Changed to GATS_TEST
@@ -37,11 +40,19 @@ stipulated in the agreement/contract under which
 the program(s) have been supplied.
 =============================================================*/
 #include <ee/token.hpp>
+#include <ee/eval_error.hpp>
+#include <cstdint>
+#include <vector>
 
 class Parser {
 	Parser(Parser const&) = delete;
 	Parser& operator = (Parser const&) = delete;
 public:
 	Parser() = default;
+	/*! @throw char const* describing the error. */
 	[[nodiscard]] TokenList parse(TokenList const& infixTokens);
+
+	/*! As parse(), but returns the error instead of throwing; its offset is the index of the infix token.
+		The infix index of each postfix token is appended to 'origins' if given. */
+	[[nodiscard]] EvalExpected<TokenList> try_parse(TokenList const& infixTokens, std::vector<std::uint32_t>* origins = nullptr);
 };
@@ -0,0 +1,47 @@
+#pragma once
+/*!	\file	quad_double.hpp
+	\brief	QuadDouble class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declarations of the QuadDouble class derived from Operand.
+A mid-precision (about 64 digits) alternative to Real.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/operand.hpp>
+#include <ee/multi_double.hpp>
+
+
+/*! Quad-double real number token. */
+class QuadDouble : public Operand {
+public:
+	DEF_POINTER_TYPE(QuadDouble)
+	using value_type = qd_real;
+private:
+	value_type	value_;
+public:
+	QuadDouble(value_type value = value_type(0.0)) : value_(value) { }
+	[[nodiscard]] value_type	value() const { return value_; }
+	[[nodiscard]] string_type	str() const override;
+};
@@ -14,6 +14,10 @@ the subclasses Pi and E.
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added RealBackend.
+	Added RealBackend::Lazy.
+
 Version 2021.10.26
 	C++ 20 validated
 
@@ -52,6 +56,15 @@ the program(s) have been supplied.
 #include <boost/math/constants/constants.hpp>
 
 
+/*! Numeric representation used for real literals and the real constants. */
+enum class RealBackend {
+	Multiprecision,		//!< Real: 1000 digit cpp_dec_float
+	DoubleDouble,		//!< DoubleDouble: about 32 digits
+	QuadDouble,			//!< QuadDouble: about 64 digits
+	Lazy				//!< LazyReal: digits computed on demand, up to 1000
+};
+
+
 /*! Real number token. */
 class Real : public Operand {
 public:
@@ -0,0 +1,94 @@
+#pragma once
+/*!	\file	result_history.hpp
+	\brief	ResultHistory class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declaration of the ResultHistory class: the bounded store behind
+the Result(n) function.
+
+Results are numbered from 1 for the life of a session.  Only the
+most recent 'capacity' of them are kept, in a ring buffer that
+grows as results arrive, so Result(n) is a single index calculation
+and a session that records few results allocates little.  Integers
+that fit a long long and Booleans are stored inline; an integer is
+turned back into an operand at each lookup, which never changes the
+history, so const lookups may run concurrently, and the two Booleans
+are shared constants.  Other operands
+are immutable and are kept by shared pointer, so a 1000-digit Real
+is never copied.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Grow the ring on demand.
+	Lookups no longer rewrite the ring.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/operand.hpp>
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+
+class ResultHistory {
+public:
+	using size_type = std::size_t;
+	static constexpr size_type default_capacity = 1000;
+
+private:
+	using entry_type = std::variant<std::monostate, long long, bool, Operand::pointer_type>;
+
+	std::vector<entry_type>			ring_m;			// the held results
+	size_type						capacity_m;
+	size_type						oldest_m = 0;	// ring index of the oldest held result
+	size_type						count_m = 0;	// results recorded since the session began
+
+public:
+	explicit ResultHistory(size_type capacity = default_capacity);
+
+	/*! Records the next result; the oldest is dropped when full.  Returns its 1-based index. */
+	size_type push(Operand::pointer_type const& result);
+
+	/*! Result number n (1-based).
+		@throw std::out_of_range if n was never recorded or has been dropped. */
+	[[nodiscard]] Operand::pointer_type at(size_type n) const;
+
+	/*! True if Result(n) is still held. */
+	[[nodiscard]] bool contains(size_type n) const { return n > first_index() && n <= count_m; }
+
+	/*! Results recorded so far, including dropped ones. */
+	[[nodiscard]] size_type count() const { return count_m; }
+
+	/*! Results currently held. */
+	[[nodiscard]] size_type size() const { return ring_m.size(); }
+
+	[[nodiscard]] size_type capacity() const { return capacity_m; }
+
+	/*! Changes the capacity, keeping the most recent results.  Capacity 0 disables the history. */
+	void set_capacity(size_type capacity);
+
+	/*! Forgets all results; numbering restarts after 'count' (used when restoring a session). */
+	void clear(size_type count = 0);
+
+private:
+	[[nodiscard]] size_type first_index() const { return count_m - size(); }
+	[[nodiscard]] size_type slot_index(size_type n) const { return (oldest_m + (n - first_index() - 1)) % ring_m.size(); }
+};
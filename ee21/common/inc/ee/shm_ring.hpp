@@ -0,0 +1,216 @@
+#pragma once
+/*!	\file	shm_ring.hpp
+	\brief	Shared-memory ring transport declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Expression submission through shared memory (Linux only), for
+producers on the same host.
+
+The server creates a POSIX shared memory segment divided into
+lanes.  A client claims a free lane; the lane holds a request ring
+and a response ring, each single-producer/single-consumer, so
+neither needs a lock: the writer owns the head index, the reader
+owns the tail index.  Many clients reach one server through many
+lanes.
+
+A record is a 4-byte length and the bytes, padded to 8, and never
+wraps: a record that would reach past the end of the ring is
+preceded by a skip marker instead.  Readers therefore get every
+record as a string_view into the ring itself.  Readers check each
+record against the ring before handing it out, since the writer may be
+another process; the server stops serving a lane whose ring is corrupt.
+
+Sleeping uses futexes.  A reader spins briefly, then announces
+itself on a doorbell and sleeps on it; a writer makes the wake
+syscall only when someone has announced, so a busy pipeline makes
+no system calls at all.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	front() rejects records that reach outside the ring.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#if defined(__linux__)
+
+#include <ee/environment.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+/*! A futex word that readers sleep on.  Lives in shared memory. */
+struct ShmDoorbell {
+	std::atomic<std::uint32_t>	sequence{ 0 };
+	std::atomic<std::uint32_t>	sleepers{ 0 };
+
+	/*! Wakes the sleepers, if any; costs no system call when nobody sleeps. */
+	void ring();
+
+	/*! Returns once 'ready()' is true, spinning first and then sleeping until ring(). */
+	void wait(std::function<bool()> const& ready);
+};
+
+
+
+/*! One single-producer/single-consumer ring of length-prefixed records.
+	The header and data live in shared memory; a ShmRing is one side's view of them. */
+class ShmRing {
+public:
+	struct header {
+		alignas(64) std::atomic<std::uint64_t>	head{ 0 };		// bytes published by the writer
+		alignas(64) std::atomic<std::uint64_t>	tail{ 0 };		// bytes released by the reader
+		alignas(64) std::uint64_t				capacity = 0;	// a power of two
+	};
+
+private:
+	header*			header_m = nullptr;
+	std::uint64_t	capacity_m = 0;				// read once: the header is writable by the other side
+	char*			data_m = nullptr;
+	ShmDoorbell*	readable_m = nullptr;		// rung after a push
+	ShmDoorbell*	writable_m = nullptr;		// rung after a pop
+	std::uint64_t	front_size_m = 0;			// size of the record front() returned
+
+public:
+	ShmRing() = default;
+	ShmRing(header* h, char* data, ShmDoorbell* readable, ShmDoorbell* writable)
+		: header_m(h), capacity_m(h->capacity), data_m(data), readable_m(readable), writable_m(writable) { }
+
+	/*! The longest payload a ring of 'capacity' bytes always accepts. */
+	[[nodiscard]] static constexpr std::size_t max_record(std::uint64_t capacity) { return static_cast<std::size_t>(capacity / 2 - 8); }
+
+	/*! Writer: appends one record made of 'a' followed by 'b'; false if there is no room yet.
+		@throw std::length_error if the record can never fit. */
+	bool try_push(std::string_view a, std::string_view b = {});
+
+	/*! Reader: the oldest record, in place, or nothing if the ring is empty.
+		The view stays valid until pop().
+		@throw std::runtime_error if the indices or the record's length reach outside the ring. */
+	[[nodiscard]] std::optional<std::string_view> front();
+
+	/*! Reader: releases the record returned by front(). */
+	void pop();
+
+	[[nodiscard]] bool empty() const { return header_m->head.load(std::memory_order_acquire) == header_m->tail.load(std::memory_order_acquire); }
+	[[nodiscard]] bool can_push(std::size_t bytes) const;
+};
+
+
+
+/*! Serves expressions submitted through a shared memory segment. */
+class ShmEvalServer {
+public:
+	static constexpr std::uint64_t default_ring_bytes = 1 << 20;
+
+private:
+	std::string					name_m;
+	std::size_t					bytes_m = 0;
+	void*						mapping_m = nullptr;
+	Environment::base_type		base_m;
+	std::vector<std::thread>	threads_m;
+
+public:
+	/*! Creates the segment 'name' (an existing one is replaced) with 'lanes' client lanes whose rings
+		hold 'ring_bytes' each, served by 'threads' threads (at most one per lane).
+		@throw std::runtime_error if the segment cannot be created. */
+	ShmEvalServer(std::string name, std::size_t lanes, std::size_t threads = 1,
+		std::uint64_t ring_bytes = default_ring_bytes, Environment::base_type base = nullptr);
+
+	/*! Stops and removes the segment. */
+	~ShmEvalServer();
+
+	ShmEvalServer(ShmEvalServer const&) = delete;
+	ShmEvalServer& operator = (ShmEvalServer const&) = delete;
+
+	/*! Starts the serving threads. */
+	void start();
+
+	/*! Starts the serving threads and waits for them to finish. */
+	void run();
+
+	/*! Makes the serving threads finish; callable from any thread. */
+	void stop();
+
+	[[nodiscard]] std::string const& name() const { return name_m; }
+
+private:
+	void _serve(std::size_t group, std::size_t groups);
+};
+
+
+
+/*! A client of ShmEvalServer that owns one lane of the segment for its lifetime. */
+class ShmEvalClient {
+public:
+	/*! A response; 'text' points into the response ring and stays valid until the next receive. */
+	struct reply {
+		bool				ok = false;
+		std::string_view	text;
+	};
+
+private:
+	void*			mapping_m = nullptr;
+	std::size_t		bytes_m = 0;
+	void*			lane_m = nullptr;
+	ShmRing			requests_m;
+	ShmRing			responses_m;
+	bool			holding_m = false;		// a reply is in view and not yet popped
+	std::size_t		in_flight_m = 0;
+
+public:
+	/*! Claims a free lane of the segment 'name'.
+		@throw std::runtime_error if the segment does not exist or every lane is taken. */
+	explicit ShmEvalClient(std::string const& name);
+
+	/*! Collects the outstanding replies and frees the lane. */
+	~ShmEvalClient();
+
+	ShmEvalClient(ShmEvalClient const&) = delete;
+	ShmEvalClient& operator = (ShmEvalClient const&) = delete;
+
+	/*! Queues a request; false if the request ring is full. */
+	bool try_send(std::string_view expr);
+
+	/*! Queues a request, waiting for room.  Keep reading replies, or the rings can fill both ways. */
+	void send(std::string_view expr);
+
+	/*! The reply to the oldest outstanding request, if it has arrived. */
+	[[nodiscard]] std::optional<reply> try_receive();
+
+	/*! The reply to the oldest outstanding request, waiting for it.
+		@throw std::logic_error if no request is outstanding. */
+	[[nodiscard]] reply receive();
+
+	[[nodiscard]] reply evaluate(std::string_view expr) { send(expr); return receive(); }
+
+	[[nodiscard]] std::size_t in_flight() const { return in_flight_m; }
+
+private:
+	void _release();
+};
+
+#endif // __linux__
@@ -0,0 +1,59 @@
+#pragma once
+/*!	\file	snapshot.hpp
+	\brief	Binary session snapshot declarations.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Save and restore of an ExpressionEvaluator session (variables and
+Result history) without re-evaluating anything.  Only the session's
+own variables are saved, not the shared base layers under them; a
+snapshot is loaded over the loading session's base.
+
+Numbers are stored as their internal representation: cpp_int limbs,
+cpp_dec_float digit elements, double-double limbs and the 128-bit
+Decimal count.  A snapshot is a header followed by tagged sections;
+readers skip sections they do not know.  load_session() maps the
+file into memory and decodes it in place.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Loading keeps the session's base layer and variable limits, and is all-or-nothing.
+	Saves only the session's own variables, not its base layers.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/expression_evaluator.hpp>
+#include <cstddef>
+#include <string>
+
+
+/*! Encodes the session's variables and held results.
+	Bound variables are saved with their current value; LazyReal values as their Real approximation. */
+[[nodiscard]] std::string serialize_session(ExpressionEvaluator const& ee);
+
+/*! Replaces the session's variables and history with those in the snapshot.  The snapshot's
+	variables are laid over the session's base layer (base variables it does not name stay
+	visible) and the session's variable limits stay in force.  On any error the session is unchanged.
+	@throw std::runtime_error if the data is not a valid snapshot or its variables exceed the limits. */
+void deserialize_session(ExpressionEvaluator& ee, char const* data, std::size_t size);
+
+/*! File forms of the above; load_session() reads through a memory mapping. */
+void save_session(ExpressionEvaluator const& ee, std::string const& path);
+void load_session(ExpressionEvaluator& ee, std::string const& path);
@@ -0,0 +1,100 @@
+#pragma once
+/*!	\file	thread_pool.hpp
+	\brief	ThreadPool class declaration.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Declaration of the Executor interface, something tasks can be posted
+to, and the ThreadPool class: a fixed set of worker threads draining
+one FIFO queue of tasks.
+
+ThreadPool::shared() is the process-wide pool used by the batch and
+asynchronous evaluation APIs; it starts one thread per core on
+first use.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Added the Executor interface.
+	A task that throws terminates the process loudly; added submit().
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+/*! Runs posted tasks somewhere: a pool, an event loop, a UI thread... */
+class Executor {
+public:
+	using task_type = std::function<void()>;
+
+	virtual ~Executor() = default;
+	virtual void post(task_type task) = 0;
+};
+
+
+
+class ThreadPool : public Executor {
+private:
+	std::mutex					mutex_m;
+	std::condition_variable		ready_m;
+	std::deque<task_type>		tasks_m;
+	bool						stopping_m = false;
+	std::vector<std::thread>	threads_m;
+
+public:
+	/*! Starts 'threads' workers; 0 means one per core. */
+	explicit ThreadPool(std::size_t threads = 0);
+
+	/*! Runs the tasks already posted, then joins the workers. */
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator = (ThreadPool const&) = delete;
+
+	/*! Queues a task.  A task must not throw: an exception escaping it is reported on
+		std::cerr and the process is terminated.  Use submit() to receive it instead. */
+	void post(task_type task) override;
+
+	/*! Queues 'f'; its result, or the exception it throws, is delivered through the future. */
+	template <typename F>
+	[[nodiscard]] std::future<std::invoke_result_t<F&>> submit(F f) {
+		auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F&>()>>(std::move(f));
+		auto result = task->get_future();
+		post([task] { (*task)(); });
+		return result;
+	}
+
+	[[nodiscard]] std::size_t size() const { return threads_m.size(); }
+
+	/*! The process-wide pool. */
+	[[nodiscard]] static ThreadPool& shared();
+
+private:
+	void _run();
+};
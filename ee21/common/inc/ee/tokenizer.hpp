@@ -9,6 +9,19 @@
 Revision History
 ------------------------------------------------------------ -
 
+Version 2026.10.17
+	Added parameterize() and number() for literal-independent plans.
+	parameterize() records the offset of each token.
+	Added try_tokenize().
+	XTokenizer derives from std::runtime_error; std::exception(char const*) is MSVC-only.
+	Added real_backend selection.
+	Added decimal literal suffix.
+	Added variable() for direct access to the symbol table.
+	Variables are held in a layered Environment.
+	Split into a shared read-only core and per-session TokenizerSession state.
+	Added assign() honouring the session's variable limits.
+	The session can record the name of each variable token.
+
 Version 2021.10.02
 	C++ 20 validated
 
@@ -56,12 +69,48 @@ the program(s) have been supplied.
 ============================================================= */
 
 #include <ee/token.hpp>
+#include <ee/real.hpp>
+#include <ee/environment.hpp>
+#include <ee/eval_error.hpp>
+#include <cstdint>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+/*! Each variable token made by the tokenizer, with the name it was written as. */
+using VariableNames = std::vector<std::pair<Token const*, Token::string_type>>;
+
+
+
+/*! Per-session symbol state read and written by the tokenizer. */
+struct TokenizerSession {
+	Environment		environment;
+	RealBackend		real_backend = RealBackend::Multiprecision;
+	VariableNames*	variable_names = nullptr;		// if set, every variable token met is appended
+};
+
+
+
+/*! An expression with its numeric literals lifted out.  'text' has '#' for each literal,
+	one space between tokens and keywords in lower case, so expressions that differ only
+	in their constants, spacing or keyword case have the same text. */
+struct ParameterizedExpression {
+	std::string						text;
+	std::vector<std::string_view>	literals;			// views of the original expression
+	std::vector<std::size_t>		literal_tokens;		// token index of each literal
+	std::vector<std::uint32_t>		offsets;			// character offset of each token in the original expression
+	std::size_t						tokens = 0;
+};
+
 
 
 /*! Tokenizer class is used to create lists of tokens from expression strings.
-	It maintains a dictionary of variable tokens introduced by the expression strings.
+	The keyword dictionary, character classes and operator tokens form a read-only
+	core shared by all tokenizers; each Tokenizer owns only its session state.
 	*/
 class Tokenizer {
 	// Block copying
@@ -72,12 +121,12 @@ class Tokenizer {
 public:
 	using string_type = Token::string_type;
 
-	class XTokenizer : public std::exception {
+	class XTokenizer : public std::runtime_error {
 		string_type	expression_m;
 		std::size_t	location_m;
 	public:
 		XTokenizer(string_type const& expression, std::size_t location, char const* msg)
-			: std::exception(msg)
+			: std::runtime_error(msg)
 			, expression_m(expression)
 			, location_m(location)
 		{ }
@@ -103,19 +152,63 @@ public:
 
 private:
 	using dictionary_type = std::map<string_type, Token::pointer_type>;
+	struct core;
 
 // ATTRIBUTES
 private:
-	dictionary_type	keywords_m;
-	dictionary_type variables_m;
+	TokenizerSession	session_m;
 
 // OPERATIONS
 public:
 	Tokenizer();
-	TokenList tokenize(string_type const& expression);
+	TokenList tokenize(string_type const& expression) { return tokenize(expression, session_m); }
+
+	/*! Tokenizes against the given session.  Safe to call concurrently with distinct sessions. */
+	[[nodiscard]] static TokenList tokenize(string_type const& expression, TokenizerSession& session);
+
+	/*! As tokenize(), but reports a bad character or a rejected new variable as an EvalError instead of throwing.
+		The character offset of each token is appended to 'offsets' if given. */
+	[[nodiscard]] static EvalExpected<TokenList> try_tokenize(string_type const& expression, TokenizerSession& session, std::vector<std::uint32_t>* offsets = nullptr);
+	[[nodiscard]] EvalExpected<TokenList> try_tokenize(string_type const& expression, std::vector<std::uint32_t>* offsets = nullptr) { return try_tokenize(expression, session_m, offsets); }
+
+	/*! Fills 'result' from 'expression' (reusing its storage), following the tokenizer's rules
+		so that token i of the text is token i of tokenize().
+		@return false if the expression has a character tokenize() would reject. */
+	static bool parameterize(string_type const& expression, ParameterizedExpression& result);
+	static bool parameterize(string_type&& expression, ParameterizedExpression& result) = delete;	// the literals would dangle
+
+	/*! The token tokenize() makes for the numeric literal 'text'. */
+	[[nodiscard]] static Token::pointer_type number(std::string_view text, RealBackend backend);
+
+	/*! True if 'name' is a keyword rather than a possible variable. */
+	[[nodiscard]] static bool is_keyword(string_type const& name);
+
+	/*! Selects the operand type produced for real literals and the constants Pi and E. */
+	void set_real_backend(RealBackend backend) { session_m.real_backend = backend; }
+	[[nodiscard]] RealBackend real_backend() const { return session_m.real_backend; }
+
+	/*! The named variable, created if it does not yet exist.
+		@throw std::invalid_argument if the name is a keyword. */
+	[[nodiscard]] Variable::pointer_type variable(string_type const& name);
+
+	/*! Assigns the named variable within the session's variable limits.
+		@throw std::invalid_argument if the name is a keyword; std::length_error if the value does not fit. */
+	void assign(string_type const& name, Operand::pointer_type const& value);
+
+	/*! The session's variables. */
+	[[nodiscard]] Environment& environment() { return session_m.environment; }
+	[[nodiscard]] Environment const& environment() const { return session_m.environment; }
+	void set_environment(Environment environment) { session_m.environment = std::move(environment); }
+
+	[[nodiscard]] TokenizerSession& session() { return session_m; }
+	[[nodiscard]] TokenizerSession const& session() const { return session_m; }
 
 private:
-	[[nodiscard]] Token::pointer_type _get_identifier(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression);
-	[[nodiscard]] Token::pointer_type _get_number(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression);
+	[[nodiscard]] static core const& _core();
+	[[nodiscard]] static bool _is_decimal_suffix(string_type::const_iterator currentChar, string_type const& expression);
+	[[nodiscard]] static Token::pointer_type _make_real(string_type const& digits, RealBackend backend);
+	[[nodiscard]] static Token::pointer_type _make_real_constant(Token::pointer_type const& constant, RealBackend backend);
+	[[nodiscard]] static Token::pointer_type _get_identifier(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression, TokenizerSession& session);
+	[[nodiscard]] static Token::pointer_type _get_number(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression, RealBackend backend);
+	[[nodiscard]] static string_type::const_iterator _number_end(string_type::const_iterator currentChar, string_type const& expression);
 };
-
@@ -12,6 +12,11 @@ Declarations of the Variable class derived from Operand.
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added binding to host memory and getter callbacks.
+	Added copy().
+	Added freeze(); host-memory bindings convert only a changed value.
+
 Version 2021.10.26
 	C++ 20 validated
 
@@ -42,18 +47,43 @@ the program(s) have been supplied.
 =============================================================*/
 
 #include <ee/operand.hpp>
+#include <cstdint>
+#include <functional>
 
 
-/*! Variable operand token. */
+/*! Variable operand token.
+	A variable either holds its value or is bound to host memory or a getter,
+	in which case every read sees the host's current value.
+	*/
 class Variable : public Operand {
 public:
 	DEF_POINTER_TYPE(Variable)
 	using value_type = Operand::pointer_type;
+	using getter_type = std::function<Operand::pointer_type()>;
 private:
 	value_type	value_m;
+	getter_type	getter_m;
 public:
 	Variable() = default;
-	[[nodiscard]]	value_type	value() const { return value_m; }
-					void		set(Operand::pointer_type const& value) { value_m = value; }
+	[[nodiscard]]	value_type	value() const { return getter_m ? getter_m() : value_m; }
+
+	/*! Assigns a value; an existing binding is released. */
+					void		set(Operand::pointer_type const& value) { getter_m = nullptr; value_m = value; }
+
+	/*! Binds to host storage.  The storage must outlive the binding.
+		The value is converted again only when the storage has changed since the last read. */
+					void		bind(double const* location);
+					void		bind(std::int64_t const* location);
+					void		bind(bool const* location);
+					void		bind(getter_type getter) { getter_m = std::move(getter); value_m = nullptr; }
+					void		unbind() { getter_m = nullptr; }
+	[[nodiscard]]	bool		is_bound() const { return static_cast<bool>(getter_m); }
+
+	/*! A new variable with the same value or binding. */
+	[[nodiscard]]	pointer_type	copy() const;
+
+	/*! A new variable holding the current value; a binding is read now and not carried. */
+	[[nodiscard]]	pointer_type	freeze() const;
+
 	[[nodiscard]]	string_type	str() const override;
 };
@@ -8,6 +8,12 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added try_evaluate(); evaluate() throws its error.
+	Operands and predictable results are checked against the EvaluationLimits.
+	Records the deepest stack of each evaluation.
+	Holds an OperationProfiler; it records nothing until operations are applied.
+
 Version 2021.11.01
 	C++ 20 validated
 	Changed to GATS_TEST
@@ -35,38 +41,55 @@ the program(s) have been supplied.
 #include <ee/integer.hpp>
 #include <ee/operation.hpp>
 #include <cassert>
-#include <stack>
 #include <algorithm>
+#include <span>
+#include <vector>
 
 
 [[nodiscard]] Operand::pointer_type RPNEvaluator::evaluate( TokenList const& rpnExpression ) {
-	
-	std::stack<Token::pointer_type> stack;
-	for (auto tk : rpnExpression)
+	auto result = try_evaluate(rpnExpression);
+	if (!result)
+		throw result.error().message();
+	return *result;
+}
+
+
+
+[[nodiscard]] EvalExpected<Operand::pointer_type> RPNEvaluator::try_evaluate( TokenList const& rpnExpression ) {
+	if (rpnExpression.size() > limits_m.max_postfix_length)
+		return eval_failure(EvalErrc::length_limit, static_cast<std::uint32_t>(std::min<std::size_t>(limits_m.max_postfix_length, EvalError::no_offset)));
+
+	EvaluationBudget budget(limits_m);
+	std::vector<Token::pointer_type> stack;
+	max_depth_m = 0;
+	for (std::uint32_t index = 0; index < rpnExpression.size(); ++index)
 	{
+		auto const& tk = rpnExpression[index];
 		if (is<Operand>(tk))
-			stack.push(tk);
+		{
+			if (auto exceeded = budget.admit(tk))
+				return eval_failure(*exceeded, index);
+			stack.push_back(tk);
+			max_depth_m = std::max(max_depth_m, stack.size());
+		}
 		else
 		{
 			auto operTk = convert<Operation>(tk);
 			auto operationNum = operTk->number_of_args();
 			if (operationNum > stack.size())
-				throw "Insufficient # operands of operation";
-			for (unsigned i = 0; i < operationNum; i++) 
-			{
-				auto operand = stack.top();
-				stack.pop();
-				auto oper = tk.get();
-				
-			}
-			auto operand = stack.top();
-			stack.pop();
-			auto operation = convert<Operation>(tk);
-			operation->str();
+				return eval_failure(EvalErrc::insufficient_operands, index);
+			auto const args = std::span<Token::pointer_type const>(stack).last(operationNum);
+
+			// fail before an operation whose result would exceed the limits is attempted
+			if (auto exceeded = budget.admit(*operTk, args))
+				return eval_failure(*exceeded, index);
+			stack.resize(stack.size() - operationNum);
+
+			// No operation is applied yet, so none is recorded into the profiler: timing the checks
+			// above would report their noise as the operation's cost.
 		}
 	}
 	
 	// The following line is just a placeholder until you have completed the parser.
 	return Operand::pointer_type();
 }
-
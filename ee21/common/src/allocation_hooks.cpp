@@ -0,0 +1,137 @@
+/*!	\file	allocation_hooks.cpp
+	\brief	Counting replacements of the global operator new and delete.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Build this file into a program to turn on AllocationTracker.  Every
+allocation and deallocation through the global operator new and
+delete is reported to it, and its per-thread count is installed as
+the EvaluationMetrics allocation counter.
+
+A program may replace operator new only once; leave this file out of
+programs that replace it themselves.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/allocation_tracking.hpp>
+#include <ee/evaluation_metrics.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+using namespace std;
+
+
+
+namespace {
+	void* allocate(size_t size) {
+		AllocationTracker::on_allocate(size);
+		if (void* p = malloc(max<size_t>(size, 1)))
+			return p;
+		throw bad_alloc();
+	}
+
+	void* allocate(size_t size, align_val_t alignment) {
+		AllocationTracker::on_allocate(size);
+		size_t const align = static_cast<size_t>(alignment);
+#if defined(_MSC_VER)
+		void* p = _aligned_malloc(max<size_t>(size, 1), align);
+#else
+		void* p = aligned_alloc(align, (max<size_t>(size, 1) + align - 1) / align * align);
+#endif
+		if (!p)
+			throw bad_alloc();
+		return p;
+	}
+
+	void deallocate(void* p) noexcept {
+		if (!p)
+			return;
+		AllocationTracker::on_deallocate();
+		free(p);
+	}
+
+	void deallocate(void* p, align_val_t) noexcept {
+		if (!p)
+			return;
+		AllocationTracker::on_deallocate();
+#if defined(_MSC_VER)
+		_aligned_free(p);
+#else
+		free(p);
+#endif
+	}
+
+	void* allocate_nothrow(size_t size) noexcept {
+		try {
+			return allocate(size);
+		}
+		catch (...) {
+			return nullptr;
+		}
+	}
+
+	void* allocate_nothrow(size_t size, align_val_t alignment) noexcept {
+		try {
+			return allocate(size, alignment);
+		}
+		catch (...) {
+			return nullptr;
+		}
+	}
+
+	/*! Announces the hooks before main() runs. */
+	struct install_hooks {
+		install_hooks() {
+			AllocationTracker::mark_installed();
+			EvaluationMetrics::set_allocation_counter(&AllocationTracker::thread_allocations);
+		}
+	} const installer;
+}
+
+
+
+void* operator new (size_t size) { return allocate(size); }
+void* operator new[] (size_t size) { return allocate(size); }
+void* operator new (size_t size, nothrow_t const&) noexcept { return allocate_nothrow(size); }
+void* operator new[] (size_t size, nothrow_t const&) noexcept { return allocate_nothrow(size); }
+void* operator new (size_t size, align_val_t alignment) { return allocate(size, alignment); }
+void* operator new[] (size_t size, align_val_t alignment) { return allocate(size, alignment); }
+void* operator new (size_t size, align_val_t alignment, nothrow_t const&) noexcept { return allocate_nothrow(size, alignment); }
+void* operator new[] (size_t size, align_val_t alignment, nothrow_t const&) noexcept { return allocate_nothrow(size, alignment); }
+
+void operator delete (void* p) noexcept { deallocate(p); }
+void operator delete[] (void* p) noexcept { deallocate(p); }
+void operator delete (void* p, size_t) noexcept { deallocate(p); }
+void operator delete[] (void* p, size_t) noexcept { deallocate(p); }
+void operator delete (void* p, nothrow_t const&) noexcept { deallocate(p); }
+void operator delete[] (void* p, nothrow_t const&) noexcept { deallocate(p); }
+void operator delete (void* p, align_val_t alignment) noexcept { deallocate(p, alignment); }
+void operator delete[] (void* p, align_val_t alignment) noexcept { deallocate(p, alignment); }
+void operator delete (void* p, size_t, align_val_t alignment) noexcept { deallocate(p, alignment); }
+void operator delete[] (void* p, size_t, align_val_t alignment) noexcept { deallocate(p, alignment); }
+void operator delete (void* p, align_val_t alignment, nothrow_t const&) noexcept { deallocate(p, alignment); }
+void operator delete[] (void* p, align_val_t alignment, nothrow_t const&) noexcept { deallocate(p, alignment); }
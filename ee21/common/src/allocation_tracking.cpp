@@ -0,0 +1,130 @@
+/*!	\file	allocation_tracking.cpp
+	\brief	AllocationTracker implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/allocation_tracking.hpp>
+#include <atomic>
+using namespace std;
+
+
+
+namespace {
+	// constant-initialized, so operator new may touch them at any point in a thread's life
+	thread_local array<AllocationCounts, allocation_stage_count>	stage_counts{};
+	thread_local AllocationStage	stage = AllocationStage::other;
+	thread_local uint64_t			evaluation = 0;
+
+	atomic<bool>		hooks_installed{ false };
+	atomic<uint64_t>	last_evaluation_id{ 0 };
+}
+
+
+
+AllocationCounts AllocationProfile::total() const {
+	AllocationCounts sum;
+	for (auto const& counts : stages)
+		sum += counts;
+	return sum;
+}
+
+
+
+bool AllocationTracker::installed() {
+	return hooks_installed.load(memory_order_relaxed);
+}
+
+void AllocationTracker::mark_installed() noexcept {
+	hooks_installed.store(true, memory_order_relaxed);
+}
+
+
+
+AllocationCounts AllocationTracker::thread_total() {
+	AllocationCounts sum;
+	for (auto const& counts : stage_counts)
+		sum += counts;
+	return sum;
+}
+
+AllocationCounts AllocationTracker::thread_stage(AllocationStage s) {
+	return stage_counts[static_cast<size_t>(s)];
+}
+
+AllocationStage AllocationTracker::current_stage() {
+	return stage;
+}
+
+uint64_t AllocationTracker::current_evaluation() {
+	return evaluation;
+}
+
+uint64_t AllocationTracker::thread_allocations() noexcept {
+	uint64_t sum = 0;
+	for (auto const& counts : stage_counts)
+		sum += counts.allocations;
+	return sum;
+}
+
+
+
+void AllocationTracker::on_allocate(size_t bytes) noexcept {
+	auto& counts = stage_counts[static_cast<size_t>(stage)];
+	++counts.allocations;
+	counts.bytes += bytes;
+}
+
+void AllocationTracker::on_deallocate() noexcept {
+	++stage_counts[static_cast<size_t>(stage)].deallocations;
+}
+
+
+
+AllocationTracker::StageScope::StageScope(AllocationStage s) noexcept : previous_m(stage) {
+	stage = s;
+}
+
+AllocationTracker::StageScope::~StageScope() {
+	stage = previous_m;
+}
+
+
+
+AllocationTracker::EvaluationScope::EvaluationScope(AllocationProfile& profile) noexcept {
+	if (!installed())
+		return;
+	profile_m = &profile;
+	previous_m = evaluation;
+	evaluation = last_evaluation_id.fetch_add(1, memory_order_relaxed) + 1;
+	start_m = stage_counts;
+}
+
+AllocationTracker::EvaluationScope::~EvaluationScope() {
+	if (!profile_m)
+		return;
+	profile_m->evaluation_id = evaluation;
+	for (size_t s = 0; s < allocation_stage_count; ++s)
+		profile_m->stages[s] = stage_counts[s] - start_m[s];
+	evaluation = previous_m;
+}
@@ -0,0 +1,116 @@
+/*!	\file	async_evaluation.cpp
+	\brief	AsyncEvaluation class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	The completion executor is held by weak_ptr; deliveries to a destroyed one are dropped.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/async_evaluation.hpp>
+using namespace std;
+
+
+
+bool AsyncEvaluation::state::complete(result_type value, exception_ptr error) {
+	vector<callback_type> callbacks;
+	coroutine_handle<> continuation;
+	{
+		lock_guard<mutex> lock(mutex_m);
+		if (finished_m)
+			return false;
+		finished_m = true;
+		value_m = std::move(value);
+		error_m = std::move(error);
+		callbacks.swap(callbacks_m);
+		continuation = exchange(continuation_m, nullptr);
+	}
+	done_m.notify_all();
+
+	for (auto& callback : callbacks)
+		deliver([callback = std::move(callback), value = value_m, error = error_m] { callback(value, error); });
+	if (continuation)
+		deliver([continuation] { continuation.resume(); });
+	return true;
+}
+
+
+
+/** A completion executor that has been destroyed has no thread left to run the task on, so it is dropped. */
+void AsyncEvaluation::state::deliver(Executor::task_type task) {
+	if (!has_completion_m)
+		task();
+	else if (auto executor = completion_m.lock())
+		executor->post(std::move(task));
+}
+
+
+
+bool AsyncEvaluation::ready() const {
+	lock_guard<mutex> lock(state_m->mutex_m);
+	return state_m->finished_m;
+}
+
+
+
+void AsyncEvaluation::wait() const {
+	unique_lock<mutex> lock(state_m->mutex_m);
+	state_m->done_m.wait(lock, [this] { return state_m->finished_m; });
+}
+
+
+
+AsyncEvaluation::result_type AsyncEvaluation::get() const {
+	wait();
+	if (state_m->error_m)
+		rethrow_exception(state_m->error_m);
+	return state_m->value_m;
+}
+
+
+
+void AsyncEvaluation::cancel() {
+	state_m->stop_m.request_stop();
+	state_m->complete(nullptr, make_exception_ptr(XEvaluationCancelled()));
+}
+
+
+
+void AsyncEvaluation::then(callback_type callback) {
+	{
+		lock_guard<mutex> lock(state_m->mutex_m);
+		if (!state_m->finished_m) {
+			state_m->callbacks_m.push_back(std::move(callback));
+			return;
+		}
+	}
+	state_m->deliver([callback = std::move(callback), value = state_m->value_m, error = state_m->error_m] { callback(value, error); });
+}
+
+
+
+bool AsyncEvaluation::await_suspend(coroutine_handle<> continuation) {
+	lock_guard<mutex> lock(state_m->mutex_m);
+	if (state_m->finished_m)
+		return false;		// completed meanwhile: resume straight away
+	state_m->continuation_m = continuation;
+	return true;
+}
@@ -0,0 +1,150 @@
+/*!	\file	batch_file.cpp
+	\brief	Batch file evaluation implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Results are formatted in the format allocation stage.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/batch_file.hpp>
+#include <ee/allocation_tracking.hpp>
+#include <ee/mapped_file.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+using namespace std;
+
+
+
+namespace {
+	size_t const block_lines = 64 * 1024;		// lines evaluated per evaluate_many() call
+	size_t const buffer_bytes = 4 * 1024 * 1024;
+
+	/*! Appends to a large buffer and writes it out only when full. */
+	class buffered_writer {
+		FILE*			file_m;
+		string			path_m;
+		vector<char>	buffer_m;
+		size_t			used_m = 0;
+	public:
+		explicit buffered_writer(string const& path) : file_m(nullptr), path_m(path), buffer_m(buffer_bytes) {
+#if defined(_WIN32)
+			if (fopen_s(&file_m, path.c_str(), "wb") != 0)
+				file_m = nullptr;
+#else
+			file_m = fopen(path.c_str(), "wb");
+#endif
+			if (!file_m)
+				throw runtime_error("Error: cannot create " + path);
+		}
+		~buffered_writer() {
+			if (file_m)
+				fclose(file_m);
+		}
+		buffered_writer(buffered_writer const&) = delete;
+		buffered_writer& operator = (buffered_writer const&) = delete;
+
+		void write(string_view text) {
+			if (text.size() > buffer_m.size() - used_m) {
+				flush();
+				if (text.size() > buffer_m.size()) {
+					_write(text.data(), text.size());
+					return;
+				}
+			}
+			memcpy(buffer_m.data() + used_m, text.data(), text.size());
+			used_m += text.size();
+		}
+		void put(char c) {
+			if (used_m == buffer_m.size())
+				flush();
+			buffer_m[used_m++] = c;
+		}
+		void flush() {
+			_write(buffer_m.data(), used_m);
+			used_m = 0;
+		}
+		void close() {
+			flush();
+			FILE* file = exchange(file_m, nullptr);
+			if (fclose(file) != 0)
+				throw runtime_error("Error: cannot write " + path_m);
+		}
+	private:
+		void _write(char const* data, size_t size) {
+			if (size > 0 && fwrite(data, 1, size, file_m) != size)
+				throw runtime_error("Error: cannot write " + path_m);
+		}
+	};
+}
+
+
+
+vector<string_view> split_lines(string_view text) {
+	vector<string_view> lines;
+	lines.reserve(count(text.begin(), text.end(), '\n') + 1);
+	while (!text.empty()) {
+		size_t end = text.find('\n');
+		string_view line = text.substr(0, end);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		lines.push_back(line);
+		if (end == string_view::npos)
+			break;
+		text.remove_prefix(end + 1);
+	}
+	return lines;
+}
+
+
+
+BatchReport evaluate_file(ExpressionEvaluator const& ee, string const& input, string const& output) {
+	auto start = chrono::steady_clock::now();
+	MappedFile file(input);
+	auto lines = split_lines(file.view());
+	buffered_writer out(output);
+
+	BatchReport report;
+	for (size_t first = 0; first < lines.size(); first += block_lines) {
+		span<string_view const> block(lines.data() + first, min(block_lines, lines.size() - first));
+		for (auto const& item : ee.evaluate_many(block)) {
+			if (!item.ok()) {
+				out.write(item.error);
+				++report.errors;
+			}
+			else if (item.value) {
+				AllocationStageScope formatting(AllocationStage::format);
+				out.write(item.value->str());
+			}
+			out.put('\n');
+		}
+	}
+	out.close();
+
+	report.expressions = lines.size();
+	report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return report;
+}
@@ -0,0 +1,209 @@
+/*!	\file	concurrent_evaluator.cpp
+	\brief	ConcurrentEvaluator class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/concurrent_evaluator.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+using namespace std;
+
+
+
+/*! One worker thread, its queue, and the evaluators only it touches.
+	Aligned so neighbouring workers' counters do not share a cache line. */
+struct alignas(64) ConcurrentEvaluator::worker {
+	mutex								mutex_m;
+	condition_variable					ready_m;
+	deque<job_type>						jobs_m;
+	bool								stopping_m = false;
+
+	atomic<size_t>						depth_m{ 0 };
+	atomic<size_t>						max_depth_m{ 0 };
+	atomic<uint64_t>					submitted_m{ 0 };
+	atomic<uint64_t>					completed_m{ 0 };
+	atomic<uint64_t>					failed_m{ 0 };
+
+	map<session_type, ExpressionEvaluator>	sessions_m;
+	ExpressionEvaluator					scratch_m;
+	thread								thread_m;
+};
+
+
+
+ConcurrentEvaluator::ConcurrentEvaluator(size_t threads, Environment::base_type base, shared_ptr<ExpressionCache> cache)
+	: base_m(std::move(base)), cache_m(std::move(cache)), start_m(chrono::steady_clock::now())
+{
+	if (threads == 0)
+		threads = max(1u, thread::hardware_concurrency());
+	for (size_t i = 0; i < threads; ++i) {
+		workers_m.push_back(make_unique<worker>());
+		workers_m.back()->scratch_m.set_expression_cache(cache_m);
+	}
+	for (auto& w : workers_m)
+		w->thread_m = thread([this, &target = *w] { _run(target); });
+}
+
+
+
+ConcurrentEvaluator::~ConcurrentEvaluator() {
+	for (auto& w : workers_m) {
+		lock_guard<mutex> lock(w->mutex_m);
+		w->stopping_m = true;
+		w->ready_m.notify_one();
+	}
+	for (auto& w : workers_m)
+		w->thread_m.join();
+}
+
+
+
+void ConcurrentEvaluator::_run(worker& w) {
+	for (;;) {
+		job_type job;
+		{
+			unique_lock<mutex> lock(w.mutex_m);
+			w.ready_m.wait(lock, [&w] { return w.stopping_m || !w.jobs_m.empty(); });
+			if (w.jobs_m.empty())
+				return;		// stopping, and the queue is drained
+			job = std::move(w.jobs_m.front());
+			w.jobs_m.pop_front();
+		}
+		w.depth_m.fetch_sub(1, memory_order_relaxed);
+		job();
+	}
+}
+
+
+
+void ConcurrentEvaluator::_post(size_t index, job_type job) {
+	worker& w = *workers_m[index];
+	size_t depth;
+	{
+		lock_guard<mutex> lock(w.mutex_m);
+		w.jobs_m.push_back(std::move(job));
+		depth = w.depth_m.fetch_add(1, memory_order_relaxed) + 1;
+	}
+	w.ready_m.notify_one();
+
+	size_t deepest = w.max_depth_m.load(memory_order_relaxed);
+	while (depth > deepest && !w.max_depth_m.compare_exchange_weak(deepest, depth, memory_order_relaxed))
+		;
+}
+
+
+
+ExpressionEvaluator& ConcurrentEvaluator::_session(session_type session) {
+	// only ever called on the session's own worker thread
+	auto& sessions = workers_m[_worker_for(session)]->sessions_m;
+	auto iter = sessions.find(session);
+	if (iter == sessions.end()) {
+		iter = sessions.try_emplace(session).first;
+		if (base_m)
+			iter->second.set_environment(Environment(base_m));
+		iter->second.set_expression_cache(cache_m);
+	}
+	return iter->second;
+}
+
+
+
+future<ConcurrentEvaluator::result_type> ConcurrentEvaluator::submit(session_type session, expression_type expr) {
+	size_t index = _worker_for(session);
+	worker& w = *workers_m[index];
+	packaged_task<result_type()> task([this, &w, session, expr = std::move(expr)] {
+		try {
+			result_type result = _session(session).evaluate(expr);
+			w.completed_m.fetch_add(1, memory_order_relaxed);
+			return result;
+		}
+		catch (...) {
+			w.failed_m.fetch_add(1, memory_order_relaxed);
+			w.completed_m.fetch_add(1, memory_order_relaxed);
+			throw;
+		}
+	});
+	auto result = task.get_future();
+	w.submitted_m.fetch_add(1, memory_order_relaxed);
+	_post(index, job_type(std::move(task)));
+	return result;
+}
+
+
+
+future<ConcurrentEvaluator::result_type> ConcurrentEvaluator::submit(expression_type expr) {
+	size_t index = 0;
+	for (size_t i = 1; i < workers_m.size(); ++i)
+		if (workers_m[i]->depth_m.load(memory_order_relaxed) < workers_m[index]->depth_m.load(memory_order_relaxed))
+			index = i;
+
+	worker& w = *workers_m[index];
+	packaged_task<result_type()> task([this, &w, expr = std::move(expr)] {
+		try {
+			w.scratch_m.set_environment(Environment(base_m));
+			w.scratch_m.history().clear();
+			result_type result = w.scratch_m.evaluate(expr);
+			w.completed_m.fetch_add(1, memory_order_relaxed);
+			return result;
+		}
+		catch (...) {
+			w.failed_m.fetch_add(1, memory_order_relaxed);
+			w.completed_m.fetch_add(1, memory_order_relaxed);
+			throw;
+		}
+	});
+	auto result = task.get_future();
+	w.submitted_m.fetch_add(1, memory_order_relaxed);
+	_post(index, job_type(std::move(task)));
+	return result;
+}
+
+
+
+void ConcurrentEvaluator::end_session(session_type session) {
+	size_t index = _worker_for(session);
+	_post(index, job_type([this, index, session] { workers_m[index]->sessions_m.erase(session); }));
+}
+
+
+
+ConcurrentEvaluator::statistics ConcurrentEvaluator::stats() const {
+	statistics result;
+	for (auto const& w : workers_m) {
+		size_t depth = w->depth_m.load(memory_order_relaxed);
+		result.submitted += w->submitted_m.load(memory_order_relaxed);
+		result.completed += w->completed_m.load(memory_order_relaxed);
+		result.failed += w->failed_m.load(memory_order_relaxed);
+		result.queue_depth += depth;
+		result.max_queue_depth = max(result.max_queue_depth, w->max_depth_m.load(memory_order_relaxed));
+		result.worker_queue_depth.push_back(depth);
+	}
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start_m).count();
+	return result;
+}
@@ -0,0 +1,383 @@
+/*!	\file	decimal.cpp
+	\brief	Decimal class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Implementation of the fixed_decimal value type, the Decimal class
+and the Integer/Decimal/Real mixed-type kernels.
+
+Products and quotients take a native 128-bit fast path when the
+operands are small enough that the scaled intermediate cannot
+overflow, and otherwise a 256-bit intermediate.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
+#include <ee/lazy_real.hpp>
+#include <ee/quad_double.hpp>
+#include <algorithm>
+#include <cctype>
+#include <ios>
+#include <stdexcept>
+using namespace std;
+
+
+
+namespace {
+	using raw_type = fixed_decimal::raw_type;
+	using wide_type = boost::multiprecision::int256_t;
+
+	constexpr unsigned long long ten18 = 1'000'000'000'000'000'000ull;
+
+	raw_type magnitude(raw_type x) {
+		return x < 0 ? raw_type(-x) : x;
+	}
+
+	/*! n / d rounded by 'mode'.  T is raw_type, wide_type or Integer::value_type. */
+	template <typename T>
+	T divide_rounded(T const& n, T const& d, RoundingMode mode) {
+		T q = n / d;
+		T r = n % d;
+		if (r == 0)
+			return q;
+
+		bool negative = (n < 0) != (d < 0);
+		T twice = r < 0 ? T(-r) : r;
+		twice *= 2;
+		T absd = d < 0 ? T(-d) : d;
+
+		bool away;
+		switch (mode) {
+		case RoundingMode::TowardZero:	away = false;			break;
+		case RoundingMode::Floor:		away = negative;		break;
+		case RoundingMode::Ceiling:		away = !negative;		break;
+		case RoundingMode::HalfUp:		away = twice >= absd;	break;
+		default:						away = twice > absd || (twice == absd && q % 2 != 0);	break;
+		}
+		if (away)
+			q += negative ? -1 : 1;
+		return q;
+	}
+
+	bool in_range(raw_type raw) {
+		return magnitude(raw) < fixed_decimal::limit();
+	}
+
+	bool narrow(wide_type const& w, fixed_decimal& result) {
+		wide_type const bound(fixed_decimal::limit());
+		if (w >= bound || w <= -bound)
+			return false;
+		result = fixed_decimal::from_raw(static_cast<raw_type>(w));
+		return true;
+	}
+}
+
+
+
+raw_type fixed_decimal::one() {
+	return raw_type(ten18);
+}
+
+
+
+raw_type fixed_decimal::limit() {
+	static raw_type const value = raw_type(ten18) * raw_type(10'000'000'000'000'000'000ull);
+	return value;
+}
+
+
+
+fixed_decimal fixed_decimal::from_raw(raw_type raw) {
+	fixed_decimal d;
+	d.raw_m = raw;
+	return d;
+}
+
+
+
+/** Parse [-]digits[.digits]; fractional digits beyond the 18th are rounded by 'mode'. */
+bool fixed_decimal::from_string(std::string const& digits, fixed_decimal& result, RoundingMode mode) {
+	std::string mantissa;
+	int fraction = 0;
+	bool point = false;
+	for (char c : digits) {
+		if (c == '.')
+			point = true;
+		else {
+			mantissa += c;
+			if (point && isdigit(static_cast<unsigned char>(c)))
+				++fraction;
+		}
+	}
+
+	// cpp_int would read a leading zero as octal
+	auto first = mantissa.find_first_not_of("+-0");
+	Integer::value_type n(first == std::string::npos ? "0" : mantissa.substr(first));
+	if (mantissa[0] == '-')
+		n = -n;
+	if (fraction > fraction_digits)
+		n = divide_rounded(n, Integer::value_type(pow(Integer::value_type(10), unsigned(fraction - fraction_digits))), mode);
+	else
+		n *= pow(Integer::value_type(10), unsigned(fraction_digits - fraction));
+
+	if (abs(n) >= Integer::value_type(limit()))
+		return false;
+	result = from_raw(static_cast<raw_type>(wide_type(n)));
+	return true;
+}
+
+
+
+/** Bounded by integer_digits rather than by a 64-bit intermediate, so the integers from 2^63 up to 10^19 fit too. */
+bool fixed_decimal::from_integer(Integer::value_type const& value, fixed_decimal& result) {
+	static Integer::value_type const bound = pow(Integer::value_type(10), unsigned(integer_digits));
+	if (abs(value) >= bound)
+		return false;
+	result = from_raw(static_cast<raw_type>(wide_type(value)) * one());
+	return true;
+}
+
+
+
+std::string fixed_decimal::to_string() const {
+	raw_type m = magnitude(raw_m);
+	std::string fraction = std::to_string(static_cast<unsigned long long>(m % one()));
+	std::string s = raw_m < 0 ? "-" : "";
+	s += std::to_string(static_cast<unsigned long long>(m / one()));
+	s += '.';
+	s.append(fraction_digits - fraction.size(), '0');
+	s += fraction;
+	return s;
+}
+
+
+
+Real::value_type fixed_decimal::to_real() const {
+	return Real::value_type(to_string());
+}
+
+
+
+bool fixed_decimal::add(fixed_decimal a, fixed_decimal b, fixed_decimal& result) {
+	// |a|, |b| < 10^37 so the sum cannot wrap
+	result.raw_m = a.raw_m + b.raw_m;
+	return in_range(result.raw_m);
+}
+
+
+
+bool fixed_decimal::subtract(fixed_decimal a, fixed_decimal b, fixed_decimal& result) {
+	result.raw_m = a.raw_m - b.raw_m;
+	return in_range(result.raw_m);
+}
+
+
+
+bool fixed_decimal::multiply(fixed_decimal a, fixed_decimal b, fixed_decimal& result, RoundingMode mode) {
+	// both below 2^63 (about 9.2 in value): the product fits in 127 bits
+	raw_type const small = raw_type(1) << 63;
+	if (magnitude(a.raw_m) < small && magnitude(b.raw_m) < small) {
+		result.raw_m = divide_rounded(raw_type(a.raw_m * b.raw_m), one(), mode);
+		return true;
+	}
+	return narrow(divide_rounded(wide_type(wide_type(a.raw_m) * wide_type(b.raw_m)), wide_type(one()), mode), result);
+}
+
+
+
+/** @throw std::domain_error on division by zero. */
+bool fixed_decimal::divide(fixed_decimal a, fixed_decimal b, fixed_decimal& result, RoundingMode mode) {
+	if (b.raw_m == 0)
+		throw domain_error("Error: division by zero");
+
+	// |a| < 10^19 units: the scaled dividend stays below 10^37
+	if (magnitude(a.raw_m) < raw_type(10'000'000'000'000'000'000ull)) {
+		result.raw_m = divide_rounded(raw_type(a.raw_m * one()), b.raw_m, mode);
+		return in_range(result.raw_m);
+	}
+	return narrow(divide_rounded(wide_type(wide_type(a.raw_m) * wide_type(one())), wide_type(b.raw_m), mode), result);
+}
+
+
+
+[[nodiscard]] Decimal::string_type Decimal::str() const {
+	return value_.to_string();
+}
+
+
+
+Operand::pointer_type make_decimal_literal(std::string const& digits, RoundingMode mode) {
+	fixed_decimal d;
+	if (fixed_decimal::from_string(digits, d, mode))
+		return make_operand<Decimal>(d);
+	return make_operand<Real>(Real::value_type(digits));
+}
+
+
+
+namespace {
+	bool as_decimal(Operand::pointer_type const& operand, fixed_decimal& result) {
+		if (is<Decimal>(operand)) {
+			result = value_of<Decimal>(operand);
+			return true;
+		}
+		return is<Integer>(operand) && fixed_decimal::from_integer(value_of<Integer>(operand), result);
+	}
+
+	/*! The approximate types, least to most precise.  A mix is computed in the most precise one present. */
+	enum class approximation { exact, double_double, quad_double, real, lazy };
+
+	approximation approximation_of(Operand::pointer_type const& operand) {
+		if (is<Decimal>(operand) || is<Integer>(operand))	return approximation::exact;
+		if (is<DoubleDouble>(operand))						return approximation::double_double;
+		if (is<QuadDouble>(operand))						return approximation::quad_double;
+		if (is<Real>(operand))								return approximation::real;
+		if (is<LazyReal>(operand))							return approximation::lazy;
+		throw domain_error("Error: operand is not a number");
+	}
+
+	/*! The operand as T.  Exact operands go through their decimal digits; a narrower approximation
+		through its limbs, which are exact in any wider type. */
+	template <typename T>
+	T as(Operand::pointer_type const& operand) {
+		if constexpr (std::is_same_v<T, Real::value_type>) {
+			if (is<Real>(operand))
+				return value_of<Real>(operand);
+			if (is<Decimal>(operand))
+				return value_of<Decimal>(operand).to_real();
+			if (is<Integer>(operand))
+				return Real::value_type(value_of<Integer>(operand));
+			if (is<DoubleDouble>(operand)) {
+				auto const& x = value_of<DoubleDouble>(operand);
+				return Real::value_type(x[0]) + Real::value_type(x[1]);
+			}
+			auto const& x = value_of<QuadDouble>(operand);
+			return Real::value_type(x[0]) + Real::value_type(x[1]) + Real::value_type(x[2]) + Real::value_type(x[3]);
+		}
+		else if constexpr (std::is_same_v<T, lazy_real>) {
+			if (is<LazyReal>(operand))
+				return value_of<LazyReal>(operand);
+			if (is<Integer>(operand))
+				return lazy_real(value_of<Integer>(operand));
+			if (is<Decimal>(operand))
+				return lazy_real(value_of<Decimal>(operand).to_string());
+			return lazy_real(as<Real::value_type>(operand).str(0, std::ios_base::scientific));
+		}
+		else {
+			if (is<Decimal>(operand))
+				return T(value_of<Decimal>(operand).to_string());
+			if (is<Integer>(operand))
+				return T(value_of<Integer>(operand).str());
+			if constexpr (std::is_same_v<T, qd_real>)
+				if (is<DoubleDouble>(operand)) {
+					auto const& x = value_of<DoubleDouble>(operand);
+					return qd_real::from_limbs({ x[0], x[1], 0.0, 0.0 });
+				}
+			return T(value_of<std::conditional_t<std::is_same_v<T, dd_real>, DoubleDouble, QuadDouble>>(operand));
+		}
+	}
+
+	/*! Applies 'op' to both operands converted to the value type of OperandType. */
+	template <typename OperandType, typename OP>
+	Operand::pointer_type approximate(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs, OP op) {
+		using T = typename OperandType::value_type;
+		return make_operand<OperandType>(T(op(as<T>(lhs), as<T>(rhs))));
+	}
+
+	/*! Decimal kernel when both sides convert and the result fits, otherwise the kernel of the most
+		precise approximation present: Real when both sides are exact. */
+	template <typename DECIMAL_OP, typename APPROXIMATE_OP>
+	Operand::pointer_type mixed(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs, DECIMAL_OP decimal_op, APPROXIMATE_OP approximate_op) {
+		fixed_decimal a, b, r;
+		if (as_decimal(lhs, a) && as_decimal(rhs, b) && decimal_op(a, b, r))
+			return make_operand<Decimal>(r);
+		switch (std::max(approximation_of(lhs), approximation_of(rhs))) {
+		case approximation::double_double:	return approximate<DoubleDouble>(lhs, rhs, approximate_op);
+		case approximation::quad_double:	return approximate<QuadDouble>(lhs, rhs, approximate_op);
+		case approximation::lazy:			return approximate<LazyReal>(lhs, rhs, approximate_op);
+		default:							return approximate<Real>(lhs, rhs, approximate_op);
+		}
+	}
+
+	bool is_zero(Real::value_type const& x)	{ return x.is_zero(); }
+	bool is_zero(dd_real const& x)			{ return x[0] == 0.0; }
+	bool is_zero(qd_real const& x)			{ return x[0] == 0.0; }
+	bool is_zero(lazy_real const&)			{ return false; }		// the lazy division reports it when evaluated
+
+	template <typename T>
+	int three_way(T const& x, T const& y) {
+		return x < y ? -1 : x > y ? 1 : 0;
+	}
+}
+
+
+
+Operand::pointer_type decimal_add(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs) {
+	return mixed(lhs, rhs,
+		[](fixed_decimal a, fixed_decimal b, fixed_decimal& r) { return fixed_decimal::add(a, b, r); },
+		[](auto const& a, auto const& b) { return a + b; });
+}
+
+
+
+Operand::pointer_type decimal_subtract(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs) {
+	return mixed(lhs, rhs,
+		[](fixed_decimal a, fixed_decimal b, fixed_decimal& r) { return fixed_decimal::subtract(a, b, r); },
+		[](auto const& a, auto const& b) { return a - b; });
+}
+
+
+
+Operand::pointer_type decimal_multiply(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs, RoundingMode mode) {
+	return mixed(lhs, rhs,
+		[mode](fixed_decimal a, fixed_decimal b, fixed_decimal& r) { return fixed_decimal::multiply(a, b, r, mode); },
+		[](auto const& a, auto const& b) { return a * b; });
+}
+
+
+
+/** @throw std::domain_error on division by zero. */
+Operand::pointer_type decimal_divide(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs, RoundingMode mode) {
+	return mixed(lhs, rhs,
+		[mode](fixed_decimal a, fixed_decimal b, fixed_decimal& r) { return fixed_decimal::divide(a, b, r, mode); },
+		[](auto const& a, auto const& b) {
+			if (is_zero(b))
+				throw domain_error("Error: division by zero");
+			return a / b;
+		});
+}
+
+
+
+int decimal_compare(Operand::pointer_type const& lhs, Operand::pointer_type const& rhs) {
+	fixed_decimal a, b;
+	if (as_decimal(lhs, a) && as_decimal(rhs, b))
+		return a < b ? -1 : a > b ? 1 : 0;
+	switch (std::max(approximation_of(lhs), approximation_of(rhs))) {
+	case approximation::double_double:	return three_way(as<dd_real>(lhs), as<dd_real>(rhs));
+	case approximation::quad_double:	return three_way(as<qd_real>(lhs), as<qd_real>(rhs));
+	case approximation::lazy:			return as<lazy_real>(lhs).compare(as<lazy_real>(rhs));
+	default:							return three_way(as<Real::value_type>(lhs), as<Real::value_type>(rhs));
+	}
+}
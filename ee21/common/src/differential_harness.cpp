@@ -0,0 +1,262 @@
+/*!	\file	differential_harness.cpp
+	\brief	DifferentialHarness implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/differential_harness.hpp>
+#include <ee/expression_evaluator.hpp>
+#include <cctype>
+#include <exception>
+#include <ostream>
+#include <string_view>
+using namespace std;
+
+
+
+namespace {
+	DifferentialHarness::outcome value_of(Token::pointer_type const& value) {
+		return { true, value ? value->str() : string() };
+	}
+
+	DifferentialHarness::outcome error_of(string message) {
+		return { false, std::move(message) };
+	}
+
+	bool is_word(char c) {
+		return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+	}
+
+	/*! Rejoins lexemes: one space between them, none inside parentheses, before a comma or after a function name. */
+	string join(vector<string> const& tokens) {
+		string text;
+		for (size_t i = 0; i < tokens.size(); ++i) {
+			bool const call = tokens[i] == "(" && i && isalpha(static_cast<unsigned char>(tokens[i - 1][0]));
+			if (i && text.back() != '(' && tokens[i] != ")" && tokens[i] != "," && !call)
+				text += ' ';
+			text += tokens[i];
+		}
+		return text;
+	}
+}
+
+
+
+DifferentialHarness::DifferentialHarness(setup_type setup)
+	: setup_m(std::move(setup))
+	, cache_m(make_shared<ExpressionCache>())
+	, exact_cache_m(make_shared<ExpressionCache>()) { }
+
+
+
+char const* DifferentialHarness::name(Path path) {
+	switch (path) {
+	case Path::evaluate:		return "evaluate";
+	case Path::try_evaluate:	return "try_evaluate";
+	case Path::cached:			return "cached";
+	case Path::cached_exact:	return "cached_exact";
+	case Path::batch:			return "batch";
+	case Path::async:			return "async";
+	case Path::pipeline:		return "pipeline";
+	}
+	return "?";
+}
+
+
+
+DifferentialHarness::outcomes DifferentialHarness::run(string const& expr) {
+	outcomes results;
+	for (size_t p = 0; p < path_count; ++p)
+		results[p] = _run(static_cast<Path>(p), expr);
+	return results;
+}
+
+
+
+/** Each path has a session of its own, so an expression that fails part-way leaves nothing behind for the next. */
+DifferentialHarness::outcome DifferentialHarness::_run(Path path, string const& expr) {
+	ExpressionEvaluator ee;
+	if (setup_m)
+		setup_m(ee);
+	try {
+		switch (path) {
+		case Path::evaluate:
+			return value_of(ee.evaluate(expr));
+		case Path::try_evaluate: {
+			auto result = ee.try_evaluate(expr);
+			return result ? value_of(result.value()) : error_of(result.error().message());
+		}
+		case Path::cached:
+		case Path::cached_exact:
+			ee.set_expression_cache(path == Path::cached ? cache_m : exact_cache_m);
+			ee.set_literal_parameters(path == Path::cached);
+			return value_of(ee.evaluate(expr));
+		case Path::batch: {
+			string_view const items[] = { expr };
+			auto const results = ee.evaluate_many(items);
+			return results[0].ok() ? value_of(results[0].value) : error_of(results[0].error);
+		}
+		case Path::async:
+			return value_of(ee.evaluate_async(expr).get());
+		case Path::pipeline: {
+			Tokenizer tokenizer;
+			tokenizer.set_environment(ee.environment().fork());
+			Parser parser;
+			RPNEvaluator rpn;
+			return value_of(rpn.evaluate(parser.parse(tokenizer.tokenize(expr))));
+		}
+		}
+	}
+	catch (char const* message) {		// the parser's and RPN evaluator's EvalError messages
+		return error_of(message);
+	}
+	catch (exception const& e) {
+		return error_of(e.what());
+	}
+	catch (...) {
+		return error_of("unknown exception");
+	}
+	return error_of("unknown path");
+}
+
+
+
+bool DifferentialHarness::agree(outcomes const& results) {
+	for (auto const& result : results)
+		if (!result.agrees(results[0]))
+			return false;
+	return true;
+}
+
+
+
+optional<DifferentialHarness::mismatch> DifferentialHarness::check(string const& expr) {
+	if (agree(run(expr)))
+		return nullopt;
+	mismatch m;
+	m.expression = expr;
+	m.minimized = minimize(expr);
+	m.results = run(m.minimized);
+	return m;
+}
+
+
+
+string DifferentialHarness::minimize(string const& expr, size_t max_runs) {
+	return minimize(expr, [this](string const& candidate) { return !agree(run(candidate)); }, max_runs);
+}
+
+
+
+/** Delta debugging over the lexemes: remove ever smaller chunks while the expression still fails,
+	then unwrap parenthesized groups one at a time, and repeat until neither makes progress. */
+string DifferentialHarness::minimize(string const& expr, function<bool(string const&)> const& fails, size_t max_runs) {
+	auto tokens = lexemes(expr);
+	size_t runs = max_runs;
+	auto const still_fails = [&](vector<string> const& candidate) {
+		if (runs == 0)
+			return false;
+		--runs;
+		return fails(join(candidate));
+	};
+	for (bool progress = true; progress && runs;) {
+		progress = false;
+
+		for (size_t n = 2; tokens.size() >= 2 && runs;) {
+			size_t const chunk = (tokens.size() + n - 1) / n;
+			bool reduced = false;
+			for (size_t start = 0; start < tokens.size() && !reduced; start += chunk) {
+				vector<string> candidate(tokens.begin(), tokens.begin() + start);
+				candidate.insert(candidate.end(), tokens.begin() + min(start + chunk, tokens.size()), tokens.end());
+				if (!candidate.empty() && still_fails(candidate)) {
+					tokens = std::move(candidate);
+					reduced = progress = true;
+				}
+			}
+			if (reduced)
+				n = max<size_t>(n - 1, 2);
+			else if (n >= tokens.size())
+				break;
+			else
+				n = min(n * 2, tokens.size());
+		}
+
+		for (size_t open = 0; open < tokens.size() && runs; ++open) {
+			if (tokens[open] != "(")
+				continue;
+			size_t close = open + 1;
+			for (size_t depth = 1; close < tokens.size(); ++close)
+				if (tokens[close] == "(")
+					++depth;
+				else if (tokens[close] == ")" && --depth == 0)
+					break;
+			if (close == tokens.size())
+				continue;
+			auto candidate = tokens;
+			candidate.erase(candidate.begin() + close);
+			candidate.erase(candidate.begin() + open);
+			if (still_fails(candidate)) {
+				tokens = std::move(candidate);
+				progress = true;
+				--open;		// the group's first token is now at 'open'
+			}
+		}
+	}
+	return join(tokens);
+}
+
+
+
+vector<string> DifferentialHarness::lexemes(string const& expr) {
+	static constexpr string_view pairs[] = { "**", "<=", ">=", "==", "!=" };
+	vector<string> result;
+	for (size_t i = 0; i < expr.size();) {
+		char const c = expr[i];
+		if (isspace(static_cast<unsigned char>(c))) {
+			++i;
+			continue;
+		}
+		size_t length = 1;
+		if (is_word(c))
+			while (i + length < expr.size() && is_word(expr[i + length]))
+				++length;
+		else
+			for (auto pair : pairs)
+				if (expr.compare(i, pair.size(), pair) == 0)
+					length = pair.size();
+		result.push_back(expr.substr(i, length));
+		i += length;
+	}
+	return result;
+}
+
+
+
+void DifferentialHarness::report(ostream& out, mismatch const& m) {
+	out << "expression: " << m.expression << '\n';
+	out << "minimized:  " << m.minimized << '\n';
+	for (size_t p = 0; p < path_count; ++p) {
+		auto const& result = m.results[p];
+		out << "  " << name(static_cast<Path>(p)) << ": " << (result.ok ? "= " : "error: ") << result.text << '\n';
+	}
+}
@@ -0,0 +1,378 @@
+/*!	\file	environment.cpp
+	\brief	Environment class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Added memory accounting, limits and LRU eviction.
+	Added try_variable() and try_enforce_limits().
+	Running byte total and recency index instead of recounting and scanning on each change.
+	Base variables are copied into the overlay when written, not when read.
+	Lookups hand out a private copy of a base variable, never the shared one.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/environment.hpp>
+#include <ee/boolean.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
+#include <ee/integer.hpp>
+#include <ee/lazy_real.hpp>
+#include <ee/quad_double.hpp>
+#include <ee/real.hpp>
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+
+
+size_t operand_bytes(Operand::pointer_type const& value) {
+	if (!value)
+		return 0;
+	if (is<Integer>(value))
+		return sizeof(Integer) + value_of<Integer>(value).backend().size() * sizeof(boost::multiprecision::limb_type);
+	if (is<Real>(value))		return sizeof(Real);		// cpp_dec_float keeps its digits inline
+	if (is<Decimal>(value))		return sizeof(Decimal);
+	if (is<DoubleDouble>(value))	return sizeof(DoubleDouble);
+	if (is<QuadDouble>(value))	return sizeof(QuadDouble);
+	if (is<LazyReal>(value))	return sizeof(LazyReal) + value_of<LazyReal>(value).bytes();		// the pending expression and its caches
+	if (is<Boolean>(value))		return sizeof(Boolean);
+	return sizeof(Operand);
+}
+
+
+
+shared_ptr<Variable const> Environment::_find_in_base(string_type const& name) const {
+	for (layer const* l = base_m.get(); l; l = l->parent.get()) {
+		auto iter = l->variables.find(name);
+		if (iter != l->variables.end())
+			return iter->second;
+	}
+	return nullptr;
+}
+
+
+
+/** Copy-on-write: a base variable is copied into the overlay here, where it may be changed, and
+	the session's copy is measured again at the next settle.  A copy already lent by try_variable()
+	is the one adopted, so the token lists holding it see the change. */
+Variable::pointer_type Environment::variable(string_type const& name) {
+	_settle();
+	auto iter = overlay_m.find(name);
+	if (iter == overlay_m.end()) {
+		auto lent = borrowed_m.find(name);
+		Variable::pointer_type created;
+		if (lent != borrowed_m.end())
+			created = lent->second.copy;
+		else if (auto shared = _find_in_base(name))
+			created = shared->copy();
+		else
+			created = convert<Variable>(make<Variable>());
+		iter = _create(name, created);
+		if (iter == overlay_m.end())
+			throw length_error("Error: variable '" + name + "' exceeds the session's variable limits");
+		if (lent != borrowed_m.end())
+			borrowed_m.erase(lent);
+	}
+	usage& u = usage_m.find(name)->second;
+	if (!u.pending) {
+		u.pending = true;
+		pending_m.push_back(name);
+	}
+	_use(name, u);
+	return iter->second;
+}
+
+
+
+/** A base variable is lent as a private copy sharing the base's value, so an assignment through a
+	token cannot reach the shared layer; the copy costs the session nothing until it is changed,
+	when the next settle moves it into the overlay.  Only a name found nowhere becomes a session variable. */
+Variable::pointer_type Environment::try_variable(string_type const& name) {
+	auto iter = overlay_m.find(name);
+	if (iter != overlay_m.end()) {
+		_use(name, usage_m.find(name)->second);
+		return iter->second;
+	}
+
+	auto lent = borrowed_m.find(name);
+	if (lent == borrowed_m.end())
+		if (auto shared = _find_in_base(name))
+			lent = borrowed_m.emplace(name, borrowed{ shared->copy(), std::move(shared) }).first;
+	if (lent != borrowed_m.end()) {
+		if (!lent->second.lent) {
+			lent->second.lent = true;
+			lent_m.push_back(name);
+		}
+		return lent->second.copy;
+	}
+
+	iter = _create(name, convert<Variable>(make<Variable>()));
+	if (iter == overlay_m.end())
+		return nullptr;
+	_use(name, usage_m.find(name)->second);
+	return iter->second;
+}
+
+
+
+Environment::dictionary_type::iterator Environment::_create(string_type const& name, Variable::pointer_type const& created) {
+	_settle();
+	size_t count = overlay_m.size() + 1;
+	size_t total = bytes_m + (created->is_bound() ? 0 : operand_bytes(created->value()));
+	if ((count > limits_m.max_count || total > limits_m.max_bytes) &&
+		(limits_m.policy == VariablePolicy::Reject || !_make_room(count, total, name)))
+		return overlay_m.end();
+	auto iter = overlay_m.emplace(name, created).first;
+	_measure(usage_m[name], *created);
+	return iter;
+}
+
+
+
+void Environment::assign(string_type const& name, Operand::pointer_type const& value) {
+	_settle();
+	auto iter = overlay_m.find(name);
+	bool is_new = iter == overlay_m.end();
+	size_t count = overlay_m.size() + is_new;
+	size_t total = bytes_m + operand_bytes(value);
+	if (!is_new)
+		total -= usage_m[name].bytes;
+
+	if ((count > limits_m.max_count || total > limits_m.max_bytes) &&
+		(limits_m.policy == VariablePolicy::Reject || !_make_room(count, total, name)))
+		throw length_error("Error: assigning '" + name + "' exceeds the session's variable limits");
+
+	if (is_new) {
+		auto lent = borrowed_m.find(name);
+		if (lent != borrowed_m.end()) {
+			iter = overlay_m.emplace(name, lent->second.copy).first;
+			borrowed_m.erase(lent);
+		}
+		else
+			iter = overlay_m.emplace(name, convert<Variable>(make<Variable>())).first;
+	}
+	iter->second->set(value);
+	usage& u = usage_m[name];
+	_measure(u, *iter->second);
+	_use(name, u);
+}
+
+
+
+Operand::pointer_type Environment::value(string_type const& name) const {
+	auto iter = overlay_m.find(name);
+	if (iter != overlay_m.end())
+		return iter->second->value();
+	auto lent = borrowed_m.find(name);
+	if (lent != borrowed_m.end())
+		return lent->second.copy->value();
+	auto shared = _find_in_base(name);
+	return shared ? shared->value() : nullptr;
+}
+
+
+
+bool Environment::contains(string_type const& name) const {
+	return overlay_m.count(name) || _find_in_base(name);
+}
+
+
+
+Environment::base_type Environment::snapshot() const {
+	auto frozen = make_shared<layer>();
+	for (auto const& [name, variable] : overlay_m)
+		frozen->variables.emplace(name, variable->freeze());		// a binding is read now, once
+	for (auto const& name : lent_m) {
+		auto lent = borrowed_m.find(name);
+		if (lent != borrowed_m.end() && lent->second.changed())		// written through a token since the last settle
+			frozen->variables.emplace(name, lent->second.copy->freeze());
+	}
+	if (frozen->variables.empty())
+		return base_m;
+	frozen->parent = base_m;
+	return frozen;
+}
+
+
+
+vector<Environment::string_type> Environment::names() const {
+	vector<string_type> result;
+	for (auto const& entry : overlay_m)
+		result.push_back(entry.first);
+	for (layer const* l = base_m.get(); l; l = l->parent.get())
+		for (auto const& entry : l->variables)
+			result.push_back(entry.first);
+	sort(result.begin(), result.end());
+	result.erase(unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+
+
+vector<Environment::variable_info> Environment::list() const {
+	vector<variable_info> result;
+	for (auto const& [name, variable] : overlay_m)
+		result.push_back({ name, variable->is_bound() ? 0 : operand_bytes(variable->value()) });
+	return result;
+}
+
+
+
+/** The running total, corrected for the variables handed out since it was last settled. */
+size_t Environment::bytes() const {
+	size_t total = bytes_m;
+	for (auto const& name : pending_m) {
+		auto variable = overlay_m.find(name);
+		total -= usage_m.find(name)->second.bytes;
+		total += variable->second->is_bound() ? 0 : operand_bytes(variable->second->value());
+	}
+	for (auto const& name : lent_m) {
+		auto lent = borrowed_m.find(name);
+		if (lent != borrowed_m.end() && lent->second.changed() && !lent->second.copy->is_bound())
+			total += operand_bytes(lent->second.copy->value());
+	}
+	return total;
+}
+
+
+
+bool Environment::drop(string_type const& name) {
+	auto variable = overlay_m.find(name);
+	if (variable == overlay_m.end())
+		return false;
+	_forget(variable);
+	return true;
+}
+
+
+
+void Environment::set_limits(VariableLimits limits) {
+	VariableLimits previous = limits_m;
+	limits_m = limits;
+	try {
+		enforce_limits();
+	}
+	catch (length_error const&) {
+		limits_m = previous;
+		throw;
+	}
+}
+
+
+
+void Environment::enforce_limits() {
+	if (!try_enforce_limits())
+		throw length_error("Error: session variables exceed their limits");
+}
+
+
+
+bool Environment::try_enforce_limits() {
+	_settle();
+	size_t count = overlay_m.size();
+	size_t total = bytes_m;
+	if (count <= limits_m.max_count && total <= limits_m.max_bytes)
+		return true;
+	if (limits_m.policy == VariablePolicy::Reject)
+		return false;
+	_make_room(count, total, string_type());
+	return true;
+}
+
+
+
+/** Victims come from the least recently used end of the recency index; 'total' must be settled. */
+bool Environment::_make_room(size_t count, size_t total, string_type const& keep) {
+	auto victim = recency_m.begin();
+	while (count > limits_m.max_count || total > limits_m.max_bytes) {
+		if (victim != recency_m.end() && victim->second == keep)
+			++victim;
+		if (victim == recency_m.end())
+			return false;
+
+		auto const variable = overlay_m.find(victim->second);
+		++victim;		// _forget() removes the current entry
+		total -= usage_m.find(variable->first)->second.bytes;
+		--count;
+		_forget(variable);
+	}
+	return true;
+}
+
+
+
+void Environment::_use(string_type const& name, usage& u) {
+	if (u.last_use) {
+		auto entry = recency_m.extract(u.last_use);		// re-keyed in place: no allocation
+		entry.key() = ++clock_m;
+		recency_m.insert(recency_m.end(), std::move(entry));
+	}
+	else
+		recency_m.emplace_hint(recency_m.end(), ++clock_m, name);
+	u.last_use = clock_m;
+}
+
+
+
+void Environment::_measure(usage& u, Variable const& variable) {
+	size_t const now = variable.is_bound() ? 0 : operand_bytes(variable.value());
+	bytes_m = bytes_m - u.bytes + now;
+	u.bytes = now;
+}
+
+
+
+void Environment::_settle() {
+	for (auto const& name : pending_m) {
+		usage& u = usage_m.find(name)->second;
+		_measure(u, *overlay_m.find(name)->second);
+		u.pending = false;
+	}
+	pending_m.clear();
+
+	for (auto const& name : lent_m) {
+		auto lent = borrowed_m.find(name);
+		if (lent == borrowed_m.end())
+			continue;
+		if (!lent->second.changed()) {
+			lent->second.lent = false;
+			continue;
+		}
+		auto iter = overlay_m.emplace(name, lent->second.copy).first;
+		usage& u = usage_m[name];
+		_measure(u, *iter->second);
+		_use(name, u);
+		borrowed_m.erase(lent);
+	}
+	lent_m.clear();
+}
+
+
+
+void Environment::_forget(dictionary_type::iterator variable) {
+	auto u = usage_m.find(variable->first);
+	if (u->second.pending)
+		pending_m.erase(find(pending_m.begin(), pending_m.end(), variable->first));
+	bytes_m -= u->second.bytes;
+	recency_m.erase(u->second.last_use);
+	usage_m.erase(u);
+	overlay_m.erase(variable);
+}
@@ -0,0 +1,491 @@
+/*!	\file	eval_server.cpp
+	\brief	Evaluation server and client implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Invalid expressions are answered through try_evaluate().
+	Results are formatted in the format allocation stage.
+	Reading pauses while a connection has more than max_outbox bytes unsent.
+	A half-closed connection is answered before it is closed.
+	Reading also pauses while max_in_flight requests are unanswered.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/eval_server.hpp>
+
+#if defined(__linux__)
+
+#include <ee/allocation_tracking.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+
+
+namespace {
+	void put_u32(string& out, uint32_t value) {
+		for (int i = 0; i < 4; ++i)
+			out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+	}
+
+	uint32_t get_u32(char const* in) {
+		uint32_t value = 0;
+		for (int i = 0; i < 4; ++i)
+			value |= uint32_t(static_cast<unsigned char>(in[i])) << (8 * i);
+		return value;
+	}
+
+	void append_frame(string& out, string_view payload) {
+		put_u32(out, static_cast<uint32_t>(payload.size()));
+		out.append(payload);
+	}
+
+	sockaddr_un socket_address(string const& path) {
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (path.size() >= sizeof address.sun_path)
+			throw runtime_error("Error: socket path too long: " + path);
+		memcpy(address.sun_path, path.c_str(), path.size() + 1);
+		return address;
+	}
+
+	[[noreturn]] void fail(string const& what) {
+		throw runtime_error("Error: " + what + ": " + strerror(errno));
+	}
+}
+
+
+
+struct EvalServer::connection {
+	int							fd_m;
+	ConcurrentEvaluator::session_type	id_m;
+	string						inbox_m;		// epoll thread only: bytes read, not yet framed
+	string						sending_m;		// epoll thread only: bytes being written
+	size_t						sent_m = 0;
+	uint32_t					events_m = EPOLLIN;		// epoll thread only: the events registered
+	bool						eof_m = false;			// epoll thread only: the client has sent its last request
+	mutex						mutex_m;
+	string						outbox_m;		// responses appended by the workers
+	size_t						in_flight_m = 0;		// requests submitted and not yet answered
+	atomic<bool>				closed_m{ false };
+
+	connection(int fd, ConcurrentEvaluator::session_type id) : fd_m(fd), id_m(id) { }
+};
+
+
+
+EvalServer::EvalServer(string path, size_t threads, Environment::base_type base)
+	: path_m(std::move(path))
+	, evaluator_m(make_unique<ConcurrentEvaluator>(threads, std::move(base)))
+{
+	auto address = socket_address(path_m);
+	listen_m = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (listen_m < 0)
+		fail("socket");
+	unlink(path_m.c_str());
+	if (bind(listen_m, reinterpret_cast<sockaddr const*>(&address), sizeof address) != 0 || listen(listen_m, SOMAXCONN) != 0) {
+		close(listen_m);
+		fail("cannot listen on " + path_m);
+	}
+
+	epoll_m = epoll_create1(EPOLL_CLOEXEC);
+	wake_m = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (epoll_m < 0 || wake_m < 0)
+		fail("epoll");
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = listen_m;
+	epoll_ctl(epoll_m, EPOLL_CTL_ADD, listen_m, &event);
+	event.data.fd = wake_m;
+	epoll_ctl(epoll_m, EPOLL_CTL_ADD, wake_m, &event);
+}
+
+
+
+EvalServer::~EvalServer() {
+	stop();
+	if (thread_m.joinable())
+		thread_m.join();
+	evaluator_m.reset();		// finish the queued work while the eventfd is still open
+
+	for (auto& entry : connections_m)
+		close(entry.first);
+	close(listen_m);
+	close(epoll_m);
+	close(wake_m);
+	unlink(path_m.c_str());
+}
+
+
+
+void EvalServer::stop() {
+	stopping_m = true;
+	_wake();
+}
+
+
+
+void EvalServer::_wake() {
+	uint64_t one = 1;
+	(void)!write(wake_m, &one, sizeof one);
+}
+
+
+
+void EvalServer::run() {
+	epoll_event events[64];
+	while (!stopping_m) {
+		int n = epoll_wait(epoll_m, events, 64, -1);
+		if (n < 0 && errno != EINTR)
+			fail("epoll_wait");
+		for (int i = 0; i < n; ++i) {
+			int fd = events[i].data.fd;
+			if (fd == listen_m) {
+				_accept();
+			}
+			else if (fd == wake_m) {
+				uint64_t count;
+				(void)!read(wake_m, &count, sizeof count);
+				vector<shared_ptr<connection>> ready;
+				{
+					lock_guard<mutex> lock(ready_mutex_m);
+					ready.swap(ready_m);
+				}
+				for (auto& c : ready)
+					if (!c->closed_m)
+						_flush(c);
+			}
+			else if (auto iter = connections_m.find(fd); iter != connections_m.end()) {
+				auto c = iter->second;
+				if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+					_close(c);		// nowhere left to send replies
+					continue;
+				}
+				if (events[i].events & EPOLLIN)
+					_read(c);
+				if (!c->closed_m && (events[i].events & EPOLLOUT))
+					_flush(c);
+			}
+		}
+	}
+}
+
+
+
+void EvalServer::_accept() {
+	for (;;) {
+		int fd = accept4(listen_m, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0)
+			return;
+		auto c = make_shared<connection>(fd, next_id_m++);
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.fd = fd;
+		epoll_ctl(epoll_m, EPOLL_CTL_ADD, fd, &event);
+		connections_m.emplace(fd, c);
+	}
+}
+
+
+
+void EvalServer::_read(shared_ptr<connection> const& c) {
+	// at most one frame's worth is held unframed; the rest waits in the socket
+	char buffer[64 * 1024];
+	while (c->inbox_m.size() < 4 + max_frame) {
+		ssize_t got = read(c->fd_m, buffer, sizeof buffer);
+		if (got > 0) {
+			c->inbox_m.append(buffer, static_cast<size_t>(got));
+			continue;
+		}
+		if (got == 0) {
+			c->eof_m = true;		// half-closed: answer what was sent, then close
+			break;
+		}
+		if (errno == EINTR)
+			continue;
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			break;
+		_close(c);
+		return;
+	}
+	_flush(c);		// submits the complete frames and decides whether to keep reading
+}
+
+
+
+/** Every complete frame is a request; they are queued in order on the connection's session
+	until 'in_flight' reaches max_in_flight.  Returns the new count. */
+size_t EvalServer::_frame(shared_ptr<connection> const& c, size_t in_flight) {
+	size_t at = 0;
+	while (in_flight < max_in_flight && c->inbox_m.size() - at >= 4) {
+		uint32_t length = get_u32(c->inbox_m.data() + at);
+		if (length > max_frame) {
+			_close(c);
+			return in_flight;
+		}
+		if (c->inbox_m.size() - at - 4 < length)
+			break;
+		_submit(c, c->inbox_m.substr(at + 4, length));
+		at += 4 + length;
+		++in_flight;
+	}
+	c->inbox_m.erase(0, at);
+	return in_flight;
+}
+
+
+
+void EvalServer::_submit(shared_ptr<connection> const& c, string expr) {
+	{
+		lock_guard<mutex> lock(c->mutex_m);
+		++c->in_flight_m;
+	}
+	(void)evaluator_m->with_session(c->id_m, [this, c, expr = std::move(expr)](ExpressionEvaluator& ee) {
+		string payload(1, '\0');
+		try {
+			auto result = ee.try_evaluate(expr);
+			if (!result)
+				payload.assign(1, '\1').append(result.error().message());
+			else if (*result) {
+				AllocationStageScope formatting(AllocationStage::format);
+				payload += (*result)->str();
+			}
+		}
+		catch (exception const& e) {
+			payload.assign(1, '\1').append(e.what());
+		}
+		catch (...) {
+			payload.assign(1, '\1').append("Error: evaluation failed");
+		}
+
+		bool first;
+		{
+			lock_guard<mutex> lock(c->mutex_m);
+			first = c->outbox_m.empty();
+			append_frame(c->outbox_m, payload);
+			--c->in_flight_m;
+		}
+		if (first) {
+			{
+				lock_guard<mutex> lock(ready_mutex_m);
+				ready_m.push_back(c);
+			}
+			_wake();
+		}
+	});
+}
+
+
+
+void EvalServer::_flush(shared_ptr<connection> const& c) {
+	if (c->sent_m == c->sending_m.size()) {
+		c->sending_m.clear();
+		c->sent_m = 0;
+	}
+	size_t in_flight;
+	{
+		lock_guard<mutex> lock(c->mutex_m);
+		c->sending_m += c->outbox_m;
+		c->outbox_m.clear();
+		in_flight = c->in_flight_m;
+	}
+	in_flight = _frame(c, in_flight);
+	if (c->closed_m)
+		return;
+
+	while (c->sent_m < c->sending_m.size()) {
+		ssize_t put = ::send(c->fd_m, c->sending_m.data() + c->sent_m, c->sending_m.size() - c->sent_m, MSG_NOSIGNAL);
+		if (put > 0) {
+			c->sent_m += static_cast<size_t>(put);
+			continue;
+		}
+		if (put < 0 && errno == EINTR)
+			continue;
+		if (put < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		_close(c);
+		return;
+	}
+
+	// ask for EPOLLOUT only while the socket is backed up, and stop reading requests while too many
+	// are waiting to be answered or too much to be sent
+	size_t const unsent = c->sending_m.size() - c->sent_m;
+	if (c->eof_m && in_flight == 0 && unsent == 0) {
+		_close(c);		// every request the client sent is answered
+		return;
+	}
+	bool const reading = !c->eof_m && in_flight < max_in_flight && unsent < max_outbox;
+	uint32_t const events = (reading ? static_cast<uint32_t>(EPOLLIN) : uint32_t(0))
+		| (unsent ? static_cast<uint32_t>(EPOLLOUT) : uint32_t(0));
+	if (events != c->events_m) {
+		epoll_event event{};
+		event.events = events;
+		event.data.fd = c->fd_m;
+		epoll_ctl(epoll_m, EPOLL_CTL_MOD, c->fd_m, &event);
+		c->events_m = events;
+	}
+}
+
+
+
+void EvalServer::_close(shared_ptr<connection> const& c) {
+	if (c->closed_m.exchange(true))
+		return;
+	epoll_ctl(epoll_m, EPOLL_CTL_DEL, c->fd_m, nullptr);
+	close(c->fd_m);
+	connections_m.erase(c->fd_m);
+	evaluator_m->end_session(c->id_m);
+}
+
+
+
+EvalClient::EvalClient(string const& path) {
+	auto address = socket_address(path);
+	fd_m = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd_m < 0)
+		fail("socket");
+	if (connect(fd_m, reinterpret_cast<sockaddr const*>(&address), sizeof address) != 0) {
+		close(fd_m);
+		fail("cannot connect to " + path);
+	}
+}
+
+
+
+EvalClient::~EvalClient() {
+	close(fd_m);
+}
+
+
+
+void EvalClient::send(string_view expr) {
+	string frame;
+	append_frame(frame, expr);
+	for (size_t at = 0; at < frame.size(); ) {
+		ssize_t put = ::send(fd_m, frame.data() + at, frame.size() - at, MSG_NOSIGNAL);
+		if (put < 0 && errno == EINTR)
+			continue;
+		if (put <= 0)
+			fail("send");
+		at += static_cast<size_t>(put);
+	}
+}
+
+
+
+void EvalClient::finish() {
+	if (shutdown(fd_m, SHUT_WR) != 0)
+		fail("shutdown");
+}
+
+
+
+EvalClient::reply EvalClient::receive() {
+	char chunk[64 * 1024];
+	for (;;) {
+		if (buffer_m.size() >= 4) {
+			uint32_t length = get_u32(buffer_m.data());
+			if (buffer_m.size() - 4 >= length && length >= 1) {
+				reply result{ buffer_m[4] == '\0', buffer_m.substr(5, length - 1) };
+				buffer_m.erase(0, 4 + length);
+				return result;
+			}
+		}
+		ssize_t got = read(fd_m, chunk, sizeof chunk);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			throw runtime_error("Error: connection to the server was lost");
+		buffer_m.append(chunk, static_cast<size_t>(got));
+	}
+}
+
+
+
+LoadReport run_load(string const& path, string const& expr, size_t connections, size_t requests, size_t pipeline) {
+	using clock = chrono::steady_clock;
+	pipeline = max<size_t>(pipeline, 1);
+	vector<vector<double>> latencies(connections);
+	vector<size_t> errors(connections);
+	vector<exception_ptr> failures(connections);
+
+	auto drive = [&](size_t i) {
+		EvalClient client(path);
+		deque<clock::time_point> in_flight;
+		latencies[i].reserve(requests);
+		for (size_t sent = 0, received = 0; received < requests; ) {
+			while (sent < requests && in_flight.size() < pipeline) {
+				in_flight.push_back(clock::now());
+				client.send(expr);
+				++sent;
+			}
+			if (!client.receive().ok)
+				++errors[i];
+			latencies[i].push_back(chrono::duration<double, micro>(clock::now() - in_flight.front()).count());
+			in_flight.pop_front();
+			++received;
+		}
+	};
+
+	auto start = clock::now();
+	vector<thread> clients;
+	for (size_t i = 0; i < connections; ++i)
+		clients.emplace_back([&, i] {
+			try { drive(i); }
+			catch (...) { failures[i] = current_exception(); }
+		});
+	for (auto& t : clients)
+		t.join();
+	for (auto& failure : failures)
+		if (failure)
+			rethrow_exception(failure);
+
+	LoadReport report;
+	report.seconds = chrono::duration<double>(clock::now() - start).count();
+	vector<double> all;
+	for (size_t i = 0; i < connections; ++i) {
+		all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+		report.errors += errors[i];
+	}
+	report.requests = all.size();
+	if (!all.empty()) {
+		auto percentile = [&all](double p) {
+			auto at = all.begin() + static_cast<ptrdiff_t>(p * (all.size() - 1));
+			nth_element(all.begin(), at, all.end());
+			return *at;
+		};
+		report.p50_us = percentile(0.50);
+		report.p99_us = percentile(0.99);
+	}
+	return report;
+}
+
+#endif // __linux__
@@ -0,0 +1,135 @@
+/*!	\file	evaluation_limits.cpp
+	\brief	EvaluationBudget implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/evaluation_limits.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
+#include <ee/environment.hpp>
+#include <ee/function.hpp>
+#include <ee/lazy_real.hpp>
+#include <ee/operator.hpp>
+#include <ee/quad_double.hpp>
+#include <ee/real.hpp>
+#include <ee/variable.hpp>
+#include <cmath>
+#include <numbers>
+using namespace std;
+
+
+
+namespace {
+	/*! The operand a stacked token stands for: a Variable's value, or the token itself. */
+	Operand::pointer_type operand_of(Token::pointer_type const& token) {
+		if (is<Variable>(token))
+			return convert<Variable>(token)->value();
+		return is<Operand>(token) ? convert<Operand>(token) : nullptr;
+	}
+
+	/*! log2(|n|) for |n| >= 1. */
+	double log2_magnitude(Integer::value_type const& n) {
+		Integer::value_type const magnitude = abs(n);
+		auto const high = msb(magnitude);
+		if (high < 1000)
+			return log2(magnitude.convert_to<double>());
+		return static_cast<double>(high);		// within one bit of the truth
+	}
+}
+
+
+
+optional<EvalErrc> EvaluationBudget::admit(Token::pointer_type const& token) {
+	auto operand = operand_of(token);
+	if (!operand)
+		return nullopt;		// an unassigned variable holds nothing yet
+
+	if (is<Integer>(operand)) {
+		auto const value = value_of<Integer>(operand);
+		if (value != 0 && msb(abs(value)) + 1 > limits_m.max_integer_bits)
+			return EvalErrc::integer_limit;
+	}
+	if (precision_digits(operand) > limits_m.max_real_digits)
+		return EvalErrc::precision_limit;
+
+	bytes_m += operand_bytes(operand);
+	if (bytes_m > limits_m.max_intermediate_bytes)
+		return EvalErrc::memory_limit;
+	return nullopt;
+}
+
+
+
+optional<EvalErrc> EvaluationBudget::admit(Operation const& operation, span<Token::pointer_type const> args) {
+	if ((is<Power>(&operation) || is<Pow>(&operation)) && args.size() == 2) {
+		auto base = operand_of(args[0]), exponent = operand_of(args[1]);
+		if (is<Integer>(base) && is<Integer>(exponent))
+			return _charge(power_bits(value_of<Integer>(base), value_of<Integer>(exponent)));
+	}
+	else if (is<Factorial>(&operation) && args.size() == 1) {
+		auto n = operand_of(args[0]);
+		if (is<Integer>(n))
+			return _charge(factorial_bits(value_of<Integer>(n)));
+	}
+	return nullopt;
+}
+
+
+
+optional<EvalErrc> EvaluationBudget::_charge(double bits) {
+	if (!(bits <= static_cast<double>(limits_m.max_integer_bits)))
+		return EvalErrc::integer_limit;
+	bytes_m += sizeof(Integer) + static_cast<size_t>(bits / 8);
+	if (bytes_m > limits_m.max_intermediate_bytes)
+		return EvalErrc::memory_limit;
+	return nullopt;
+}
+
+
+
+/** A negative exponent or a base of magnitude 0 or 1 gives a result of at most one bit. */
+double EvaluationBudget::power_bits(Integer::value_type const& base, Integer::value_type const& exponent) {
+	if (exponent <= 0 || abs(base) <= 1)
+		return 1;
+	return log2_magnitude(base) * exponent.convert_to<double>() + 1;
+}
+
+
+
+/** log2(n!) from the log-gamma function; a negative n is left to the factorial to reject. */
+double EvaluationBudget::factorial_bits(Integer::value_type const& n) {
+	if (n < 2)
+		return 1;
+	return lgamma(n.convert_to<double>() + 1) / numbers::ln2 + 1;
+}
+
+
+
+size_t EvaluationBudget::precision_digits(Operand::pointer_type const& operand) {
+	if (is<Real>(operand) || is<LazyReal>(operand))		return numeric_limits<Real::value_type>::digits10;		// LazyReal is capped at Real's precision
+	if (is<DoubleDouble>(operand))	return DoubleDouble::value_type::digits10;
+	if (is<QuadDouble>(operand))	return QuadDouble::value_type::digits10;
+	if (is<Decimal>(operand))		return fixed_decimal::integer_digits + fixed_decimal::fraction_digits;
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*!	\file	evaluation_metrics.cpp
+	\brief	Histogram and EvaluationMetrics implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/evaluation_metrics.hpp>
+#include <ee/boolean.hpp>
+#include <ee/evaluation_limits.hpp>
+#include <ee/integer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+using namespace std;
+
+
+
+void Histogram::record(uint64_t value) {
+	++buckets_m[bit_width(value)];
+	++count_m;
+	sum_m += value;
+	min_m = std::min(min_m, value);
+	max_m = std::max(max_m, value);
+}
+
+
+
+void Histogram::merge(Histogram const& other) {
+	for (size_t b = 0; b < bucket_count; ++b)
+		buckets_m[b] += other.buckets_m[b];
+	count_m += other.count_m;
+	sum_m += other.sum_m;
+	min_m = std::min(min_m, other.min_m);
+	max_m = std::max(max_m, other.max_m);
+}
+
+
+
+uint64_t Histogram::percentile(double q) const {
+	if (count_m == 0)
+		return 0;
+	uint64_t const rank = std::max<uint64_t>(1, static_cast<uint64_t>(ceil(clamp(q, 0.0, 1.0) * double(count_m))));
+	uint64_t seen = 0;
+	for (size_t b = 0; b < bucket_count; ++b)
+		if ((seen += buckets_m[b]) >= rank) {
+			uint64_t const top = b == 0 ? 0 : b == bucket_count - 1 ? numeric_limits<uint64_t>::max() : (uint64_t(1) << b) - 1;
+			return std::min(top, max_m);
+		}
+	return max_m;
+}
+
+
+
+void EvaluationMetrics::record(EvaluationSample const& sample) {
+	auto add = [&](Measure measure, uint64_t value) { histograms_m[static_cast<size_t>(measure)].record(value); };
+	add(Measure::tokenize_ns, sample.tokenize_ns);
+	add(Measure::parse_ns, sample.parse_ns);
+	add(Measure::evaluate_ns, sample.evaluate_ns);
+	add(Measure::total_ns, sample.tokenize_ns + sample.parse_ns + sample.evaluate_ns);
+	add(Measure::infix_tokens, sample.infix_tokens);
+	add(Measure::postfix_tokens, sample.postfix_tokens);
+	add(Measure::max_stack_depth, sample.max_stack_depth);
+	add(Measure::allocations, sample.allocations);
+	add(Measure::result_digits, sample.result_digits);
+
+	++evaluations_m;
+	failures_m += !sample.ok;
+	cached_m += sample.cached;
+	last_m = sample;
+}
+
+
+
+void EvaluationMetrics::merge(EvaluationMetrics const& other) {
+	for (size_t m = 0; m < measure_count; ++m)
+		histograms_m[m].merge(other.histograms_m[m]);
+	evaluations_m += other.evaluations_m;
+	failures_m += other.failures_m;
+	cached_m += other.cached_m;
+	if (other.evaluations_m)
+		last_m = other.last_m;
+}
+
+
+
+void EvaluationMetrics::report(ostream& out) const {
+	char line[160];
+	snprintf(line, sizeof line, "evaluations %llu, failures %llu, cached %llu\n",
+		static_cast<unsigned long long>(evaluations_m), static_cast<unsigned long long>(failures_m), static_cast<unsigned long long>(cached_m));
+	out << line;
+	snprintf(line, sizeof line, "%-16s %12s %12s %12s %12s %12s %12s\n", "measure", "mean", "min", "p50", "p90", "p99", "max");
+	out << line;
+	for (size_t m = 0; m < measure_count; ++m) {
+		Histogram const& h = histograms_m[m];
+		snprintf(line, sizeof line, "%-16s %12.1f %12llu %12llu %12llu %12llu %12llu\n", name(static_cast<Measure>(m)), h.mean(),
+			static_cast<unsigned long long>(h.min()), static_cast<unsigned long long>(h.percentile(0.5)), static_cast<unsigned long long>(h.percentile(0.9)),
+			static_cast<unsigned long long>(h.percentile(0.99)), static_cast<unsigned long long>(h.max()));
+		out << line;
+	}
+}
+
+
+
+char const* EvaluationMetrics::name(Measure measure) {
+	switch (measure) {
+	case Measure::tokenize_ns:		return "tokenize_ns";
+	case Measure::parse_ns:			return "parse_ns";
+	case Measure::evaluate_ns:		return "evaluate_ns";
+	case Measure::total_ns:			return "total_ns";
+	case Measure::infix_tokens:		return "infix_tokens";
+	case Measure::postfix_tokens:	return "postfix_tokens";
+	case Measure::max_stack_depth:	return "max_stack_depth";
+	case Measure::allocations:		return "allocations";
+	case Measure::result_digits:	return "result_digits";
+	}
+	return "unknown";
+}
+
+
+
+namespace {
+	atomic<EvaluationMetrics::allocation_counter_type> installed_counter{ nullptr };
+}
+
+void EvaluationMetrics::set_allocation_counter(allocation_counter_type counter) {
+	installed_counter.store(counter, memory_order_release);
+}
+
+EvaluationMetrics::allocation_counter_type EvaluationMetrics::allocation_counter() {
+	return installed_counter.load(memory_order_acquire);
+}
+
+uint64_t EvaluationMetrics::allocations_now() {
+	auto counter = installed_counter.load(memory_order_acquire);
+	return counter ? counter() : 0;
+}
+
+
+
+/** An Integer's digits are exact below 2^64 and otherwise within one of the truth. */
+uint64_t EvaluationMetrics::result_digits(Token::pointer_type const& result) {
+	if (!result)
+		return 0;
+	if (is<Boolean>(result))
+		return 1;
+	if (is<Integer>(result)) {
+		Integer::value_type const magnitude = abs(value_of<Integer>(result));
+		if (magnitude == 0)
+			return 1;
+		auto const high = msb(magnitude);
+		if (high < 64) {
+			uint64_t n = magnitude.convert_to<uint64_t>(), digits = 0;
+			for (; n; n /= 10)
+				++digits;
+			return digits;
+		}
+		return static_cast<uint64_t>(double(high) * log10(2.0)) + 1;
+	}
+	return is<Operand>(result) ? EvaluationBudget::precision_digits(convert<Operand>(result)) : 0;
+}
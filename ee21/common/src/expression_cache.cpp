@@ -0,0 +1,268 @@
+/*!	\file	expression_cache.cpp
+	\brief	CompiledExpression and ExpressionCache implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Plans with literal slots.
+	Added try_bind().
+	Variable slots are named from the tokenizer's VariableNames rather than found in the session.
+	Plans keep the source map of their postfix tokens.
+	bytes() charges every literal the plan holds.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/expression_cache.hpp>
+#include <ee/variable.hpp>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+using namespace std;
+
+
+
+/** The names come from the tokenizer rather than the session, which may already have evicted
+	an earlier variable of the same expression to stay within its limits. */
+CompiledExpression::CompiledExpression(TokenList postfix, VariableNames const& names) : postfix_m(std::move(postfix)) {
+	unordered_map<Token const*, string_type const*> name_of;
+	for (auto const& [token, name] : names)
+		name_of.emplace(token, &name);
+	for (size_t i = 0; i < postfix_m.size(); ++i) {
+		if (!is<Variable>(postfix_m[i]))
+			continue;
+		auto named = name_of.find(postfix_m[i].get());
+		if (named == name_of.end())
+			throw logic_error("Error: a compiled variable was not named by the tokenizer");
+		slots_m.emplace_back(i, *named->second);
+		postfix_m[i] = nullptr;
+	}
+}
+
+
+
+CompiledExpression::CompiledExpression(TokenList postfix, VariableNames const& names, TokenList const& infix, ParameterizedExpression const& parameters)
+	: CompiledExpression(std::move(postfix), names) {
+	if (infix.size() != parameters.tokens)
+		throw logic_error("Error: the parameterized text does not match the tokens");
+
+	// every literal token is made afresh by the tokenizer, so identity finds its place in the postfix
+	unordered_map<Token const*, size_t> literal_number;
+	for (size_t i = 0; i < parameters.literal_tokens.size(); ++i)
+		literal_number.emplace(infix[parameters.literal_tokens[i]].get(), i);
+	for (size_t i = 0; i < postfix_m.size(); ++i)
+		if (auto found = literal_number.find(postfix_m[i].get()); postfix_m[i] && found != literal_number.end()) {
+			literals_m.emplace_back(i, found->second);
+			postfix_m[i] = nullptr;
+		}
+	if (literals_m.size() != literal_number.size())
+		throw logic_error("Error: a literal is missing from the parsed expression");
+}
+
+
+
+void CompiledExpression::set_source_map(vector<uint32_t> origins, vector<uint32_t> offsets) {
+	origins_m = std::move(origins);
+	offsets_m = std::move(offsets);
+}
+
+
+
+TokenList CompiledExpression::bind(Environment& environment, span<string_view const> literals, RealBackend backend) const {
+	auto tokens = try_bind(environment, literals, backend);
+	if (!tokens)
+		throw length_error(tokens.error().message());
+	return std::move(*tokens);
+}
+
+
+
+EvalExpected<TokenList> CompiledExpression::try_bind(Environment& environment, span<string_view const> literals, RealBackend backend) const {
+	if (!literals_m.empty() && literals.size() != literals_m.size())
+		throw invalid_argument("Error: wrong number of literals for the compiled expression");
+
+	TokenList tokens(postfix_m);
+	for (auto const& [index, name] : slots_m)
+		if (!(tokens[index] = environment.try_variable(name)))
+			return eval_failure(EvalErrc::variable_limit);
+	for (auto const& [index, number] : literals_m)
+		tokens[index] = Tokenizer::number(literals[number], backend);
+	return tokens;
+}
+
+
+
+size_t CompiledExpression::bytes() const {
+	size_t total = sizeof(*this) + postfix_m.capacity() * sizeof(Token::pointer_type)
+		+ slots_m.capacity() * sizeof(slots_m[0]) + literals_m.capacity() * sizeof(literals_m[0])
+		+ (origins_m.capacity() + offsets_m.capacity()) * sizeof(uint32_t);
+	// every operand the plan holds is charged, even while the compiling tokens still share it;
+	// operators are the tokenizer's shared instances and cost the plan only its pointer
+	for (auto const& token : postfix_m)
+		if (is<Operand>(token))
+			total += operand_bytes(convert<Operand>(token));
+		else if (token && token.use_count() == 1)
+			total += sizeof(Token);
+	for (auto const& slot : slots_m)
+		total += slot.second.capacity();
+	return total;
+}
+
+
+
+namespace {
+	struct cache_key {
+		string_view	text;
+		RealBackend	backend;
+		bool operator == (cache_key const&) const = default;
+	};
+
+	struct cache_key_hash {
+		size_t operator () (cache_key const& key) const {
+			return hash<string_view>()(key.text) ^ (static_cast<size_t>(key.backend) * 0x9e3779b97f4a7c15ull);
+		}
+	};
+}
+
+
+
+/*! One lock stripe.  The index keys are views of the texts owned by the list entries.
+	Aligned so neighbouring shards' locks and counters do not share a cache line. */
+struct alignas(64) ExpressionCache::shard {
+	struct entry {
+		string		text;
+		RealBackend	backend;
+		plan_type	plan;
+		size_t		bytes;
+	};
+
+	mutable mutex											mutex_m;
+	list<entry>												lru_m;		// most recently used first
+	unordered_map<cache_key, list<entry>::iterator, cache_key_hash>	index_m;
+	size_t													bytes_m = 0;
+	size_t													capacity_m = 0;
+
+	atomic<uint64_t>										hits_m{ 0 };
+	atomic<uint64_t>										misses_m{ 0 };
+	atomic<uint64_t>										insertions_m{ 0 };
+	atomic<uint64_t>										evictions_m{ 0 };
+
+	void evict_until_fits(size_t bytes) {
+		while (!lru_m.empty() && bytes_m + bytes > capacity_m) {
+			auto& victim = lru_m.back();
+			index_m.erase(cache_key{ victim.text, victim.backend });
+			bytes_m -= victim.bytes;
+			lru_m.pop_back();
+			evictions_m.fetch_add(1, memory_order_relaxed);
+		}
+	}
+};
+
+
+
+ExpressionCache::ExpressionCache(size_t capacity, size_t shards) {
+	shards = max<size_t>(shards, 1);
+	for (size_t i = 0; i < shards; ++i) {
+		shards_m.push_back(make_unique<shard>());
+		shards_m.back()->capacity_m = capacity / shards;
+	}
+}
+
+
+
+ExpressionCache::~ExpressionCache() = default;
+
+
+
+ExpressionCache::plan_type ExpressionCache::find(string_view text, RealBackend backend) {
+	cache_key key{ text, backend };
+	size_t const hash = cache_key_hash()(key);
+	shard& s = _shard_for(hash);
+
+	lock_guard<mutex> lock(s.mutex_m);
+	auto iter = s.index_m.find(key);
+	if (iter == s.index_m.end()) {
+		s.misses_m.fetch_add(1, memory_order_relaxed);
+		return nullptr;
+	}
+	s.lru_m.splice(s.lru_m.begin(), s.lru_m, iter->second);
+	s.hits_m.fetch_add(1, memory_order_relaxed);
+	return iter->second->plan;
+}
+
+
+
+ExpressionCache::plan_type ExpressionCache::insert(string_view text, RealBackend backend, CompiledExpression plan) {
+	size_t const bytes = plan.bytes() + sizeof(shard::entry) + text.size() + 4 * sizeof(void*);		// + list and index nodes
+	auto shared = make_shared<CompiledExpression const>(std::move(plan));
+	cache_key key{ text, backend };
+	size_t const hash = cache_key_hash()(key);
+	shard& s = _shard_for(hash);
+	if (bytes > s.capacity_m)
+		return shared;
+
+	lock_guard<mutex> lock(s.mutex_m);
+	if (auto iter = s.index_m.find(key); iter != s.index_m.end())
+		return iter->second->plan;
+	s.evict_until_fits(bytes);
+	s.lru_m.push_front(shard::entry{ string(text), backend, shared, bytes });
+	s.index_m.emplace(cache_key{ s.lru_m.front().text, backend }, s.lru_m.begin());
+	s.bytes_m += bytes;
+	s.insertions_m.fetch_add(1, memory_order_relaxed);
+	return shared;
+}
+
+
+
+void ExpressionCache::clear() {
+	for (auto& s : shards_m) {
+		lock_guard<mutex> lock(s->mutex_m);
+		s->index_m.clear();
+		s->lru_m.clear();
+		s->bytes_m = 0;
+	}
+}
+
+
+
+ExpressionCache::statistics ExpressionCache::stats() const {
+	statistics result;
+	for (auto& s : shards_m) {
+		result.hits += s->hits_m.load(memory_order_relaxed);
+		result.misses += s->misses_m.load(memory_order_relaxed);
+		result.insertions += s->insertions_m.load(memory_order_relaxed);
+		result.evictions += s->evictions_m.load(memory_order_relaxed);
+		lock_guard<mutex> lock(s->mutex_m);
+		result.entries += s->lru_m.size();
+		result.bytes += s->bytes_m;
+	}
+	return result;
+}
+
+
+
+size_t ExpressionCache::capacity() const {
+	size_t total = 0;
+	for (auto& s : shards_m)
+		total += s->capacity_m;
+	return total;
+}
@@ -8,6 +8,24 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Evaluated results are recorded in the result history.
+	Variable limits are enforced after each evaluation.
+	Added evaluate_many().
+	Added evaluate_async().
+	Parsed expressions can be shared through an ExpressionCache.
+	Cached plans are keyed by the parameterized text, with the literals bound per call.
+	Added try_evaluate().
+	Batches and asynchronous evaluations keep the session's EvaluationLimits.
+	Runtime EvaluationMetrics replace the SHOW_STEPS dumps.
+	Operations can be profiled, optionally by source offset.
+	Allocations are charged to the tokenize, parse and evaluate stages of each evaluation.
+	Batch items are evaluated with try_evaluate(), so malformed items keep their diagnostic.
+	Cached plans name their variables from the tokenizer's record, not the session.
+	Scratch evaluators release the caller's variables and cache when an evaluation throws, too.
+	Cached plans carry their source map, so a failing cached evaluation is not compiled again.
+	evaluate() is try_evaluate() with the error thrown, so the cache is looked up in one place.
+
 Version 2021.11.01
 	C++ 20 validated
 
@@ -32,30 +50,377 @@ the program(s) have been supplied.
 #include <ee/parser.hpp>
 #include <ee/RPNEvaluator.hpp>
 #include <ee/function.hpp>
+#include <ee/thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+
+
+namespace {
+	using metrics_clock = std::chrono::steady_clock;
+
+	std::uint64_t nanoseconds_since(metrics_clock::time_point start) {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(metrics_clock::now() - start).count());
+	}
+}
+
+
+
+void ExpressionEvaluator::set_metrics(bool on) {
+	if (!on)
+		metrics_m.reset();
+	else if (!metrics_m)
+		metrics_m = std::make_unique<EvaluationMetrics>();
+}
+
+
+
+void ExpressionEvaluator::set_operation_profiler(std::shared_ptr<OperationProfiler> profiler) {
+	profiler_m = std::move(profiler);
+	rpn_m.set_profiler(profiler_m.get());
+}
+
+
+
+void ExpressionEvaluator::_profile_offsets(std::span<std::uint32_t const> origins, std::span<std::uint32_t const> offsets, std::size_t size) {
+	profile_offsets_m.clear();
+	if (origins.size() == size)
+		for (auto origin : origins)
+			profile_offsets_m.push_back(origin < offsets.size() ? offsets[origin] : EvalError::no_offset);
+	profiler_m->set_offsets(profile_offsets_m);
+}
+
+
+
+void ExpressionEvaluator::_record_sample(std::uint64_t allocations, result_type const& result) {
+	sample_m->allocations = EvaluationMetrics::allocations_now() - allocations;
+	sample_m->result_digits = EvaluationMetrics::result_digits(result);
+	metrics_m->record(*sample_m);
+	sample_m = nullptr;
+}
+
 
-#if defined(SHOW_STEPS)
-#include <iostream>
-#endif
 
 [[nodiscard]] ExpressionEvaluator::result_type ExpressionEvaluator::evaluate( ExpressionEvaluator::expression_type const& expr ) {
-	TokenList infixTokens = tokenizer_m.tokenize(expr);
-#if defined(SHOW_STEPS)
-	{ using namespace std;
-	cout << "Lexer output" << endl;
-	copy(infixTokens.begin(), infixTokens.end(), ostream_iterator<Token::pointer_type>(cout, " "));
-	std::cout << std::endl;
-	}
-#endif
-
-	TokenList postfixTokens = parser_m.parse(infixTokens);
-#if defined(SHOW_STEPS)
-	{ using namespace std;
-	cout << "Parser output" << endl;
-	copy(postfixTokens.begin(), postfixTokens.end(), ostream_iterator<Token::pointer_type>(cout, " "));
-	std::cout << std::endl;
-	}
-#endif
-
-	Operand::pointer_type result = rpn_m.evaluate(postfixTokens);
-	return result;
+	AllocationTracker::EvaluationScope tracked(last_allocations_m);
+	if (!metrics_m)
+		return _evaluate(expr);
+
+	EvaluationSample sample;
+	sample_m = &sample;
+	std::uint64_t const allocations = EvaluationMetrics::allocations_now();
+	try {
+		result_type result = _evaluate(expr);
+		_record_sample(allocations, result);
+		return result;
+	}
+	catch (...) {
+		sample.ok = false;
+		_record_sample(allocations, nullptr);
+		throw;
+	}
+}
+
+
+
+/** The throwing interface over _try_evaluate(): each error becomes the exception that the tokenizer,
+	parser, RPN evaluator or environment throws for it. */
+ExpressionEvaluator::result_type ExpressionEvaluator::_evaluate(ExpressionEvaluator::expression_type const& expr) {
+	auto result = _try_evaluate(expr);
+	if (result)
+		return std::move(*result);
+
+	EvalError const error = result.error();
+	switch (error.code) {
+	case EvalErrc::bad_character:
+		throw Tokenizer::XBadCharacter(expr, error.offset);
+	case EvalErrc::variable_limit:
+		if (error.offset < expr.size()) {		// the tokenizer names the variable it could not create
+			auto first = expr.cbegin() + error.offset;
+			auto last = std::find_if(first, expr.cend(), [](char c) { return !isalnum(static_cast<unsigned char>(c)); });
+			throw std::length_error("Error: variable '" + expression_type(first, last) + "' exceeds the session's variable limits");
+		}
+		throw std::length_error(error.message());
+	default:
+		throw error.message();
+	}
+}
+
+
+
+[[nodiscard]] EvalExpected<ExpressionEvaluator::result_type> ExpressionEvaluator::try_evaluate(ExpressionEvaluator::expression_type const& expr) {
+	AllocationTracker::EvaluationScope tracked(last_allocations_m);
+	if (!metrics_m)
+		return _try_evaluate(expr);
+
+	EvaluationSample sample;
+	sample_m = &sample;
+	std::uint64_t const allocations = EvaluationMetrics::allocations_now();
+	try {
+		auto result = _try_evaluate(expr);
+		sample.ok = result.has_value();
+		_record_sample(allocations, result ? *result : nullptr);
+		return result;
+	}
+	catch (...) {
+		sample.ok = false;
+		_record_sample(allocations, nullptr);
+		throw;
+	}
+}
+
+
+
+EvalExpected<ExpressionEvaluator::result_type> ExpressionEvaluator::_try_evaluate(ExpressionEvaluator::expression_type const& expr) {
+	AllocationStageScope stage(AllocationStage::evaluate);		// _try_compile() marks its own stages
+	if (sample_m)
+		sample_m->cached = cache_m != nullptr;
+	bool const spans = profiler_m && profiler_m->spans();
+	if (spans) {
+		offsets_m.clear();
+		origins_m.clear();
+	}
+	EvalExpected<TokenList> postfixTokens;
+	ExpressionCache::plan_type plan;						// holds the source map while it is in use
+	std::span<std::uint32_t const> origins, offsets;		// the source map of postfixTokens
+	bool const parameterized = cache_m && literal_parameters_m && Tokenizer::parameterize(expr, parameterized_m);
+	bool const cached = parameterized || (cache_m && !literal_parameters_m);
+	if (cached) {
+		std::string_view const key = parameterized ? std::string_view(parameterized_m.text) : std::string_view(expr);
+		plan = cache_m->find(key, real_backend());
+		if (!plan) {
+			TokenList infixTokens;
+			auto compiled = _try_compile(expr, &infixTokens);
+			if (!compiled)
+				return eval_failure(compiled.error());
+			CompiledExpression compiledPlan = parameterized
+				? CompiledExpression(std::move(*compiled), variable_names_m, infixTokens, parameterized_m)
+				: CompiledExpression(std::move(*compiled), variable_names_m);
+			compiledPlan.set_source_map(origins_m, parameterized ? std::vector<std::uint32_t>() : offsets_m);
+			plan = cache_m->insert(key, real_backend(), std::move(compiledPlan));
+		}
+		postfixTokens = parameterized ? plan->try_bind(environment(), parameterized_m.literals, real_backend()) : plan->try_bind(environment());
+		origins = plan->origins();
+		offsets = parameterized ? std::span<std::uint32_t const>(parameterized_m.offsets) : std::span<std::uint32_t const>(plan->offsets());
+	}
+	else {
+		postfixTokens = _try_compile(expr);		// also where an expression parameterize() rejects gets its error
+		origins = origins_m;
+		offsets = offsets_m;
+	}
+	if (!postfixTokens)
+		return eval_failure(postfixTokens.error());
+
+	metrics_clock::time_point start;
+	if (sample_m) {
+		sample_m->postfix_tokens = static_cast<std::uint32_t>(postfixTokens->size());
+		start = metrics_clock::now();
+	}
+	if (spans)
+		_profile_offsets(origins, offsets, postfixTokens->size());
+	auto result = rpn_m.try_evaluate(*postfixTokens);
+	if (spans)
+		profiler_m->set_offsets({});
+	if (sample_m) {
+		sample_m->evaluate_ns = nanoseconds_since(start);
+		sample_m->max_stack_depth = static_cast<std::uint32_t>(rpn_m.max_depth());
+	}
+	if (!result)
+		return eval_failure(result.error().code, _source_offset(origins, offsets, result.error().offset));
+	if (!tokenizer_m.environment().try_enforce_limits())
+		return eval_failure(EvalErrc::variable_limit);
+	if (*result)
+		history_m.push(*result);
+	return result_type(*result);
+}
+
+
+
+EvalExpected<TokenList> ExpressionEvaluator::_try_compile(ExpressionEvaluator::expression_type const& expr, TokenList* infix) {
+	offsets_m.clear();
+	origins_m.clear();
+	_name_variables();
+	AllocationStageScope tokenizing(AllocationStage::tokenize);
+	metrics_clock::time_point start;
+	if (sample_m)
+		start = metrics_clock::now();
+	auto infixTokens = tokenizer_m.try_tokenize(expr, &offsets_m);
+	if (sample_m)
+		sample_m->tokenize_ns = nanoseconds_since(start);
+	if (!infixTokens)
+		return eval_failure(infixTokens.error());
+	if (sample_m) {
+		sample_m->infix_tokens = static_cast<std::uint32_t>(infixTokens->size());
+		sample_m->cached = false;
+		start = metrics_clock::now();
+	}
+
+	AllocationStageScope parsing(AllocationStage::parse);
+	auto postfixTokens = parser_m.try_parse(*infixTokens, &origins_m);
+	if (sample_m)
+		sample_m->parse_ns = nanoseconds_since(start);
+	if (!postfixTokens)
+		return eval_failure(postfixTokens.error().code, offsets_m[postfixTokens.error().offset]);
+
+	if (infix)
+		*infix = std::move(*infixTokens);
+	return postfixTokens;
+}
+
+
+
+void ExpressionEvaluator::_name_variables() {
+	variable_names_m.clear();
+	tokenizer_m.session().variable_names = cache_m ? &variable_names_m : nullptr;
+}
+
+
+
+std::uint32_t ExpressionEvaluator::_source_offset(std::span<std::uint32_t const> origins, std::span<std::uint32_t const> offsets, std::uint32_t postfix_index) {
+	if (postfix_index >= origins.size() || origins[postfix_index] >= offsets.size())
+		return EvalError::no_offset;
+	return offsets[origins[postfix_index]];
+}
+
+
+
+namespace {
+	/*! A batch in flight.  Shared with the pool's helpers so that a helper starting after the
+		batch has finished finds nothing left to claim and never touches the caller's data. */
+	struct batch_state {
+		std::span<std::string_view const>					exprs;
+		std::vector<ExpressionEvaluator::BatchResult>*		results = nullptr;
+		Environment::base_type								base;
+		RealBackend											backend = RealBackend::Multiprecision;
+		std::shared_ptr<ExpressionCache>					cache;
+		EvaluationLimits									limits;
+		std::size_t											chunk = 1;
+		std::atomic<std::size_t>							next{ 0 };
+		std::atomic<std::size_t>							done{ 0 };
+		std::mutex											mutex;
+		std::condition_variable								finished;
+	};
+
+	/*! This thread's scratch evaluator, reset to a frozen session.  Its tokenizer, parser and
+		evaluator state is reused by every batch and asynchronous evaluation run on the thread. */
+	ExpressionEvaluator& scratch_evaluator(Environment::base_type const& base, RealBackend backend, std::shared_ptr<ExpressionCache> const& cache, EvaluationLimits const& limits) {
+		thread_local ExpressionEvaluator scratch;
+		if (scratch.history().capacity() != 0)
+			scratch.set_history_capacity(0);
+		scratch.set_real_backend(backend);
+		scratch.set_evaluation_limits(limits);
+		if (scratch.expression_cache() != cache)
+			scratch.set_expression_cache(cache);
+		if (!scratch.environment().overlay().empty() || scratch.environment().base() != base)
+			scratch.set_environment(Environment(base));
+		return scratch;
+	}
+
+	/*! Releases the scratch evaluator's hold on a batch's or task's variables and cache however the work ends. */
+	class scratch_release {
+		ExpressionEvaluator&	scratch_m;
+	public:
+		explicit scratch_release(ExpressionEvaluator& scratch) : scratch_m(scratch) { }
+		scratch_release(scratch_release const&) = delete;
+		scratch_release& operator = (scratch_release const&) = delete;
+		~scratch_release() {
+			scratch_m.set_environment(Environment());
+			scratch_m.set_expression_cache(nullptr);
+		}
+	};
+
+	void run_batch(batch_state& batch) {
+		ExpressionEvaluator& scratch = scratch_evaluator(batch.base, batch.backend, batch.cache, batch.limits);
+		scratch_release release(scratch);		// do not keep the batch's variables alive
+
+		std::size_t const n = batch.exprs.size();
+		for (;;) {
+			std::size_t first = batch.next.fetch_add(batch.chunk);
+			if (first >= n)
+				break;
+			std::size_t last = std::min(n, first + batch.chunk);
+			for (std::size_t i = first; i < last; ++i) {
+				auto& out = (*batch.results)[i];
+				try {
+					scratch_evaluator(batch.base, batch.backend, batch.cache, batch.limits);
+					auto result = scratch.try_evaluate(ExpressionEvaluator::expression_type(batch.exprs[i]));
+					if (result)
+						out.value = std::move(*result);
+					else
+						out.error = result.error().message();
+				}
+				catch (std::exception const& e) {
+					out.error = *e.what() ? e.what() : "Error: evaluation failed";
+				}
+				catch (...) {
+					out.error = "Error: evaluation failed";
+				}
+			}
+			if (batch.done.fetch_add(last - first) + (last - first) == n) {
+				std::lock_guard<std::mutex> lock(batch.mutex);
+				batch.finished.notify_all();
+			}
+		}
+	}
+}
+
+
+
+std::vector<ExpressionEvaluator::BatchResult> ExpressionEvaluator::evaluate_many(std::span<std::string_view const> exprs) const {
+	std::vector<BatchResult> results(exprs.size());
+	if (exprs.empty())
+		return results;
+
+	ThreadPool& pool = ThreadPool::shared();
+	auto batch = std::make_shared<batch_state>();
+	batch->exprs = exprs;
+	batch->results = &results;
+	batch->base = environment().snapshot();
+	batch->backend = real_backend();
+	batch->cache = cache_m;
+	batch->limits = evaluation_limits();
+	batch->chunk = std::clamp<std::size_t>(exprs.size() / (pool.size() * 8), 1, 1024);
+
+	// the calling thread works too, so a batch submitted from inside the pool still completes
+	std::size_t chunks = (exprs.size() + batch->chunk - 1) / batch->chunk;
+	std::size_t helpers = std::min(pool.size(), chunks - 1);
+	for (std::size_t i = 0; i < helpers; ++i)
+		pool.post([batch] { run_batch(*batch); });
+	run_batch(*batch);
+
+	std::unique_lock<std::mutex> lock(batch->mutex);
+	batch->finished.wait(lock, [&] { return batch->done.load() == exprs.size(); });
+	return results;
+}
+
+
+
+AsyncEvaluation ExpressionEvaluator::evaluate_async(expression_type expr, Executor& executor, std::shared_ptr<Executor> const& completion) const {
+	auto shared = std::make_shared<AsyncEvaluation::state>();
+	shared->completion_m = completion;
+	shared->has_completion_m = completion != nullptr;
+	executor.post([shared, expr = std::move(expr), base = environment().snapshot(), backend = real_backend(), cache = cache_m, limits = evaluation_limits()] {
+		if (shared->stop_m.stop_requested())
+			return;
+		try {
+			result_type result;
+			{
+				ExpressionEvaluator& scratch = scratch_evaluator(base, backend, cache, limits);
+				scratch_release release(scratch);
+				result = scratch.evaluate(expr);
+			}
+			shared->complete(result, nullptr);
+		}
+		catch (...) {
+			shared->complete(nullptr, std::current_exception());
+		}
+	});
+	return AsyncEvaluation(shared);
 }
@@ -0,0 +1,287 @@
+/*!	\file	expression_generator.cpp
+	\brief	ExpressionGenerator implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/expression_generator.hpp>
+#include <algorithm>
+#include <cctype>
+#include <span>
+using namespace std;
+
+
+
+namespace {
+	using Type = ExpressionGenerator::Type;
+
+	enum class Form : uint8_t { prefix, infix, postfix, function };
+
+	/*! One way to make a value of some type.  'small' operands are literal exponents or factorial arguments. */
+	struct operation {
+		char const*	text;
+		bool		keyword;		// written in a random case, like the tokenizer accepts
+		Form		form;
+		unsigned	arity;
+		Type		args[2];
+		bool		small = false;	// the last operand is a small integer literal
+	};
+
+	constexpr Type I = Type::integer, R = Type::real, B = Type::boolean;
+
+	operation const integer_operations[] = {
+		{ "+", false, Form::infix, 2, { I, I } },
+		{ "-", false, Form::infix, 2, { I, I } },
+		{ "*", false, Form::infix, 2, { I, I } },
+		{ "/", false, Form::infix, 2, { I, I } },
+		{ "%", false, Form::infix, 2, { I, I } },
+		{ "mod", true, Form::infix, 2, { I, I } },
+		{ "**", false, Form::infix, 2, { I, I }, true },
+		{ "-", false, Form::prefix, 1, { I } },
+		{ "+", false, Form::prefix, 1, { I } },
+		{ "!", false, Form::postfix, 1, { I }, true },
+		{ "abs", true, Form::function, 1, { I } },
+		{ "max", true, Form::function, 2, { I, I } },
+		{ "min", true, Form::function, 2, { I, I } },
+		{ "pow", true, Form::function, 2, { I, I }, true },
+		{ "floor", true, Form::function, 1, { R } },
+		{ "ceil", true, Form::function, 1, { R } },
+	};
+
+	operation const real_operations[] = {
+		{ "+", false, Form::infix, 2, { R, R } },
+		{ "-", false, Form::infix, 2, { R, I } },
+		{ "*", false, Form::infix, 2, { I, R } },
+		{ "/", false, Form::infix, 2, { R, R } },
+		{ "**", false, Form::infix, 2, { R, I }, true },
+		{ "-", false, Form::prefix, 1, { R } },
+		{ "+", false, Form::prefix, 1, { R } },
+		{ "abs", true, Form::function, 1, { R } },
+		{ "arccos", true, Form::function, 1, { R } },
+		{ "arcsin", true, Form::function, 1, { R } },
+		{ "arctan", true, Form::function, 1, { R } },
+		{ "arctan2", true, Form::function, 2, { R, R } },
+		{ "cos", true, Form::function, 1, { R } },
+		{ "exp", true, Form::function, 1, { R } },
+		{ "lb", true, Form::function, 1, { R } },
+		{ "ln", true, Form::function, 1, { R } },
+		{ "log", true, Form::function, 1, { R } },
+		{ "max", true, Form::function, 2, { R, I } },
+		{ "min", true, Form::function, 2, { R, R } },
+		{ "pow", true, Form::function, 2, { R, I }, true },
+		{ "sin", true, Form::function, 1, { R } },
+		{ "sqrt", true, Form::function, 1, { R } },
+		{ "tan", true, Form::function, 1, { R } },
+	};
+
+	operation const boolean_operations[] = {
+		{ "and", true, Form::infix, 2, { B, B } },
+		{ "or", true, Form::infix, 2, { B, B } },
+		{ "xor", true, Form::infix, 2, { B, B } },
+		{ "nand", true, Form::infix, 2, { B, B } },
+		{ "nor", true, Form::infix, 2, { B, B } },
+		{ "xnor", true, Form::infix, 2, { B, B } },
+		{ "not", true, Form::prefix, 1, { B } },
+		{ "<", false, Form::infix, 2, { I, I } },
+		{ "<=", false, Form::infix, 2, { R, I } },
+		{ ">", false, Form::infix, 2, { R, R } },
+		{ ">=", false, Form::infix, 2, { I, I } },
+		{ "==", false, Form::infix, 2, { I, I } },
+		{ "!=", false, Form::infix, 2, { B, B } },
+	};
+
+	span<operation const> operations_of(Type type) {
+		switch (type) {
+		case Type::integer:	return integer_operations;
+		case Type::real:	return real_operations;
+		default:			return boolean_operations;
+		}
+	}
+}
+
+
+
+ExpressionGenerator::ExpressionGenerator(GeneratorOptions const& options, uint64_t seed) : options_m(options), random_m(seed) {
+	options_m.max_operations = max(options_m.max_operations, options_m.min_operations);
+}
+
+
+
+string ExpressionGenerator::next() {
+	return next(_type());
+}
+
+
+
+string ExpressionGenerator::next(Type type) {
+	size_t const operations = options_m.min_operations + _below(options_m.max_operations - options_m.min_operations + 1);
+	text_m.clear();
+	_tree(type, operations, 0);
+	return text_m;
+}
+
+
+
+vector<string> ExpressionGenerator::corpus(size_t count) {
+	vector<string> result;
+	result.reserve(count);
+	while (result.size() < count)
+		result.push_back(next());
+	return result;
+}
+
+
+
+ExpressionGenerator::Type ExpressionGenerator::_type() {
+	double const total = options_m.integer_weight + options_m.real_weight + options_m.boolean_weight;
+	double const pick = double(random_m() >> 11) * 0x1.0p-53 * total;
+	if (pick < options_m.integer_weight || total <= 0)
+		return Type::integer;
+	return pick < options_m.integer_weight + options_m.real_weight ? Type::real : Type::boolean;
+}
+
+
+
+/** A small operand takes no operations; a factorial is only chosen where no operations are left for its operand. */
+void ExpressionGenerator::_tree(Type type, size_t operations, size_t depth) {
+	if (operations == 0 || depth >= options_m.max_depth) {
+		_operand(type);
+		return;
+	}
+
+	auto const table = operations_of(type);
+	operation const* op;
+	do
+		op = &table[_below(table.size())];
+	while (op->form == Form::postfix && operations > 1);
+
+	size_t const typed = op->small ? op->arity - 1 : op->arity;
+	auto const parts = _split(operations - 1, typed);
+	auto small = [&] { text_m += to_string(_below(op->form == Form::postfix ? 13 : 5)); };
+
+	switch (op->form) {
+	case Form::prefix:
+		if (op->keyword) {
+			_keyword(op->text);
+			text_m += ' ';
+		}
+		else
+			text_m += op->text;
+		_inner(op->args[0], parts[0], depth + 1);
+		break;
+	case Form::postfix:
+		small();
+		text_m += op->text;
+		break;
+	case Form::infix:
+		_inner(op->args[0], parts[0], depth + 1);
+		text_m += ' ';
+		if (op->keyword)
+			_keyword(op->text);
+		else
+			text_m += op->text;
+		text_m += ' ';
+		op->small ? small() : _inner(op->args[1], parts[1], depth + 1);
+		break;
+	case Form::function:
+		_keyword(op->text);
+		text_m += '(';
+		for (unsigned i = 0; i < op->arity; ++i) {
+			if (i)
+				text_m += ", ";
+			op->small && i + 1 == op->arity ? small() : _tree(op->args[i], parts[i], depth + 1);
+		}
+		text_m += ')';
+		break;
+	}
+}
+
+
+
+void ExpressionGenerator::_inner(Type type, size_t operations, size_t depth) {
+	bool const compound = operations > 0 && depth < options_m.max_depth;
+	if (compound)
+		text_m += '(';
+	_tree(type, operations, depth);
+	if (compound)
+		text_m += ')';
+}
+
+
+
+void ExpressionGenerator::_operand(Type type) {
+	switch (type) {
+	case Type::boolean:
+		_keyword(_below(2) ? "true" : "false");
+		return;
+	case Type::integer:
+		if (options_m.variables && _below(3) == 0) {
+			text_m += variable(_below(options_m.variables));
+			return;
+		}
+		if (options_m.results && _below(16) == 0) {
+			_keyword("result");
+			text_m += "(1)";
+			return;
+		}
+		switch (_below(8)) {
+		case 0:		text_m += to_string(random_m() % 1000000000u); break;		// beyond a machine int now and then
+		case 1:		text_m += to_string(random_m()) + to_string(random_m() % 1000u); break;
+		default:	text_m += to_string(_below(100)); break;
+		}
+		return;
+	case Type::real:
+		switch (_below(12)) {
+		case 0:		_keyword("pi"); return;
+		case 1:		_keyword("e"); return;
+		default:	break;
+		}
+		text_m += to_string(_below(100));
+		text_m += '.';
+		text_m += to_string(10 + _below(90));
+		if (_chance(options_m.decimal_share))
+			text_m += 'm';
+		return;
+	}
+}
+
+
+
+void ExpressionGenerator::_keyword(char const* lower) {
+	auto const start = text_m.size();
+	text_m += lower;
+	switch (_below(3)) {
+	case 1:		text_m[start] = static_cast<char>(toupper(static_cast<unsigned char>(text_m[start]))); break;
+	case 2:		transform(text_m.begin() + start, text_m.end(), text_m.begin() + start, [](unsigned char c) { return static_cast<char>(toupper(c)); }); break;
+	default:	break;
+	}
+}
+
+
+
+vector<size_t> ExpressionGenerator::_split(size_t operations, size_t parts) {
+	vector<size_t> result(max<size_t>(parts, 1), 0);
+	for (size_t i = 0; i < operations; ++i)
+		++result[_below(result.size())];
+	return result;
+}
@@ -11,6 +11,9 @@ Implementations of the Integer class derived from Operand.
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added isqrt() and the exact integer_abs/sqrt/lb/log/ln kernels.
+
 Version 2021.10.02
 	C++ 20 validated
 
@@ -52,6 +55,8 @@ the program(s) have been supplied.
 #include <ee/boolean.hpp>
 #include <ee/real.hpp>
 #include <array>
+#include <cmath>
+#include <stdexcept>
 using namespace std;
 
 
@@ -60,3 +65,112 @@ using namespace std;
 	return value().str();
 }
 
+
+
+
+/** Integer square root.
+	Starts from the double-precision square root of the leading bits, which is
+	already correct to ~26 bits, then runs Newton's iteration down from above.
+	@throw std::domain_error if n is negative.
+	*/
+[[nodiscard]] Integer::value_type isqrt(Integer::value_type const& n) {
+	if (n < 0)
+		throw domain_error("Error: square root of a negative integer");
+	if (n < 2)
+		return n;
+
+	// initial estimate >= sqrt(n)
+	unsigned shift = static_cast<unsigned>(msb(n));
+	shift = shift > 52 ? (shift - 52) & ~1u : 0;
+	double top = static_cast<double>(Integer::value_type(n >> shift));
+	Integer::value_type x = Integer::value_type(static_cast<unsigned long long>(std::sqrt(top)) + 2) << (shift / 2);
+
+	for (;;) {
+		Integer::value_type y = (x + n / x) >> 1;
+		if (y >= x)
+			return x;
+		x = y;
+	}
+}
+
+
+
+namespace {
+	/** Natural logarithm of a positive integer as a Real.
+		Only the leading bits that fit Real's precision are converted; the rest contributes shift*ln(2).
+		*/
+	Real::value_type ln_of(Integer::value_type const& n) {
+		constexpr unsigned precision_bits = 3400;	// > 1000 decimal digits
+		unsigned high = static_cast<unsigned>(msb(n));
+		unsigned shift = high > precision_bits ? high - precision_bits : 0;
+		Real::value_type mantissa(Integer::value_type(n >> shift));
+		return log(mantissa) + Real::value_type(shift) * boost::math::constants::ln_two<Real::value_type>();
+	}
+
+	void check_log_domain(Integer::value_type const& n) {
+		if (n <= 0)
+			throw domain_error("Error: logarithm of a non-positive integer");
+	}
+}
+
+
+
+/** Absolute value.  Always exact. */
+[[nodiscard]] Operand::pointer_type integer_abs(Integer::value_type const& n) {
+	return make_operand<Integer>(abs(n));
+}
+
+
+
+/** Square root: Integer for perfect squares, otherwise Real. */
+[[nodiscard]] Operand::pointer_type integer_sqrt(Integer::value_type const& n) {
+	Integer::value_type root = isqrt(n);
+	if (root * root == n)
+		return make_operand<Integer>(root);
+	return make_operand<Real>(sqrt(Real::value_type(n)));
+}
+
+
+
+/** Logarithm base 2: Integer for powers of two (read from the bit length), otherwise Real. */
+[[nodiscard]] Operand::pointer_type integer_lb(Integer::value_type const& n) {
+	check_log_domain(n);
+	auto high = msb(n);
+	if (lsb(n) == high)
+		return make_operand<Integer>(Integer::value_type(high));
+	return make_operand<Real>(ln_of(n) / boost::math::constants::ln_two<Real::value_type>());
+}
+
+
+
+/** Logarithm base 10: Integer for powers of ten, otherwise Real.
+	floor(log10(n)) is estimated from the bit length and corrected once.
+	*/
+[[nodiscard]] Operand::pointer_type integer_log(Integer::value_type const& n) {
+	check_log_domain(n);
+	constexpr double log10_2 = 0.30102999566398119521;
+	auto high = msb(n);
+	unsigned k = static_cast<unsigned>(static_cast<double>(high) * log10_2);
+
+	// 10^k == 2^k * 5^k, so a power of ten has exactly k trailing zero bits
+	if (lsb(n) == k || lsb(n) == k + 1) {
+		Integer::value_type p = pow(Integer::value_type(10), k);
+		if (p * 10 <= n) {
+			p *= 10;
+			++k;
+		}
+		if (p == n)
+			return make_operand<Integer>(Integer::value_type(k));
+	}
+	return make_operand<Real>(ln_of(n) / log(Real::value_type(10)));
+}
+
+
+
+/** Natural logarithm: Integer only for ln(1) = 0, otherwise Real. */
+[[nodiscard]] Operand::pointer_type integer_ln(Integer::value_type const& n) {
+	check_log_domain(n);
+	if (n == 1)
+		return make_operand<Integer>(Integer::value_type(0));
+	return make_operand<Real>(ln_of(n));
+}
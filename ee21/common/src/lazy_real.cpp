@@ -0,0 +1,470 @@
+/*!	\file	lazy_real.cpp
+	\brief	LazyReal class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Implementation of the lazy_real value type and the LazyReal class.
+
+Nodes are evaluated at one of a fixed ladder of cpp_dec_float
+precisions.  Every evaluation also reports how many of its digits
+are trustworthy (cancellation in +/-, large arguments to exp/sin/...
+eat digits); when that falls short of the request the whole tree is
+re-evaluated on the next rung.
+
+Trees are immutable apart from each node's cache, and LazyReal
+operands are shared between threads (base layers, concurrent and
+asynchronous sessions, cached plans).  The cache is therefore read
+and written under the node's mutex; the lock is never held while
+children evaluate, so shared subtrees cannot deadlock, and two
+threads refining the same node at once both compute and the more
+precise result is kept.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Node caches are guarded by a per-node mutex.
+	Evaluated and destroyed without recursion; a node's cache is allocated when it is first evaluated.
+	Integral powers use repeated squaring; a negative base needs an integral exponent.
+	Added bytes().
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/lazy_real.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+using namespace std;
+
+
+
+namespace {
+	/*! Precision ladder; the last rung is Real's precision. */
+	constexpr unsigned tiers[] = { 50, 100, 200, 500, 1000 };
+	constexpr unsigned tier_count = sizeof(tiers) / sizeof(tiers[0]);
+
+	/*! Digits reserved against rounding in each evaluation. */
+	constexpr int guard_digits = 8;
+
+	template <unsigned DIGITS>
+	using tier_float = boost::multiprecision::number<boost::multiprecision::cpp_dec_float<DIGITS, int32_t, void>>;
+
+	/*! Decimal exponent of x (0 for zero). */
+	template <typename T>
+	int order(T const& x) {
+		return x.is_zero() ? 0 : static_cast<int>(x.backend().order());
+	}
+}
+
+
+
+/*! Expression-tree node of a lazy_real. */
+struct lazy_real::node {
+	enum class kind { literal, pi, e, negate, abs, sqrt, exp, log, sin, cos, tan, asin, acos, atan, add, subtract, multiply, divide, power };
+
+	kind						op;
+	std::string					text;		// literal digits
+	std::shared_ptr<node const>	lhs, rhs;
+
+	// cache of the most precise evaluation so far, guarded by cache_mutex; allocated when first evaluated
+	mutable std::mutex							cache_mutex;
+	mutable std::unique_ptr<approximation_type>	cache;
+	mutable unsigned			cache_digits = 0;	// working precision of 'cache'
+	mutable int					cache_valid = 0;	// correct significant digits in 'cache'
+
+	node(kind k, std::string t = std::string()) : op(k), text(std::move(t)) { }
+	node(kind k, std::shared_ptr<node const> a, std::shared_ptr<node const> b = nullptr) : op(k), lhs(std::move(a)), rhs(std::move(b)) { }
+	~node();
+
+	/*! Evaluate at DIGITS working precision; 'valid' receives the number of correct significant digits. */
+	template <unsigned DIGITS>
+	tier_float<DIGITS> evaluate(int& valid) const;
+
+private:
+	/*! The cached value, if it was computed at DIGITS or more. */
+	template <unsigned DIGITS>
+	bool _cached(tier_float<DIGITS>* value, int* valid) const;
+
+	/*! Computes this node at DIGITS from its children, which must be cached at DIGITS, and caches it. */
+	template <unsigned DIGITS>
+	void _compute() const;
+};
+
+
+
+/** Children this node solely owns are released iteratively, so a long chain cannot overflow the stack. */
+lazy_real::node::~node() {
+	std::vector<std::shared_ptr<node const>> orphans;
+	auto const adopt = [&orphans](std::shared_ptr<node const>& child) {
+		if (child && child.use_count() == 1)
+			orphans.push_back(std::move(child));
+	};
+	adopt(lhs);
+	adopt(rhs);
+	while (!orphans.empty()) {
+		auto orphan = std::move(orphans.back());
+		orphans.pop_back();
+		node& last = const_cast<node&>(*orphan);		// the sole owner is about to destroy it
+		adopt(last.lhs);
+		adopt(last.rhs);
+	}
+}
+
+
+
+template <unsigned DIGITS>
+bool lazy_real::node::_cached(tier_float<DIGITS>* value, int* valid) const {
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	if (cache_digits < DIGITS)
+		return false;
+	if (value)
+		*value = tier_float<DIGITS>(*cache);
+	if (valid)
+		*valid = std::min(cache_valid, int(DIGITS) - guard_digits);
+	return true;
+}
+
+
+
+/** Nodes are computed in post-order with an explicit stack, each from its children's caches,
+	so the depth of the tree costs heap rather than call stack. */
+template <unsigned DIGITS>
+tier_float<DIGITS> lazy_real::node::evaluate(int& valid) const {
+	tier_float<DIGITS> value;
+	std::vector<std::pair<node const*, bool>> pending{ { this, false } };		// node, children pushed
+	while (!pending.empty()) {
+		auto [n, expanded] = pending.back();
+		if (n->_cached<DIGITS>(nullptr, nullptr))		// also a shared subtree finished by another path
+			pending.pop_back();
+		else if (!expanded) {
+			pending.back().second = true;
+			if (n->rhs)
+				pending.emplace_back(n->rhs.get(), false);
+			if (n->lhs)
+				pending.emplace_back(n->lhs.get(), false);
+		}
+		else {
+			pending.pop_back();
+			n->_compute<DIGITS>();
+		}
+	}
+	(void)_cached<DIGITS>(&value, &valid);
+	return value;
+}
+
+
+
+template <unsigned DIGITS>
+void lazy_real::node::_compute() const {
+	using T = tier_float<DIGITS>;
+	constexpr int precision = int(DIGITS) - guard_digits;
+
+	T a, b, r;
+	int va = precision, vb = precision;
+	if (lhs)
+		(void)lhs->_cached<DIGITS>(&a, &va);
+	if (rhs)
+		(void)rhs->_cached<DIGITS>(&b, &vb);
+	int v = std::min(va, vb);
+
+	switch (op) {
+	case kind::literal:		r = T(text);	break;
+	case kind::pi:			r = boost::math::constants::pi<T>();	break;
+	case kind::e:			r = boost::math::constants::e<T>();		break;
+	case kind::negate:		r = -a;			break;
+	case kind::abs:			r = abs(a);		break;
+	case kind::add:
+	case kind::subtract:
+		r = op == kind::add ? T(a + b) : T(a - b);
+		// cancellation loses the digits between the larger operand and the result
+		v -= r.is_zero() ? precision : std::max(0, std::max(order(a), order(b)) - order(r));
+		break;
+	case kind::multiply:	r = a * b;		v -= 1;		break;
+	case kind::divide:
+		if (b.is_zero())
+			throw domain_error("Error: division by zero");
+		r = a / b;
+		v -= 1;
+		break;
+	case kind::sqrt:
+		if (a < 0 && va > 0)
+			throw domain_error("Error: square root of a negative number");
+		r = a < 0 ? T(0) : T(sqrt(a));
+		break;
+	case kind::exp:
+		r = exp(a);
+		v -= std::max(0, order(a) + 1);
+		break;
+	case kind::log:
+		if (a <= 0)
+			throw domain_error("Error: logarithm of a non-positive number");
+		r = log(a);
+		v -= std::max(0, -order(r));
+		break;
+	case kind::sin:
+	case kind::cos:
+	case kind::tan:
+		r = op == kind::sin ? T(sin(a)) : op == kind::cos ? T(cos(a)) : T(tan(a));
+		v -= std::max(0, order(a) + 1) + std::max(0, -order(r));
+		break;
+	case kind::asin:	r = asin(a);	v -= 1;		break;
+	case kind::acos:	r = acos(a);	v -= 1 + std::max(0, -order(r));	break;
+	case kind::atan:	r = atan(a);	v -= 1;		break;
+	case kind::power:
+		if (trunc(b) == b && abs(b) < T(1e18)) {
+			// integral exponent: repeated squaring, which also serves a negative base
+			long long const n = b.template convert_to<long long>();
+			if (a.is_zero() && n < 0)
+				throw domain_error("Error: division by zero");
+			T square = a;
+			r = 1;
+			for (unsigned long long m = n < 0 ? 0ULL - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n); m != 0; m >>= 1) {
+				if (m & 1)
+					r *= square;
+				if (m > 1)
+					square *= square;
+			}
+			if (n < 0)
+				r = 1 / r;
+			// the relative error of the base is multiplied by |n|
+			v -= 1;
+			for (long long m = n; m != 0; m /= 10)
+				--v;
+		}
+		else {
+			if (a < 0 && va > 0)
+				throw domain_error("Error: negative base with a non-integral exponent");
+			if (a <= 0) {
+				if (b <= 0)
+					throw domain_error("Error: zero to a non-positive power");
+				r = 0;
+				break;
+			}
+			T exponent = b * log(a);
+			r = exp(exponent);
+			v -= 1 + std::max(0, order(exponent) + 1);
+		}
+		break;
+	}
+
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	if (cache_digits < DIGITS) {		// another thread may have refined further meanwhile
+		if (cache)
+			*cache = approximation_type(r);
+		else
+			cache = std::make_unique<approximation_type>(r);
+		cache_digits = DIGITS;
+		cache_valid = v;
+	}
+}
+
+
+
+namespace {
+	using node_pointer = std::shared_ptr<lazy_real::node const>;
+
+	/*! Evaluate on the given rung of the ladder and widen to the approximation type. */
+	lazy_real::approximation_type evaluate_tier(lazy_real::node const& n, unsigned tier, int& valid) {
+		switch (tier) {
+		case 0:		return lazy_real::approximation_type(n.evaluate<tiers[0]>(valid));
+		case 1:		return lazy_real::approximation_type(n.evaluate<tiers[1]>(valid));
+		case 2:		return lazy_real::approximation_type(n.evaluate<tiers[2]>(valid));
+		case 3:		return lazy_real::approximation_type(n.evaluate<tiers[3]>(valid));
+		default:	return n.evaluate<tiers[tier_count - 1]>(valid);
+		}
+	}
+
+	/*! Climbs the ladder until 'digits' significant digits are correct or the top is reached. */
+	lazy_real::approximation_type evaluate_to(lazy_real::node const& n, unsigned digits, int& valid) {
+		unsigned tier = 0;
+		while (tier + 1 < tier_count && int(tiers[tier]) - guard_digits < int(digits))
+			++tier;
+		for (;; ++tier) {
+			auto value = evaluate_tier(n, tier, valid);
+			if (valid >= int(digits) || tier + 1 == tier_count)
+				return value;
+		}
+	}
+}
+
+
+
+lazy_real::lazy_real() : node_m(std::make_shared<node>(node::kind::literal, "0")) { }
+lazy_real::lazy_real(Integer::value_type const& value) : node_m(std::make_shared<node>(node::kind::literal, value.str())) { }
+lazy_real::lazy_real(std::string const& decimal) : node_m(std::make_shared<node>(node::kind::literal, decimal)) { }
+lazy_real lazy_real::pi()	{ return lazy_real(std::make_shared<node>(node::kind::pi)); }
+lazy_real lazy_real::e()	{ return lazy_real(std::make_shared<node>(node::kind::e)); }
+
+
+
+lazy_real::approximation_type lazy_real::approximate(unsigned digits) const {
+	int valid;
+	return evaluate_to(*node_m, digits, valid);
+}
+
+
+
+unsigned lazy_real::cached_digits() const {
+	std::lock_guard<std::mutex> lock(node_m->cache_mutex);
+	return static_cast<unsigned>(std::max(0, node_m->cache_valid));
+}
+
+
+
+/** Walks the node graph without recursion, so a long chain of operations cannot overflow the stack.
+	A node's cache is counted once it has been computed. */
+std::size_t lazy_real::bytes() const {
+	std::size_t total = 0;
+	std::unordered_set<node const*> seen;
+	std::vector<node const*> pending{ node_m.get() };
+	while (!pending.empty()) {
+		node const* n = pending.back();
+		pending.pop_back();
+		if (!n || !seen.insert(n).second)
+			continue;
+		total += sizeof(node) + (n->text.capacity() > std::string().capacity() ? n->text.capacity() + 1 : 0);
+		{
+			std::lock_guard<std::mutex> lock(n->cache_mutex);
+			if (n->cache)
+				total += sizeof(approximation_type);
+		}
+		pending.push_back(n->lhs.get());
+		pending.push_back(n->rhs.get());
+	}
+	return total;
+}
+
+
+
+std::string lazy_real::to_string(unsigned precision) const {
+	// a cheap first look gives the magnitude, and so the significant digits the consumer needs
+	int valid;
+	auto value = evaluate_to(*node_m, 1, valid);
+	unsigned needed = static_cast<unsigned>(std::max(1, order(value) + 2 + int(precision)));
+	if (valid < int(needed))
+		value = evaluate_to(*node_m, needed, valid);
+
+	ostringstream oss;
+	oss << fixed << setprecision(precision) << value;
+	return oss.str();
+}
+
+
+
+int lazy_real::compare(lazy_real const& rhs) const {
+	node difference(node::kind::subtract, node_m, rhs.node_m);
+	for (unsigned tier = 0; tier < tier_count; ++tier) {
+		int valid;
+		auto value = evaluate_tier(difference, tier, valid);
+		if (valid > 0 && !value.is_zero())
+			return value < 0 ? -1 : 1;
+	}
+	return 0;
+}
+
+
+
+Integer::value_type lazy_real::floor() const {
+	// refine until the error interval no longer straddles an integer
+	approximation_type value;
+	for (unsigned tier = 0; tier < tier_count; ++tier) {
+		int valid;
+		value = evaluate_tier(*node_m, tier, valid);
+		if (valid <= 0)
+			continue;
+		approximation_type error = abs(value) * pow(approximation_type(10), -valid);
+		approximation_type low = boost::multiprecision::floor(value - error);
+		if (low == boost::multiprecision::floor(value + error))
+			return low.convert_to<Integer::value_type>();
+	}
+	return boost::multiprecision::floor(value).convert_to<Integer::value_type>();
+}
+
+
+
+Integer::value_type lazy_real::ceil() const {
+	return -(-*this).floor();
+}
+
+
+
+#define LAZY_UNARY(function, kind_)\
+	lazy_real function(lazy_real const& a) {\
+		return lazy_real(std::make_shared<lazy_real::node>(lazy_real::node::kind::kind_, a.node_m));\
+	}
+#define LAZY_BINARY(function, kind_)\
+	lazy_real function(lazy_real const& a, lazy_real const& b) {\
+		return lazy_real(std::make_shared<lazy_real::node>(lazy_real::node::kind::kind_, a.node_m, b.node_m));\
+	}
+LAZY_UNARY(operator -, negate)
+LAZY_UNARY(abs, abs)
+LAZY_UNARY(sqrt, sqrt)
+LAZY_UNARY(exp, exp)
+LAZY_UNARY(log, log)
+LAZY_UNARY(sin, sin)
+LAZY_UNARY(cos, cos)
+LAZY_UNARY(tan, tan)
+LAZY_UNARY(asin, asin)
+LAZY_UNARY(acos, acos)
+LAZY_UNARY(atan, atan)
+LAZY_BINARY(operator +, add)
+LAZY_BINARY(operator -, subtract)
+LAZY_BINARY(operator *, multiply)
+LAZY_BINARY(operator /, divide)
+LAZY_BINARY(pow, power)
+#undef LAZY_UNARY
+#undef LAZY_BINARY
+
+
+
+lazy_real log2(lazy_real const& a) {
+	return log(a) / log(lazy_real(2));
+}
+
+
+
+lazy_real log10(lazy_real const& a) {
+	return log(a) / log(lazy_real(10));
+}
+
+
+
+/** Two-argument arc tangent.  Choosing the quadrant compares x and y with zero, which forces their evaluation. */
+lazy_real atan2(lazy_real const& y, lazy_real const& x) {
+	lazy_real const zero;
+	int xs = x.compare(zero), ys = y.compare(zero);
+	if (xs > 0)
+		return atan(y / x);
+	if (xs < 0)
+		return ys < 0 ? atan(y / x) - lazy_real::pi() : atan(y / x) + lazy_real::pi();
+	if (ys == 0)
+		return zero;
+	return ys > 0 ? lazy_real::pi() / lazy_real(2) : -lazy_real::pi() / lazy_real(2);
+}
+
+
+
+[[nodiscard]] LazyReal::string_type LazyReal::str() const {
+	return value_.to_string();
+}
@@ -0,0 +1,105 @@
+/*!	\file	mapped_file.cpp
+	\brief	MappedFile class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/mapped_file.hpp>
+#include <stdexcept>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+
+MappedFile::MappedFile(string const& path) {
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER size;
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) {
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+		throw runtime_error("Error: cannot open " + path);
+	}
+	file_m = file;
+	size_m = static_cast<size_t>(size.QuadPart);
+	if (size_m == 0)
+		return;
+	mapping_m = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_m)
+		data_m = static_cast<char const*>(MapViewOfFile(mapping_m, FILE_MAP_READ, 0, 0, 0));
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	struct stat info;
+	if (fd < 0 || fstat(fd, &info) != 0) {
+		if (fd >= 0)
+			close(fd);
+		throw runtime_error("Error: cannot open " + path);
+	}
+	size_m = static_cast<size_t>(info.st_size);
+	if (size_m > 0) {
+		void* p = mmap(nullptr, size_m, PROT_READ, MAP_PRIVATE, fd, 0);
+		data_m = p == MAP_FAILED ? nullptr : static_cast<char const*>(p);
+	}
+	close(fd);
+#endif
+	if (size_m > 0 && !data_m) {
+		_release();
+		throw runtime_error("Error: cannot map " + path);
+	}
+}
+
+
+
+MappedFile::~MappedFile() {
+	_release();
+}
+
+
+
+void MappedFile::_release() {
+#if defined(_WIN32)
+	if (data_m)
+		UnmapViewOfFile(data_m);
+	if (mapping_m)
+		CloseHandle(mapping_m);
+	if (file_m)
+		CloseHandle(file_m);
+	mapping_m = nullptr;
+	file_m = nullptr;
+#else
+	if (data_m)
+		munmap(const_cast<char*>(data_m), size_m);
+#endif
+	data_m = nullptr;
+}
@@ -0,0 +1,469 @@
+/*!	\file	multi_double.cpp
+	\brief	Double-double and quad-double floating-point implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Implementation of the multi_double<N> constants, decimal conversions
+and elementary functions.  Algorithms follow the QD library
+(Hida, Li, Bailey): argument reduction + Taylor series for exp,
+sin and cos, and Newton iteration on the inverse for log, sqrt
+and the arc functions.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/multi_double.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <vector>
+using namespace std;
+
+
+
+namespace {
+	// Constants as 4 non-overlapping doubles; the first N are used.
+	constexpr double pi_limbs[4]   = { 3.14159265358979312e+00,  1.22464679914735321e-16, -2.99476980971833967e-33,  1.11245422086336528e-49 };
+	constexpr double e_limbs[4]    = { 2.71828182845904509e+00,  1.44564689172925016e-16, -2.12771710803817676e-33,  1.51563015984121914e-49 };
+	constexpr double ln2_limbs[4]  = { 6.93147180559945286e-01,  2.31904681384629956e-17,  5.70770843841621207e-34, -3.58243221060181142e-50 };
+	constexpr double ln10_limbs[4] = { 2.30258509299404590e+00, -2.17075622338224935e-16, -9.98426245446577657e-33, -4.02335745445020638e-49 };
+
+	template <unsigned N>
+	multi_double<N> make_constant(double const (&limbs)[4]) {
+		static_assert(N <= 4, "constants are tabulated to quad-double precision");
+		typename multi_double<N>::limb_array a{};
+		for (unsigned i = 0; i < N; ++i)
+			a[i] = limbs[i];
+		return multi_double<N>::from_limbs(a);
+	}
+
+	/*! Number of Newton steps needed to go from double precision to N doubles. */
+	template <unsigned N>
+	constexpr unsigned newton_steps() {
+		unsigned steps = 1;
+		for (unsigned bits = 53; bits < 53 * N; bits *= 2)
+			++steps;
+		return steps;
+	}
+
+	/*! Round to nearest integer. */
+	template <unsigned N>
+	multi_double<N> nint(multi_double<N> const& a) {
+		return floor(a + multi_double<N>(0.5));
+	}
+}
+
+
+
+template <unsigned N> multi_double<N> multi_double<N>::pi()		{ return make_constant<N>(pi_limbs); }
+template <unsigned N> multi_double<N> multi_double<N>::e()		{ return make_constant<N>(e_limbs); }
+template <unsigned N> multi_double<N> multi_double<N>::ln2()	{ return make_constant<N>(ln2_limbs); }
+template <unsigned N> multi_double<N> multi_double<N>::ln10()	{ return make_constant<N>(ln10_limbs); }
+
+
+
+/** Parse a decimal string: [+-]digits[.digits][(e|E)[+-]digits]
+	Digits beyond the representable precision only contribute to the exponent.
+	*/
+template <unsigned N>
+multi_double<N>::multi_double(std::string const& s) : x_{} {
+	auto it = s.begin();
+	bool negative = false;
+	if (it != s.end() && (*it == '+' || *it == '-'))
+		negative = *it++ == '-';
+
+	constexpr int max_digits = digits10 + 8;
+	multi_double value;
+	int significant = 0, exponent = 0;
+	double chunk = 0.0, chunkScale = 1.0;
+	bool seenPoint = false;
+	for (; it != s.end(); ++it) {
+		if (*it == '.' && !seenPoint) {
+			seenPoint = true;
+			continue;
+		}
+		if (!isdigit(static_cast<unsigned char>(*it)))
+			break;
+		if (significant == 0 && *it == '0') {
+			if (seenPoint)
+				--exponent;
+			continue;
+		}
+		if (significant < max_digits) {
+			chunk = chunk * 10.0 + (*it - '0');
+			chunkScale *= 10.0;
+			++significant;
+			if (seenPoint)
+				--exponent;
+			if (chunkScale == 1e15) {	// 10^15 < 2^53, so the chunk is exact
+				value = value * chunkScale + multi_double(chunk);
+				chunk = 0.0;
+				chunkScale = 1.0;
+			}
+		}
+		else if (!seenPoint)
+			++exponent;
+	}
+	value = value * chunkScale + multi_double(chunk);
+
+	if (it != s.end() && (*it == 'e' || *it == 'E'))
+		exponent += stoi(string(next(it), s.end()));
+
+	if (exponent > 0)
+		value *= ::pow(multi_double(10.0), static_cast<long long>(exponent));
+	else if (exponent < 0)
+		value /= ::pow(multi_double(10.0), static_cast<long long>(-exponent));
+
+	x_ = (negative ? -value : value).x_;
+}
+
+
+
+template <unsigned N>
+std::string multi_double<N>::to_string(int precision) const {
+	if (std::isnan(x_[0]))
+		return "nan";
+	if (std::isinf(x_[0]))
+		return x_[0] < 0.0 ? "-inf" : "inf";
+
+	// significant digits, most significant first; value = 0.d0d1d2... * 10^(e10+1)
+	vector<int> digits;
+	int e10 = 0;
+	if (x_[0] != 0.0) {
+		multi_double y = abs(*this);
+		e10 = static_cast<int>(std::floor(std::log10(std::abs(x_[0]))));
+		multi_double scale = ::pow(multi_double(10.0), static_cast<long long>(e10 < 0 ? -e10 : e10));
+		y = e10 < 0 ? y * scale : y / scale;
+		if (y >= multi_double(10.0)) { y /= multi_double(10.0); ++e10; }
+		if (y < multi_double(1.0)) { y *= multi_double(10.0); --e10; }
+
+		int wanted = e10 + 1 + precision;
+		if (wanted >= 0) {
+			int generate = std::min(wanted, digits10 + 1);
+			for (int i = 0; i <= generate; ++i) {
+				multi_double d = floor(y);
+				int digit = std::clamp(static_cast<int>(d[0]), 0, 9);
+				digits.push_back(digit);
+				y = (y - multi_double(digit)) * 10.0;
+			}
+
+			// round on the extra digit
+			bool roundUp = digits.back() >= 5;
+			digits.pop_back();
+			for (auto d = digits.rbegin(); roundUp && d != digits.rend(); ++d) {
+				roundUp = ++*d == 10;
+				if (roundUp)
+					*d = 0;
+			}
+			if (roundUp) {
+				digits.insert(digits.begin(), 1);
+				++e10;
+				++wanted;
+			}
+			digits.resize(wanted, 0);
+		}
+	}
+
+	string result;
+	bool nonZero = any_of(digits.begin(), digits.end(), [](int d) { return d != 0; });
+	if (x_[0] < 0.0 && nonZero)
+		result += '-';
+
+	auto digit_at = [&](int position) {	// position = power of ten
+		int index = e10 - position;
+		return index >= 0 && index < int(digits.size()) ? char('0' + digits[index]) : '0';
+	};
+	for (int p = std::max(e10, 0); p >= 0; --p)
+		result += digit_at(p);
+	if (precision > 0) {
+		result += '.';
+		for (int p = -1; p >= -precision; --p)
+			result += digit_at(p);
+	}
+	return result;
+}
+
+
+
+template <unsigned N>
+multi_double<N> sqrt(multi_double<N> const& a) {
+	if (a.is_zero())
+		return a;
+	if (a.is_negative())
+		return multi_double<N>(numeric_limits<double>::quiet_NaN());
+
+	// Newton on f(x) = x^2 - a
+	multi_double<N> x(std::sqrt(a[0]));
+	for (unsigned i = 0; i < newton_steps<N>(); ++i)
+		x += ldexp((a - x * x) / x, -1);
+	return x;
+}
+
+
+
+template <unsigned N>
+multi_double<N> pow(multi_double<N> const& a, long long n) {
+	if (n == 0)
+		return multi_double<N>(1.0);
+
+	// binary exponentiation
+	unsigned long long m = n < 0 ? 0ULL - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n);
+	multi_double<N> result(1.0), base = a;
+	for (; m; m >>= 1) {
+		if (m & 1)
+			result *= base;
+		if (m > 1)
+			base *= base;
+	}
+	return n < 0 ? multi_double<N>(1.0) / result : result;
+}
+
+
+
+template <unsigned N>
+multi_double<N> pow(multi_double<N> const& a, multi_double<N> const& b) {
+	multi_double<N> ib = floor(b);
+	if (ib == b && std::abs(b[0]) < 0x1p62)
+		return pow(a, static_cast<long long>(b[0]) + static_cast<long long>(b[1]));
+	return exp(b * log(a));
+}
+
+
+
+template <unsigned N>
+multi_double<N> exp(multi_double<N> const& a) {
+	constexpr double max_arg = 709.78;
+	if (a[0] > max_arg)
+		return multi_double<N>(numeric_limits<double>::infinity());
+	if (a[0] < -745.0)
+		return multi_double<N>(0.0);
+	if (a.is_zero())
+		return multi_double<N>(1.0);
+
+	// a = k*ln2 + r, then r is scaled down by 2^squarings so the series converges fast
+	constexpr int squarings = 10;
+	multi_double<N> const ln2 = multi_double<N>::ln2();
+	double k = std::floor(a[0] / ln2[0] + 0.5);
+	multi_double<N> r = ldexp(a - ln2 * k, -squarings);
+
+	// s = exp(r) - 1
+	multi_double<N> s = r, term = r;
+	multi_double<N> const threshold = multi_double<N>::epsilon() * ldexp(multi_double<N>(1.0), -squarings);
+	for (int i = 2; i < 100; ++i) {
+		term = term * r / multi_double<N>(i);
+		s += term;
+		if (abs(term) < threshold)
+			break;
+	}
+
+	// (1+s)^2 - 1 = 2s + s^2
+	for (int i = 0; i < squarings; ++i)
+		s = ldexp(s, 1) + s * s;
+	return ldexp(s + multi_double<N>(1.0), static_cast<int>(k));
+}
+
+
+
+template <unsigned N>
+multi_double<N> log(multi_double<N> const& a) {
+	if (a.is_zero())
+		return multi_double<N>(-numeric_limits<double>::infinity());
+	if (a.is_negative() || !a.is_finite())
+		return a.is_negative() ? multi_double<N>(numeric_limits<double>::quiet_NaN()) : a;
+
+	// Newton on f(x) = exp(x) - a:  x' = x + a*exp(-x) - 1
+	multi_double<N> x(std::log(a[0]));
+	for (unsigned i = 0; i < newton_steps<N>(); ++i)
+		x = x + a * exp(-x) - multi_double<N>(1.0);
+	return x;
+}
+
+
+
+template <unsigned N>
+multi_double<N> log2(multi_double<N> const& a) {
+	return log(a) / multi_double<N>::ln2();
+}
+
+
+
+template <unsigned N>
+multi_double<N> log10(multi_double<N> const& a) {
+	return log(a) / multi_double<N>::ln10();
+}
+
+
+
+namespace {
+	/*! Taylor series for sin and cos of |r| <= pi/4. */
+	template <unsigned N>
+	void sin_cos_taylor(multi_double<N> const& r, multi_double<N>& s, multi_double<N>& c) {
+		multi_double<N> const r2 = r * r;
+		multi_double<N> const threshold = multi_double<N>::epsilon();
+
+		s = r;
+		multi_double<N> term = r;
+		for (int i = 3; i < 200; i += 2) {
+			term = -term * r2 / multi_double<N>(double(i - 1) * i);
+			s += term;
+			if (abs(term) < threshold)
+				break;
+		}
+
+		c = multi_double<N>(1.0);
+		term = multi_double<N>(1.0);
+		for (int i = 2; i < 200; i += 2) {
+			term = -term * r2 / multi_double<N>(double(i - 1) * i);
+			c += term;
+			if (abs(term) < threshold)
+				break;
+		}
+	}
+
+	/*! sin and cos of any finite argument by reduction modulo pi/2. */
+	template <unsigned N>
+	void sin_cos(multi_double<N> const& a, multi_double<N>& s, multi_double<N>& c) {
+		multi_double<N> const halfPi = ldexp(multi_double<N>::pi(), -1);
+		multi_double<N> k = nint(a / halfPi);
+		multi_double<N> r = a - halfPi * k;
+		multi_double<N> sr, cr;
+		sin_cos_taylor(r, sr, cr);
+
+		double quadrant = std::fmod(k[0], 4.0) + std::fmod(k[1], 4.0);
+		switch (((static_cast<long long>(quadrant) % 4) + 4) % 4) {
+			case 0:	s = sr;		c = cr;		break;
+			case 1:	s = cr;		c = -sr;	break;
+			case 2:	s = -sr;	c = -cr;	break;
+			default:	s = -cr;	c = sr;		break;
+		}
+	}
+}
+
+
+
+template <unsigned N>
+multi_double<N> sin(multi_double<N> const& a) {
+	if (a.is_zero() || !a.is_finite())
+		return a.is_zero() ? a : multi_double<N>(numeric_limits<double>::quiet_NaN());
+	multi_double<N> s, c;
+	sin_cos(a, s, c);
+	return s;
+}
+
+
+
+template <unsigned N>
+multi_double<N> cos(multi_double<N> const& a) {
+	if (!a.is_finite())
+		return multi_double<N>(numeric_limits<double>::quiet_NaN());
+	multi_double<N> s, c;
+	sin_cos(a, s, c);
+	return c;
+}
+
+
+
+template <unsigned N>
+multi_double<N> tan(multi_double<N> const& a) {
+	if (!a.is_finite())
+		return multi_double<N>(numeric_limits<double>::quiet_NaN());
+	multi_double<N> s, c;
+	sin_cos(a, s, c);
+	return s / c;
+}
+
+
+
+template <unsigned N>
+multi_double<N> atan2(multi_double<N> const& y, multi_double<N> const& x) {
+	if (x.is_zero() && y.is_zero())
+		return multi_double<N>(0.0);
+	if (x.is_zero())
+		return ldexp(y.is_negative() ? -multi_double<N>::pi() : multi_double<N>::pi(), -1);
+	if (y.is_zero())
+		return x.is_negative() ? multi_double<N>::pi() : multi_double<N>(0.0);
+
+	// Newton on the point (xx, yy) of the unit circle, correcting with whichever of sin/cos is better conditioned.
+	multi_double<N> const radius = sqrt(x * x + y * y);
+	multi_double<N> const xx = x / radius;
+	multi_double<N> const yy = y / radius;
+	multi_double<N> z(std::atan2(y[0], x[0]));
+	multi_double<N> s, c;
+	for (unsigned i = 0; i < newton_steps<N>(); ++i) {
+		sin_cos(z, s, c);
+		if (std::abs(xx[0]) > std::abs(yy[0]))
+			z += (yy - s) / c;
+		else
+			z -= (xx - c) / s;
+	}
+	return z;
+}
+
+
+
+template <unsigned N>
+multi_double<N> atan(multi_double<N> const& a) {
+	return atan2(a, multi_double<N>(1.0));
+}
+
+
+
+template <unsigned N>
+multi_double<N> asin(multi_double<N> const& a) {
+	multi_double<N> const one(1.0);
+	if (abs(a) > one)
+		return multi_double<N>(numeric_limits<double>::quiet_NaN());
+	return atan2(a, sqrt(one - a * a));
+}
+
+
+
+template <unsigned N>
+multi_double<N> acos(multi_double<N> const& a) {
+	multi_double<N> const one(1.0);
+	if (abs(a) > one)
+		return multi_double<N>(numeric_limits<double>::quiet_NaN());
+	return atan2(sqrt(one - a * a), a);
+}
+
+
+
+// Explicit instantiations for the supported precisions.
+#define INSTANTIATE_MULTI_DOUBLE(N)\
+	template class multi_double<N>;\
+	template multi_double<N> sqrt(multi_double<N> const&);\
+	template multi_double<N> pow(multi_double<N> const&, long long);\
+	template multi_double<N> pow(multi_double<N> const&, multi_double<N> const&);\
+	template multi_double<N> exp(multi_double<N> const&);\
+	template multi_double<N> log(multi_double<N> const&);\
+	template multi_double<N> log2(multi_double<N> const&);\
+	template multi_double<N> log10(multi_double<N> const&);\
+	template multi_double<N> sin(multi_double<N> const&);\
+	template multi_double<N> cos(multi_double<N> const&);\
+	template multi_double<N> tan(multi_double<N> const&);\
+	template multi_double<N> asin(multi_double<N> const&);\
+	template multi_double<N> acos(multi_double<N> const&);\
+	template multi_double<N> atan(multi_double<N> const&);\
+	template multi_double<N> atan2(multi_double<N> const&, multi_double<N> const&);
+INSTANTIATE_MULTI_DOUBLE(2)
+INSTANTIATE_MULTI_DOUBLE(4)
+#undef INSTANTIATE_MULTI_DOUBLE
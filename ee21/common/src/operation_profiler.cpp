@@ -0,0 +1,178 @@
+/*!	\file	operation_profiler.cpp
+	\brief	OperationProfiler class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/operation_profiler.hpp>
+#include <ee/variable.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <ostream>
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+using namespace std;
+
+
+
+OperationProfiler::counters& OperationProfiler::at(Operation const& operation, span<Token::pointer_type const> args, uint32_t postfix_index) {
+	key_type key;
+	key.operation = &typeid(operation);
+	key.arity = static_cast<uint32_t>(args.size());
+	for (size_t i = 0; i < min(args.size(), typed_operands); ++i) {
+		Token::pointer_type operand = args[i];
+		if (is<Variable>(operand))
+			if (auto value = convert<Variable>(operand)->value())
+				operand = value;		// a Variable counts as its value's type
+		key.operands[i] = operand ? &typeid(*operand) : nullptr;
+	}
+	if (spans_m && postfix_index < offsets_m.size())
+		key.offset = offsets_m[postfix_index];
+	return costs_m[key];
+}
+
+
+
+size_t OperationProfiler::key_hash::operator () (key_type const& key) const {
+	size_t seed = hash<void const*>()(key.operation);
+	auto mix = [&](size_t value) { seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2); };
+	for (auto operand : key.operands)
+		mix(hash<void const*>()(operand));
+	mix(key.arity);
+	mix(key.offset);
+	return seed;
+}
+
+
+
+vector<OperationProfiler::entry> OperationProfiler::ranked() const {
+	unordered_map<type_info const*, string> names;		// demangling is slow; each type once
+	auto name = [&](type_info const* type) -> string const& {
+		auto [iter, added] = names.try_emplace(type);
+		if (added)
+			iter->second = type ? type_name(*type) : "null";
+		return iter->second;
+	};
+
+	vector<entry> result;
+	result.reserve(costs_m.size());
+	for (auto const& [key, cost] : costs_m) {
+		entry e;
+		e.operation = name(key.operation);
+		for (uint32_t i = 0; i < key.arity; ++i) {
+			if (i)
+				e.operands += ',';
+			e.operands += i < typed_operands ? name(key.operands[i]) : "...";
+		}
+		e.offset = key.offset;
+		e.calls = cost.calls;
+		e.ns = cost.ns;
+		e.allocations = cost.allocations;
+		result.push_back(std::move(e));
+	}
+	sort(result.begin(), result.end(), [](entry const& a, entry const& b) {
+		return a.ns != b.ns ? a.ns > b.ns : a.calls != b.calls ? a.calls > b.calls
+			: tie(a.operation, a.operands, a.offset) < tie(b.operation, b.operands, b.offset);
+	});
+	return result;
+}
+
+
+
+void OperationProfiler::report(ostream& out, size_t top) const {
+	auto const entries = ranked();
+	double const total = static_cast<double>(max<uint64_t>(total_ns(), 1));
+
+	char line[256];
+	snprintf(line, sizeof line, "%7s %12s %10s %12s %12s  %s\n", "time%", "ns", "calls", "ns/call", "allocs", "operation");
+	out << line;
+	for (size_t i = 0; i < min(top, entries.size()); ++i) {
+		entry const& e = entries[i];
+		string what = e.operation + '(' + e.operands + ')';
+		if (e.offset != EvalError::no_offset)
+			what += " @" + to_string(e.offset);
+		snprintf(line, sizeof line, "%6.1f%% %12llu %10llu %12.1f %12llu  %s\n", 100.0 * double(e.ns) / total,
+			static_cast<unsigned long long>(e.ns), static_cast<unsigned long long>(e.calls), e.ns_per_call(),
+			static_cast<unsigned long long>(e.allocations), what.c_str());
+		out << line;
+	}
+	if (entries.size() > top)
+		out << "... " << entries.size() - top << " more\n";
+}
+
+
+
+void OperationProfiler::folded(ostream& out, Weight weight) const {
+	for (entry const& e : ranked()) {
+		uint64_t const value = weight == Weight::time ? e.ns : weight == Weight::allocations ? e.allocations : e.calls;
+		if (value == 0)
+			continue;
+		out << "evaluate;" << e.operation;
+		if (e.offset != EvalError::no_offset)
+			out << '@' << e.offset;
+		out << ';' << (e.operands.empty() ? "()" : e.operands) << ' ' << value << '\n';
+	}
+}
+
+
+
+void OperationProfiler::merge(OperationProfiler const& other) {
+	for (auto const& [key, cost] : other.costs_m) {
+		counters& mine = costs_m[key];
+		mine.calls += cost.calls;
+		mine.ns += cost.ns;
+		mine.allocations += cost.allocations;
+	}
+}
+
+
+
+uint64_t OperationProfiler::total_ns() const {
+	uint64_t total = 0;
+	for (auto const& [key, cost] : costs_m)
+		total += cost.ns;
+	return total;
+}
+
+
+
+/** MSVC names are "class Power"; the Itanium ABI's mangled names ("5Power") are demangled. */
+string OperationProfiler::type_name(type_info const& type) {
+	string name = type.name();
+#if __has_include(<cxxabi.h>)
+	int status = 0;
+	unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status), free);
+	if (status == 0 && demangled)
+		name = demangled.get();
+#endif
+	for (char const* prefix : { "class ", "struct " })
+		if (name.starts_with(prefix))
+			name.erase(0, char_traits<char>::length(prefix));
+	if (auto scope = name.rfind("::"); scope != string::npos && name.find('<') == string::npos)
+		name.erase(0, scope + 2);
+	return name;
+}
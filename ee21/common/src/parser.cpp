@@ -7,6 +7,10 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added try_parse(); parse() throws its error.
+	A ',' or ')' without a '(' is an error rather than reading an empty stack.
+
 Version 2021.11.01
 	C++ 20 validated
 	Changed to GATS_TEST
@@ -42,83 +46,92 @@ the program(s) have been supplied.
 #include <stack>
 #include <queue>
 #include <string>
+#include <utility>
 
 [[nodiscard]] TokenList Parser::parse(TokenList const& infixTokens) {
-	
-	std::stack<Token::pointer_type> operStack;
+	auto postfixTokens = try_parse(infixTokens);
+	if (!postfixTokens)
+		throw postfixTokens.error().message();
+	return std::move(*postfixTokens);
+}
+
+
+
+[[nodiscard]] EvalExpected<TokenList> Parser::try_parse(TokenList const& infixTokens, std::vector<std::uint32_t>* origins) {
+
+	// each stacked token keeps its infix index, for errors and origins
+	std::stack<std::pair<Token::pointer_type, std::uint32_t>> operStack;
 	TokenList postfixTokens;
-	try{
-		for (auto tk : infixTokens)
+	auto output = [&](Token::pointer_type const& tk, std::uint32_t index) {
+		postfixTokens.push_back(tk);
+		if (origins)
+			origins->push_back(index);
+	};
+	auto unstack = [&] {
+		output(operStack.top().first, operStack.top().second);
+		operStack.pop();
+	};
+
+	for (std::uint32_t index = 0; index < infixTokens.size(); ++index)
+	{
+		auto const& tk = infixTokens[index];
+		if (is<Operand>(tk))
+			output(tk, index);
+		else if (is<Function>(tk))
+			operStack.push({ tk, index });
+		else if (is<ArgumentSeparator>(tk))
 		{
-			if (is<Operand>(tk))
-				postfixTokens.push_back(tk);
-			else if (is<Function>(tk))
-				operStack.push(tk);
-			else if (is<ArgumentSeparator>(tk))
-			{
-				while (!is<LeftParenthesis>(operStack.top()))
-				{
-					postfixTokens.push_back(operStack.top());
-					operStack.pop();
-				}
-			}
-			else if (is<LeftParenthesis>(tk))
-				operStack.push(tk);
-			else if (is<RightParenthesis>(tk))
-			{
-				while (!is<LeftParenthesis>(operStack.top()))
-				{
-					postfixTokens.push_back(operStack.top());
-					operStack.pop();
-				}
-				if (operStack.empty())
-					throw "Right parenthesis, has no matching left parenthesis.";
+			while (!operStack.empty() && !is<LeftParenthesis>(operStack.top().first))
+				unstack();
+			if (operStack.empty())
+				return eval_failure(EvalErrc::misplaced_separator, index);
+		}
+		else if (is<LeftParenthesis>(tk))
+			operStack.push({ tk, index });
+		else if (is<RightParenthesis>(tk))
+		{
+			while (!operStack.empty() && !is<LeftParenthesis>(operStack.top().first))
+				unstack();
+			if (operStack.empty())
+				return eval_failure(EvalErrc::unmatched_right_parenthesis, index);
 
-				operStack.pop();
-				if (!operStack.empty() && is<Function>(operStack.top()))
+			operStack.pop();
+			if (!operStack.empty() && is<Function>(operStack.top().first))
+				unstack();
+		}
+		else if (is<Operator>(tk))
+		{
+			while (!operStack.empty())
+			{
+				auto const& top = operStack.top().first;
+				if (!is<Operator>(top) || is<NonAssociative>(tk))
+					break;
+				if (is<LAssocOperator>(tk))
 				{
-					postfixTokens.push_back(operStack.top());
-					operStack.pop();
+					auto operatorTk = convert<Operator>(tk);
+					auto operatorSt = convert<Operator>(top);
+					if (operatorTk->precedence() > operatorSt->precedence())
+						break;
 				}
-			}
-			else if (is<Operator>(tk))
-			{
-				while (!operStack.empty())
+				if (is<RAssocOperator>(tk))
 				{
-					if (!is<Operator>(operStack.top()) || is<NonAssociative>(tk))
+					auto operatorTk = convert<Operator>(tk);
+					auto operatorSt = convert<Operator>(top);
+					if (operatorTk->precedence() >= operatorSt->precedence())
 						break;
-					if (is<LAssocOperator>(tk))
-					{
-						auto operatorTk = convert<Operator>(tk);
-						auto operatorSt = convert<Operator>(operStack.top());
-						if (operatorTk->precedence() > operatorSt->precedence())
-							break;
-					}
-					if (is<RAssocOperator>(tk))
-					{
-						auto operatorTk = convert<Operator>(tk);
-						auto operatorSt = convert<Operator>(operStack.top());
-						if (operatorTk->precedence() >= operatorSt->precedence())
-							break;
-					}
-					postfixTokens.push_back(operStack.top());
-					operStack.pop();
-				}//while
-				operStack.push(tk);
-			}//elseif
-			else
-				throw "Unkown token.";
-		}//end for
-		while (!operStack.empty())
-		{
-			if (is<LeftParenthesis>(operStack.top()))
-				throw "Missing right-parenthesis.";
-			postfixTokens.push_back(operStack.top());
-			operStack.pop();
-		}//while
-	}//try
-	catch (std::string e) {
-		std::cout << e << std::endl;
-	}
+				}
+				unstack();
+			}//while
+			operStack.push({ tk, index });
+		}//elseif
+		else
+			return eval_failure(EvalErrc::unknown_token, index);
+	}//end for
+	while (!operStack.empty())
+	{
+		if (is<LeftParenthesis>(operStack.top().first))
+			return eval_failure(EvalErrc::missing_right_parenthesis, operStack.top().second);
+		unstack();
+	}//while
 	return postfixTokens;
 }
@@ -0,0 +1,35 @@
+/*!	\file	quad_double.cpp
+	\brief	QuadDouble class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Implementation of the QuadDouble class derived from Operand.
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/quad_double.hpp>
+
+
+[[nodiscard]] QuadDouble::string_type QuadDouble::str() const {
+	return value_.to_string();
+}
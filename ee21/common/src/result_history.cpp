@@ -0,0 +1,112 @@
+/*!	\file	result_history.cpp
+	\brief	ResultHistory class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Grow the ring on demand.
+	Lookups no longer rewrite the ring.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/result_history.hpp>
+#include <ee/boolean.hpp>
+#include <ee/integer.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+using namespace std;
+
+
+
+ResultHistory::ResultHistory(size_type capacity) : capacity_m(capacity) { }
+
+
+
+ResultHistory::size_type ResultHistory::push(Operand::pointer_type const& result) {
+	++count_m;
+	if (capacity_m == 0)
+		return count_m;
+
+	// grow until full, then overwrite the oldest; growth never reserves past the capacity
+	entry_type* slot;
+	if (ring_m.size() < capacity_m) {
+		if (ring_m.size() == ring_m.capacity())
+			ring_m.reserve(min(capacity_m, max<size_type>(8, ring_m.size() * 2)));
+		slot = &ring_m.emplace_back();
+	}
+	else {
+		slot = &ring_m[oldest_m];
+		oldest_m = (oldest_m + 1) % ring_m.size();
+	}
+
+	if (is<Integer>(result)) {
+		auto const& value = value_of<Integer>(result);
+		if (value >= numeric_limits<long long>::min() && value <= numeric_limits<long long>::max()) {
+			*slot = static_cast<long long>(value);
+			return count_m;
+		}
+	}
+	if (is<Boolean>(result))
+		*slot = value_of<Boolean>(result);
+	else
+		*slot = result;
+	return count_m;
+}
+
+
+
+Operand::pointer_type ResultHistory::at(size_type n) const {
+	if (!contains(n))
+		throw out_of_range("Error: result " + to_string(n) + " is not in the history");
+
+	static Operand::pointer_type const yes = make_operand<Boolean>(true);
+	static Operand::pointer_type const no = make_operand<Boolean>(false);
+
+	entry_type const& entry = ring_m[slot_index(n)];
+	if (auto small = get_if<long long>(&entry))
+		return make_operand<Integer>(*small);
+	if (auto b = get_if<bool>(&entry))
+		return *b ? yes : no;
+	return get<Operand::pointer_type>(entry);
+}
+
+
+
+void ResultHistory::set_capacity(size_type capacity) {
+	// unroll the held results oldest first into a ring just big enough for them
+	size_type keep = min(size(), capacity);
+	vector<entry_type> ring;
+	ring.reserve(keep);
+	for (size_type n = count_m - keep + 1; n <= count_m; ++n)
+		ring.push_back(std::move(ring_m[slot_index(n)]));
+	ring_m.swap(ring);
+	capacity_m = capacity;
+	oldest_m = 0;
+}
+
+
+
+void ResultHistory::clear(size_type count) {
+	ring_m.clear();
+	oldest_m = 0;
+	count_m = count;
+}
@@ -0,0 +1,560 @@
+/*!	\file	shm_ring.cpp
+	\brief	Shared-memory ring transport implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	Invalid expressions are answered through try_evaluate().
+	Results are formatted in the format allocation stage.
+	Records read from a ring are checked against its capacity; a lane whose
+	client breaks the protocol is no longer served.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/shm_ring.hpp>
+
+#if defined(__linux__)
+
+#include <ee/expression_evaluator.hpp>
+#include <ee/allocation_tracking.hpp>
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+using namespace std;
+
+
+
+namespace {
+	static_assert(atomic<uint32_t>::is_always_lock_free && sizeof(atomic<uint32_t>) == 4, "futex words must be plain 32-bit integers");
+	static_assert(atomic<uint64_t>::is_always_lock_free, "ring indices are shared between processes");
+
+	constexpr uint64_t	segment_magic = 0x31325f4545'6d6873;	// "shmEE_21"
+	constexpr uint32_t	segment_version = 1;
+	constexpr size_t	max_groups = 64;
+	constexpr uint32_t	skip_marker = 0xFFFFFFFF;
+	constexpr int		spin_limit = 1000;		// pauses before sleeping, when there is another CPU to wait for
+
+	/*! Lane of a segment: owned by one client, served by one server thread. */
+	struct shm_lane {
+		alignas(64) atomic<uint32_t>	owner{ 0 };
+		atomic<uint32_t>				generation{ 0 };	// bumped by each new owner
+		alignas(64) ShmDoorbell			client_bell;		// the client sleeps here, for replies and for room
+		ShmRing::header					requests;
+		ShmRing::header					responses;
+	};
+
+	/*! The start of a segment; the lanes and then the ring data follow. */
+	struct shm_segment {
+		uint64_t						magic = segment_magic;
+		uint32_t						version = segment_version;
+		uint32_t						lanes = 0;
+		uint32_t						groups = 0;
+		uint64_t						ring_bytes = 0;
+		atomic<uint32_t>				stopping{ 0 };
+		alignas(64) ShmDoorbell			bells[max_groups];	// serving thread g sleeps on bells[g]
+	};
+
+	constexpr size_t align64(size_t n) { return (n + 63) & ~size_t(63); }
+
+	size_t lanes_offset() { return align64(sizeof(shm_segment)); }
+	size_t data_offset(size_t lanes) { return align64(lanes_offset() + lanes * sizeof(shm_lane)); }
+	size_t segment_bytes(size_t lanes, uint64_t ring_bytes) { return data_offset(lanes) + lanes * 2 * ring_bytes; }
+
+	shm_segment& segment_of(void* mapping) { return *static_cast<shm_segment*>(mapping); }
+
+	shm_lane& lane_of(void* mapping, size_t index) {
+		return reinterpret_cast<shm_lane*>(static_cast<char*>(mapping) + lanes_offset())[index];
+	}
+
+	char* ring_data(void* mapping, size_t index, bool responses) {
+		auto& s = segment_of(mapping);
+		return static_cast<char*>(mapping) + data_offset(s.lanes) + (2 * index + (responses ? 1 : 0)) * s.ring_bytes;
+	}
+
+	string segment_name(string name) {
+		return !name.empty() && name.front() == '/' ? name : "/" + name;
+	}
+
+	[[noreturn]] void fail(string const& what) {
+		throw runtime_error("Error: " + what + ": " + strerror(errno));
+	}
+
+	void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	// not FUTEX_PRIVATE: the word is shared between processes
+	void futex_wait(atomic<uint32_t>* word, uint32_t expected) {
+		(void)syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+	}
+
+	void futex_wake(atomic<uint32_t>* word) {
+		(void)syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	constexpr uint64_t record_size(size_t payload) { return (4 + payload + 7) & ~uint64_t(7); }
+
+	[[noreturn]] void corrupt() {
+		throw runtime_error("Error: the shared memory ring is corrupt");
+	}
+}
+
+
+
+void ShmDoorbell::ring() {
+	// pairs with the fence in wait(): either the sleeper sees the new data, or we see the sleeper
+	atomic_thread_fence(memory_order_seq_cst);
+	if (sleepers.load(memory_order_relaxed) != 0) {
+		sequence.fetch_add(1, memory_order_seq_cst);
+		futex_wake(&sequence);
+	}
+}
+
+
+
+void ShmDoorbell::wait(function<bool()> const& ready) {
+	static int const spins = thread::hardware_concurrency() > 1 ? spin_limit : 0;
+	for (int spin = 0; spin < spins; ++spin) {
+		if (ready())
+			return;
+		cpu_relax();
+	}
+	while (!ready()) {
+		sleepers.fetch_add(1, memory_order_seq_cst);
+		atomic_thread_fence(memory_order_seq_cst);
+		uint32_t seen = sequence.load(memory_order_seq_cst);
+		if (!ready())
+			futex_wait(&sequence, seen);		// returns at once if a ring() came after 'seen'
+		sleepers.fetch_sub(1, memory_order_relaxed);
+	}
+}
+
+
+
+bool ShmRing::can_push(size_t bytes) const {
+	uint64_t const capacity = capacity_m;
+	uint64_t const head = header_m->head.load(memory_order_relaxed);
+	uint64_t const tail = header_m->tail.load(memory_order_acquire);
+	uint64_t const size = record_size(bytes);
+	uint64_t const to_end = capacity - (head & (capacity - 1));
+	return capacity - (head - tail) >= size + (to_end < size ? to_end : 0);
+}
+
+
+
+bool ShmRing::try_push(string_view a, string_view b) {
+	uint64_t const capacity = capacity_m;
+	size_t const bytes = a.size() + b.size();
+	if (bytes > max_record(capacity))
+		throw length_error("Error: record too long for the ring");
+	if (!can_push(bytes))
+		return false;
+
+	uint64_t head = header_m->head.load(memory_order_relaxed);
+	uint64_t at = head & (capacity - 1);
+	if (capacity - at < record_size(bytes)) {
+		memcpy(data_m + at, &skip_marker, 4);
+		head += capacity - at;
+		at = 0;
+	}
+	uint32_t const length = static_cast<uint32_t>(bytes);
+	memcpy(data_m + at, &length, 4);
+	memcpy(data_m + at + 4, a.data(), a.size());
+	memcpy(data_m + at + 4 + a.size(), b.data(), b.size());
+	header_m->head.store(head + record_size(bytes), memory_order_release);
+	readable_m->ring();
+	return true;
+}
+
+
+
+/** The writer may be another process, so the indices and the length are checked before anything
+	is read through them: every record must lie inside the ring and inside what was published. */
+optional<string_view> ShmRing::front() {
+	uint64_t const capacity = capacity_m;
+	uint64_t tail = header_m->tail.load(memory_order_relaxed);
+	for (;;) {
+		uint64_t const head = header_m->head.load(memory_order_acquire);
+		if (tail == head)
+			return nullopt;
+		uint64_t const published = head - tail;
+		uint64_t const at = tail & (capacity - 1);
+		if (published > capacity || capacity - at < 4)
+			corrupt();
+		uint32_t length;
+		memcpy(&length, data_m + at, 4);
+		if (length == skip_marker) {
+			if (published < capacity - at)
+				corrupt();
+			tail += capacity - at;
+			header_m->tail.store(tail, memory_order_release);
+			continue;
+		}
+		if (length > max_record(capacity) || record_size(length) > capacity - at || record_size(length) > published)
+			corrupt();
+		front_size_m = record_size(length);
+		return string_view(data_m + at + 4, length);
+	}
+}
+
+
+
+void ShmRing::pop() {
+	header_m->tail.store(header_m->tail.load(memory_order_relaxed) + front_size_m, memory_order_release);
+	front_size_m = 0;
+	writable_m->ring();
+}
+
+
+
+ShmEvalServer::ShmEvalServer(string name, size_t lanes, size_t threads, uint64_t ring_bytes, Environment::base_type base)
+	: name_m(segment_name(std::move(name))), base_m(std::move(base))
+{
+	if (lanes == 0 || lanes > UINT32_MAX)
+		throw invalid_argument("Error: a segment needs at least one lane");
+	ring_bytes = bit_ceil(max<uint64_t>(ring_bytes, 4096));
+	size_t const groups = clamp<size_t>(threads, 1, min(lanes, max_groups));
+	bytes_m = segment_bytes(lanes, ring_bytes);
+
+	shm_unlink(name_m.c_str());
+	int fd = shm_open(name_m.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+	if (fd < 0)
+		fail("cannot create " + name_m);
+	if (ftruncate(fd, static_cast<off_t>(bytes_m)) != 0) {
+		close(fd);
+		shm_unlink(name_m.c_str());
+		fail("cannot size " + name_m);
+	}
+	mapping_m = mmap(nullptr, bytes_m, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping_m == MAP_FAILED) {
+		mapping_m = nullptr;
+		shm_unlink(name_m.c_str());
+		fail("cannot map " + name_m);
+	}
+
+	auto& s = *new (mapping_m) shm_segment;
+	s.lanes = static_cast<uint32_t>(lanes);
+	s.groups = static_cast<uint32_t>(groups);
+	s.ring_bytes = ring_bytes;
+	for (size_t i = 0; i < lanes; ++i) {
+		auto& lane = *new (&lane_of(mapping_m, i)) shm_lane;
+		lane.requests.capacity = ring_bytes;
+		lane.responses.capacity = ring_bytes;
+	}
+}
+
+
+
+ShmEvalServer::~ShmEvalServer() {
+	stop();
+	for (auto& t : threads_m)
+		t.join();
+	munmap(mapping_m, bytes_m);
+	shm_unlink(name_m.c_str());
+}
+
+
+
+void ShmEvalServer::start() {
+	size_t const groups = segment_of(mapping_m).groups;
+	for (size_t g = 0; g < groups; ++g)
+		threads_m.emplace_back([this, g, groups] { _serve(g, groups); });
+}
+
+
+
+void ShmEvalServer::run() {
+	start();
+	for (auto& t : threads_m)
+		t.join();
+	threads_m.clear();
+}
+
+
+
+void ShmEvalServer::stop() {
+	auto& s = segment_of(mapping_m);
+	s.stopping.store(1, memory_order_seq_cst);
+	for (size_t g = 0; g < s.groups; ++g)
+		s.bells[g].ring();
+	for (size_t i = 0; i < s.lanes; ++i)
+		lane_of(mapping_m, i).client_bell.ring();
+}
+
+
+
+void ShmEvalServer::_serve(size_t group, size_t groups) {
+	struct served {
+		shm_lane*						lane = nullptr;
+		ShmRing							requests;
+		ShmRing							responses;
+		uint32_t						generation = 0;
+		unique_ptr<ExpressionEvaluator>	session;
+		string							pending;		// a reply waiting for room
+		bool							has_pending = false;
+		bool							retired = false;		// its client broke the ring protocol
+	};
+
+	auto& s = segment_of(mapping_m);
+	ShmDoorbell& bell = s.bells[group];
+	vector<served> lanes;
+	for (size_t i = group; i < s.lanes; i += groups) {
+		auto& lane = lane_of(mapping_m, i);
+		auto& l = lanes.emplace_back();
+		l.lane = &lane;
+		l.requests = ShmRing(&lane.requests, ring_data(mapping_m, i, false), &bell, &lane.client_bell);
+		l.responses = ShmRing(&lane.responses, ring_data(mapping_m, i, true), &lane.client_bell, &bell);
+	}
+
+	size_t const max_text = ShmRing::max_record(s.ring_bytes) - 1;
+	string expr, text;
+	auto stopping = [&s] { return s.stopping.load(memory_order_acquire) != 0; };
+
+	while (!stopping()) {
+		bool progressed = false;
+		for (auto& l : lanes) {
+			if (l.retired)
+				continue;
+			if (l.has_pending) {
+				if (!l.responses.try_push(l.pending))
+					continue;
+				l.has_pending = false;
+				l.requests.pop();
+				progressed = true;
+			}
+
+			for (;;) {
+				optional<string_view> request;
+				try {
+					request = l.requests.front();
+				}
+				catch (runtime_error const&) {
+					// the client broke the ring protocol: stop serving it, not every client
+					l.retired = true;
+					l.session.reset();
+					break;
+				}
+				if (!request)
+					break;
+
+				// read after the request, so a new owner's generation is visible
+				uint32_t generation = l.lane->generation.load(memory_order_acquire);
+				if (!l.session || generation != l.generation) {
+					l.session = make_unique<ExpressionEvaluator>();
+					if (base_m)
+						l.session->set_environment(Environment(base_m));
+					l.generation = generation;
+				}
+
+				// the tokenizer takes a std::string; reusing one keeps this copy allocation-free
+				expr.assign(*request);
+				char status = '\0';
+				text.clear();
+				try {
+					// invalid input is common under load; try_evaluate() reports it without unwinding
+					if (auto result = l.session->try_evaluate(expr); !result) {
+						status = '\1';
+						text = result.error().message();
+					}
+					else if (*result) {
+						AllocationStageScope formatting(AllocationStage::format);
+						text = (*result)->str();
+					}
+				}
+				catch (exception const& e) {
+					status = '\1';
+					text = *e.what() ? e.what() : "Error: evaluation failed";
+				}
+				catch (...) {
+					status = '\1';
+					text = "Error: evaluation failed";
+				}
+				if (text.size() > max_text)
+					text.resize(max_text);
+
+				if (!l.responses.try_push(string_view(&status, 1), text)) {
+					l.pending.assign(1, status).append(text);
+					l.has_pending = true;
+					break;
+				}
+				l.requests.pop();
+				progressed = true;
+			}
+
+			if (l.session && l.lane->owner.load(memory_order_relaxed) == 0 && !l.has_pending)
+				l.session.reset();		// do not keep a departed client's variables
+		}
+
+		if (!progressed)
+			bell.wait([&] {
+				if (stopping())
+					return true;
+				for (auto& l : lanes)
+					if (!l.retired && (l.has_pending ? l.responses.can_push(l.pending.size()) : !l.requests.empty()))
+						return true;
+				return false;
+			});
+	}
+}
+
+
+
+ShmEvalClient::ShmEvalClient(string const& name) {
+	string const shm_name = segment_name(name);
+	int fd = shm_open(shm_name.c_str(), O_RDWR | O_CLOEXEC, 0);
+	if (fd < 0)
+		fail("cannot open " + shm_name);
+	struct stat info;
+	if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(shm_segment)) {
+		close(fd);
+		throw runtime_error("Error: " + shm_name + " is not an evaluation segment");
+	}
+	bytes_m = static_cast<size_t>(info.st_size);
+	mapping_m = mmap(nullptr, bytes_m, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping_m == MAP_FAILED) {
+		mapping_m = nullptr;
+		fail("cannot map " + shm_name);
+	}
+
+	auto& s = segment_of(mapping_m);
+	if (s.magic != segment_magic || s.version != segment_version || bytes_m < segment_bytes(s.lanes, s.ring_bytes)) {
+		munmap(mapping_m, bytes_m);
+		throw runtime_error("Error: " + shm_name + " is not an evaluation segment");
+	}
+	if (s.stopping.load(memory_order_acquire)) {
+		munmap(mapping_m, bytes_m);
+		throw runtime_error("Error: the server of " + shm_name + " has stopped");
+	}
+
+	for (size_t i = 0; i < s.lanes; ++i) {
+		auto& lane = lane_of(mapping_m, i);
+		uint32_t free = 0;
+		if (!lane.owner.compare_exchange_strong(free, 1, memory_order_acquire))
+			continue;
+		lane.generation.fetch_add(1, memory_order_release);
+		ShmDoorbell& server_bell = s.bells[i % s.groups];
+		requests_m = ShmRing(&lane.requests, ring_data(mapping_m, i, false), &server_bell, &lane.client_bell);
+		responses_m = ShmRing(&lane.responses, ring_data(mapping_m, i, true), &lane.client_bell, &server_bell);
+		lane_m = &lane;
+		return;
+	}
+	munmap(mapping_m, bytes_m);
+	throw runtime_error("Error: every lane of " + shm_name + " is taken");
+}
+
+
+
+ShmEvalClient::~ShmEvalClient() {
+	try {
+		while (in_flight_m > 0)
+			(void)receive();
+	}
+	catch (...) {
+	}
+	_release();
+}
+
+
+
+void ShmEvalClient::_release() {
+	if (holding_m) {
+		responses_m.pop();
+		holding_m = false;
+	}
+	// a lane with replies still owed is left claimed, so no later client reads them
+	if (in_flight_m == 0)
+		static_cast<shm_lane*>(lane_m)->owner.store(0, memory_order_release);
+	munmap(mapping_m, bytes_m);
+}
+
+
+
+bool ShmEvalClient::try_send(string_view expr) {
+	if (!requests_m.try_push(expr))
+		return false;
+	++in_flight_m;
+	return true;
+}
+
+
+
+void ShmEvalClient::send(string_view expr) {
+	auto& s = segment_of(mapping_m);
+	while (!try_send(expr)) {
+		static_cast<shm_lane*>(lane_m)->client_bell.wait([&] {
+			return s.stopping.load(memory_order_acquire) != 0 || requests_m.can_push(expr.size());
+		});
+		if (s.stopping.load(memory_order_acquire))
+			throw runtime_error("Error: the server has stopped");
+	}
+}
+
+
+
+optional<ShmEvalClient::reply> ShmEvalClient::try_receive() {
+	if (holding_m) {
+		responses_m.pop();
+		holding_m = false;
+	}
+	if (in_flight_m == 0)
+		return nullopt;
+	auto record = responses_m.front();
+	if (!record)
+		return nullopt;
+	holding_m = true;
+	--in_flight_m;
+	return reply{ !record->empty() && record->front() == '\0', record->substr(min<size_t>(1, record->size())) };
+}
+
+
+
+ShmEvalClient::reply ShmEvalClient::receive() {
+	if (in_flight_m == 0)
+		throw logic_error("Error: no request is waiting for a reply");
+	auto& s = segment_of(mapping_m);
+	for (;;) {
+		if (auto r = try_receive())
+			return *r;
+		static_cast<shm_lane*>(lane_m)->client_bell.wait([&] {
+			return s.stopping.load(memory_order_acquire) != 0 || !responses_m.empty();
+		});
+		if (responses_m.empty() && s.stopping.load(memory_order_acquire))
+			throw runtime_error("Error: the server has stopped");
+	}
+}
+
+#endif // __linux__
@@ -0,0 +1,426 @@
+/*!	\file	snapshot.cpp
+	\brief	Binary session snapshot implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Layout (native byte order, which the header records):
+
+	header		"EE21SNAP", u32 version, u32 byte-order mark,
+				u8 cpp_int limb size, 3 bytes padding
+	section*	u32 tag, u64 payload length, payload
+
+	variables	u32 count, { name, operand }*
+	history		u64 capacity, u64 results recorded, u64 held,
+				operand* (oldest first)
+
+	name		u32 length, bytes
+	operand		u8 type tag, then
+				Integer			u8 sign, u32 limb count, limbs
+				Real			cpp_dec_float elements, exponent, sign, class, precision
+				Boolean			u8
+				Decimal			u8 sign, u64 low, u64 high
+				Double/Quad		2 or 4 doubles
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	File mapping moved to MappedFile.
+	Loading validates everything, the history capacity included, before the session is changed.
+	Loading keeps the session's base layer and variable limits.
+	Real fields and decimal magnitudes are range-checked as they are read.
+	Saves only the session's own variables, not its base layers.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/snapshot.hpp>
+#include <ee/mapped_file.hpp>
+#include <ee/boolean.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
+#include <ee/integer.hpp>
+#include <ee/lazy_real.hpp>
+#include <ee/quad_double.hpp>
+#include <ee/real.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+
+
+namespace {
+	char const			magic[8] = { 'E', 'E', '2', '1', 'S', 'N', 'A', 'P' };
+	uint32_t const		format_version = 1;
+	uint32_t const		byte_order_mark = 0x01020304;
+	uint64_t const		max_history_capacity = uint64_t(1) << 24;		// larger capacities in a file are taken as corrupt
+
+	enum section_tag : uint32_t { section_variables = 1, section_history = 2 };
+	enum class operand_tag : uint8_t { null, integer, real, boolean, decimal, double_double, quad_double };
+
+	using limb_type = boost::multiprecision::limb_type;
+
+
+
+	/*! Appends raw values to a byte string. */
+	class writer {
+		string&	out_m;
+	public:
+		explicit writer(string& out) : out_m(out) { }
+
+		template <typename T>
+		void put(T const& value) {
+			static_assert(is_trivially_copyable_v<T>);
+			out_m.append(reinterpret_cast<char const*>(&value), sizeof value);
+		}
+		void put_bytes(void const* data, size_t size) { out_m.append(static_cast<char const*>(data), size); }
+		void put_string(string const& s) { put(static_cast<uint32_t>(s.size())); put_bytes(s.data(), s.size()); }
+
+		/*! Archive interface used by cpp_dec_float::serialize. */
+		template <typename T>
+		writer& operator & (boost::serialization::nvp<T> const& item) { put(item.const_value()); return *this; }
+	};
+
+
+
+	/*! Reads raw values from a byte range, checking every access. */
+	class reader {
+		char const*	p_m;
+		char const*	end_m;
+	public:
+		reader(char const* data, size_t size) : p_m(data), end_m(data + size) { }
+
+		[[nodiscard]] bool at_end() const { return p_m == end_m; }
+
+		char const* take(size_t size) {
+			if (size_t(end_m - p_m) < size)
+				throw runtime_error("Error: snapshot is truncated");
+			char const* result = p_m;
+			p_m += size;
+			return result;
+		}
+		template <typename T>
+		T get() {
+			T value;
+			memcpy(&value, take(sizeof value), sizeof value);
+			return value;
+		}
+		string get_string() {
+			auto size = get<uint32_t>();
+			return string(take(size), size);
+		}
+
+	};
+
+
+
+	/*! Archive interface used by cpp_dec_float::serialize when loading.  Its fields are stored raw,
+		so each is checked before it is stored: a digit element must be below the element base,
+		the sign and class must be values of their types, and the precision a count of elements
+		the number has. */
+	class real_reader {
+		using backend_type = Real::value_type::backend_type;
+		static constexpr uint32_t	element_base = 100000000;		// cpp_dec_float's (private) cpp_dec_float_elem_mask
+
+		reader&		in_m;
+		int32_t		elements_m = 0;
+
+		[[noreturn]] static void _corrupt() { throw runtime_error("Error: snapshot has a corrupt real number"); }
+
+	public:
+		explicit real_reader(reader& in) : in_m(in) { }
+
+		template <typename T>
+		real_reader& operator & (boost::serialization::nvp<T> const& item) {
+			string_view const name = item.name();
+			T& field = item.value();
+			if constexpr (is_same_v<T, bool>) {
+				auto const raw = in_m.get<uint8_t>();
+				if (raw > 1)
+					_corrupt();
+				field = raw != 0;
+			}
+			else if constexpr (is_enum_v<T>) {
+				auto const raw = in_m.get<underlying_type_t<T>>();
+				if (raw < 0 || raw > 2)		// finite, infinity, NaN
+					_corrupt();
+				field = static_cast<T>(raw);
+			}
+			else {
+				field = in_m.get<T>();
+				if (name == "digit") {
+					if (uint64_t(field) >= element_base)
+						_corrupt();
+					++elements_m;
+				}
+				else if constexpr (is_signed_v<T>) {		// the exponent and the precision; the digits are unsigned
+					if (name == "exponent") {
+						if (field < backend_type::cpp_dec_float_min_exp || field > backend_type::cpp_dec_float_max_exp)
+							_corrupt();
+					}
+					else if (name == "precision") {
+						if (field < 2 || field > elements_m)
+							_corrupt();
+					}
+				}
+			}
+			return *this;
+		}
+	};
+
+
+
+	void put_operand(writer& out, Operand::pointer_type const& operand) {
+		if (!operand) {
+			out.put(operand_tag::null);
+		}
+		else if (is<Integer>(operand)) {
+			auto value = value_of<Integer>(operand);
+			auto const& backend = value.backend();
+			out.put(operand_tag::integer);
+			out.put(static_cast<uint8_t>(backend.sign()));
+			out.put(static_cast<uint32_t>(backend.size()));
+			out.put_bytes(backend.limbs(), backend.size() * sizeof(limb_type));
+		}
+		else if (is<Boolean>(operand)) {
+			out.put(operand_tag::boolean);
+			out.put(static_cast<uint8_t>(value_of<Boolean>(operand)));
+		}
+		else if (is<Decimal>(operand)) {
+			auto raw = value_of<Decimal>(operand).raw();
+			auto magnitude = raw < 0 ? fixed_decimal::raw_type(-raw) : raw;
+			out.put(operand_tag::decimal);
+			out.put(static_cast<uint8_t>(raw < 0));
+			out.put(static_cast<uint64_t>(magnitude & fixed_decimal::raw_type(~0ull)));
+			out.put(static_cast<uint64_t>(magnitude >> 64));
+		}
+		else if (is<DoubleDouble>(operand)) {
+			out.put(operand_tag::double_double);
+			out.put(value_of<DoubleDouble>(operand).limbs());
+		}
+		else if (is<QuadDouble>(operand)) {
+			out.put(operand_tag::quad_double);
+			out.put(value_of<QuadDouble>(operand).limbs());
+		}
+		else if (is<Real>(operand) || is<LazyReal>(operand)) {
+			Real::value_type value = is<Real>(operand)
+				? value_of<Real>(operand)
+				: value_of<LazyReal>(operand).approximate(1000);
+			out.put(operand_tag::real);
+			value.backend().serialize(out, 0);
+		}
+		else
+			throw runtime_error("Error: cannot save operand " + operand->str());
+	}
+
+
+
+	Operand::pointer_type get_operand(reader& in, unsigned limb_bytes) {
+		switch (in.get<operand_tag>()) {
+		case operand_tag::null:
+			return nullptr;
+		case operand_tag::integer: {
+				bool negative = in.get<uint8_t>() != 0;
+				auto count = in.get<uint32_t>();
+				char const* bytes = in.take(size_t(count) * limb_bytes);
+				Integer::value_type value;
+				if (limb_bytes == sizeof(limb_type)) {
+					value.backend().resize(count, count);
+					memcpy(value.backend().limbs(), bytes, size_t(count) * limb_bytes);
+					value.backend().normalize();
+				}
+				else	// another limb size: on a little-endian machine the limbs still form one little-endian byte string
+					import_bits(value, reinterpret_cast<unsigned char const*>(bytes), reinterpret_cast<unsigned char const*>(bytes) + size_t(count) * limb_bytes, 8, false);
+				if (negative)
+					value = -value;
+				return make_operand<Integer>(value);
+			}
+		case operand_tag::boolean:
+			return make_operand<Boolean>(in.get<uint8_t>() != 0);
+		case operand_tag::decimal: {
+				bool negative = in.get<uint8_t>() != 0;
+				auto low = in.get<uint64_t>();
+				auto high = in.get<uint64_t>();
+				if (high >> 63)		// would carry into the sign
+					throw runtime_error("Error: snapshot has a corrupt decimal number");
+				auto raw = (fixed_decimal::raw_type(high) << 64) | fixed_decimal::raw_type(low);
+				if (raw >= fixed_decimal::limit())
+					throw runtime_error("Error: snapshot has a corrupt decimal number");
+				return make_operand<Decimal>(fixed_decimal::from_raw(negative ? fixed_decimal::raw_type(-raw) : raw));
+			}
+		case operand_tag::double_double:
+			return make_operand<DoubleDouble>(dd_real::from_limbs(in.get<dd_real::limb_array>()));
+		case operand_tag::quad_double:
+			return make_operand<QuadDouble>(qd_real::from_limbs(in.get<qd_real::limb_array>()));
+		case operand_tag::real: {
+				Real::value_type value;
+				real_reader fields(in);
+				value.backend().serialize(fields, 0);
+				return make_operand<Real>(value);
+			}
+		}
+		throw runtime_error("Error: unknown operand type in snapshot");
+	}
+}
+
+
+
+string serialize_session(ExpressionEvaluator const& ee) {
+	string result;
+	writer out(result);
+	out.put_bytes(magic, sizeof magic);
+	out.put(format_version);
+	out.put(byte_order_mark);
+	out.put(static_cast<uint8_t>(sizeof(limb_type)));
+	out.put_bytes("\0\0\0", 3);
+
+	// each section is written after a placeholder length, patched once its size is known
+	auto section = [&](section_tag tag, auto write_payload) {
+		out.put(static_cast<uint32_t>(tag));
+		size_t length_at = result.size();
+		out.put(uint64_t(0));
+		write_payload();
+		uint64_t length = result.size() - length_at - sizeof(uint64_t);
+		memcpy(&result[length_at], &length, sizeof length);
+	};
+
+	// only the session's own variables: the base layers are shared, and a snapshot is loaded over the loading session's base
+	section(section_variables, [&] {
+		auto const& overlay = ee.environment().overlay();
+		out.put(static_cast<uint32_t>(overlay.size()));
+		for (auto const& [name, variable] : overlay) {
+			out.put_string(name);
+			put_operand(out, variable->value());
+		}
+	});
+
+	section(section_history, [&] {
+		ResultHistory const& history = ee.history();
+		out.put(static_cast<uint64_t>(history.capacity()));
+		out.put(static_cast<uint64_t>(history.count()));
+		out.put(static_cast<uint64_t>(history.size()));
+		for (auto n = history.count() - history.size() + 1; n <= history.count(); ++n)
+			put_operand(out, history.at(n));
+	});
+
+	return result;
+}
+
+
+
+void deserialize_session(ExpressionEvaluator& ee, char const* data, size_t size) {
+	reader in(data, size);
+	if (memcmp(in.take(sizeof magic), magic, sizeof magic) != 0)
+		throw runtime_error("Error: not a session snapshot");
+	if (in.get<uint32_t>() != format_version)
+		throw runtime_error("Error: unsupported snapshot version");
+	if (in.get<uint32_t>() != byte_order_mark)
+		throw runtime_error("Error: snapshot was written with a different byte order");
+	unsigned limb_bytes = in.get<uint8_t>();
+	in.take(3);
+
+	// decode everything before touching the session, so a bad file leaves it unchanged;
+	// the variables go over the session's base layer, and its limits are applied once they are all in
+	Environment environment(ee.environment().base());
+	bool have_history = false;
+	uint64_t capacity = 0, count = 0;
+	vector<Operand::pointer_type> held;
+
+	while (!in.at_end()) {
+		auto tag = in.get<uint32_t>();
+		auto length = in.get<uint64_t>();
+		reader payload(in.take(static_cast<size_t>(length)), static_cast<size_t>(length));
+		switch (tag) {
+		case section_variables:
+			for (auto n = payload.get<uint32_t>(); n > 0; --n) {
+				auto name = payload.get_string();
+				auto value = get_operand(payload, limb_bytes);
+				auto variable = environment.variable(name);
+				if (value)
+					variable->set(value);
+			}
+			break;
+		case section_history:
+			have_history = true;
+			capacity = payload.get<uint64_t>();
+			count = payload.get<uint64_t>();
+			for (auto n = payload.get<uint64_t>(); n > 0; --n)
+				held.push_back(get_operand(payload, limb_bytes));
+			if (held.size() > count)
+				throw runtime_error("Error: snapshot history is inconsistent");
+			break;
+		default:
+			break;		// written by a newer version; skip
+		}
+	}
+
+	try {
+		environment.set_limits(ee.environment().limits());
+	}
+	catch (length_error const&) {
+		throw runtime_error("Error: snapshot variables exceed the session's variable limits");
+	}
+
+	optional<ResultHistory> history;
+	if (have_history) {
+		if (capacity > max_history_capacity || (capacity != 0 && held.size() > capacity))
+			throw runtime_error("Error: snapshot history capacity is invalid");
+		try {
+			history.emplace(static_cast<ResultHistory::size_type>(capacity));
+		}
+		catch (bad_alloc const&) {
+			throw runtime_error("Error: snapshot history capacity is invalid");
+		}
+		catch (length_error const&) {
+			throw runtime_error("Error: snapshot history capacity is invalid");
+		}
+		history->clear(static_cast<ResultHistory::size_type>(count - held.size()));
+		for (auto const& result : held)
+			history->push(result);
+	}
+
+	// commit: nothing below throws
+	ee.set_environment(std::move(environment));
+	if (history)
+		swap(ee.history(), *history);
+}
+
+
+
+void save_session(ExpressionEvaluator const& ee, string const& path) {
+	string data = serialize_session(ee);
+	ofstream file(path, ios::binary | ios::trunc);
+	if (!file.write(data.data(), data.size()))
+		throw runtime_error("Error: cannot write snapshot " + path);
+}
+
+
+
+void load_session(ExpressionEvaluator& ee, string const& path) {
+	MappedFile file(path);
+	deserialize_session(ee, file.data(), file.size());
+}
@@ -0,0 +1,102 @@
+/*!	\file	thread_pool.cpp
+	\brief	ThreadPool class implementation.
+	\author	Garth Santor
+	\date	2026-10-17
+	\copyright	Garth Santor, Trinh Han
+
+=============================================================
+Revision History
+-------------------------------------------------------------
+
+Version 2026.10.17
+	Alpha release.
+	A task that throws is reported and terminates the process.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han, Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
+
+#include <ee/thread_pool.hpp>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+using namespace std;
+
+
+
+ThreadPool::ThreadPool(size_t threads) {
+	if (threads == 0)
+		threads = max(1u, thread::hardware_concurrency());
+	for (size_t i = 0; i < threads; ++i)
+		threads_m.emplace_back([this] { _run(); });
+}
+
+
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> lock(mutex_m);
+		stopping_m = true;
+	}
+	ready_m.notify_all();
+	for (auto& t : threads_m)
+		t.join();
+}
+
+
+
+void ThreadPool::post(task_type task) {
+	{
+		lock_guard<mutex> lock(mutex_m);
+		tasks_m.push_back(std::move(task));
+	}
+	ready_m.notify_one();
+}
+
+
+
+void ThreadPool::_run() {
+	for (;;) {
+		task_type task;
+		{
+			unique_lock<mutex> lock(mutex_m);
+			ready_m.wait(lock, [this] { return stopping_m || !tasks_m.empty(); });
+			if (tasks_m.empty())
+				return;
+			task = std::move(tasks_m.front());
+			tasks_m.pop_front();
+		}
+		// nothing is waiting for a posted task's outcome, so an error must not vanish
+		try {
+			task();
+		}
+		catch (exception const& e) {
+			cerr << "Error: a thread pool task threw: " << e.what() << endl;
+			terminate();
+		}
+		catch (char const* message) {
+			cerr << "Error: a thread pool task threw: " << message << endl;
+			terminate();
+		}
+		catch (...) {
+			cerr << "Error: a thread pool task threw an unknown exception" << endl;
+			terminate();
+		}
+	}
+}
+
+
+
+ThreadPool& ThreadPool::shared() {
+	static ThreadPool pool;
+	return pool;
+}
@@ -9,6 +9,17 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Real literals and Pi/E follow the selected RealBackend.
+	RealBackend::Lazy produces LazyReal literals and constants.
+	Decimal literals with the 'm' suffix.
+	Variables are created through variable() in the session Environment.
+	Split the shared read-only core (keywords, character classes, operator tokens)
+	from the per-session TokenizerSession; tokenize(expression, session) is thread-safe.
+	parameterize() normalizes an expression and lifts out its numeric literals.
+	try_tokenize() reports errors without throwing; tokenize() is built on it.
+	parameterize() records the offset of each token, as try_tokenize() does.
+
 Version 2021.10.02
 	C++ 20 validated
 
@@ -58,53 +69,125 @@ the program(s) have been supplied.
 
 #include <ee/tokenizer.hpp>
 #include <ee/boolean.hpp>
+#include <ee/decimal.hpp>
+#include <ee/double_double.hpp>
 #include <ee/function.hpp>
 #include <ee/integer.hpp>
+#include <ee/lazy_real.hpp>
 #include <ee/operator.hpp>
 #include <ee/pseudo_operation.hpp>
+#include <ee/quad_double.hpp>
 #include <ee/real.hpp>
 #include <ee/variable.hpp>
 
+#include <algorithm>
+#include <array>
 #include <exception>
 #include <limits>
 #include <sstream>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 using namespace std;
 
-/** Default constructor loads the keyword dictionary. */
+
+
+/*! The immutable part of the tokenizer: built once, then only read. */
+struct Tokenizer::core {
+	enum char_class : unsigned char { digit = 1, alpha = 2, space = 4 };
+
+	dictionary_type							keywords;
+	array<unsigned char, 256>				classes{};
+	array<Token::pointer_type, 256>			single_ops;		// 1-character operators
+	vector<pair<string_type, Token::pointer_type>>	double_ops;		// 2-character operators, checked first
+	Token::pointer_type						addition, identity, subtraction, negation;
+
+	core();
+
+	[[nodiscard]] bool is_a(char c, unsigned char mask) const { return (classes[static_cast<unsigned char>(c)] & mask) != 0; }
+};
+
+
+
+/** Loads the keyword dictionary, character classes and operator tokens.
+	Operator tokens carry no state, so one instance of each is shared by every expression.
+	*/
+Tokenizer::core::core() {
+	keywords["abs"]     = keywords["Abs"]		= keywords["ABS"]		= make<Abs>();
+	keywords["and"]     = keywords["And"]		= keywords["AND"]		= make<And>();
+	keywords["arccos"]  = keywords["Arccos"]	= keywords["ARCCOS"]	= make<Arccos>();
+	keywords["arcsin"]  = keywords["Arcsin"]	= keywords["ARCSIN"]	= make<Arcsin>();
+	keywords["arctan"]  = keywords["Arctan"]	= keywords["ARCTAN"]	= make<Arctan>();
+	keywords["arctan2"] = keywords["Arctan2"]	= keywords["ARCTAN2"]	= make<Arctan2>();
+	keywords["ceil"]    = keywords["Ceil"]		= keywords["CEIL"]		= make<Ceil>();
+	keywords["cos"]     = keywords["Cos"]		= keywords["COS"]		= make<Cos>();
+	keywords["e"]       = keywords["E"]								= make<E>();
+	keywords["exp"]     = keywords["Exp"]		= keywords["EXP"]		= make<Exp>();
+	keywords["false"]   = keywords["False"]		= keywords["FALSE"]		= make<False>();
+	keywords["floor"]   = keywords["Floor"]		= keywords["FLOOR"]		= make<Floor>();
+	keywords["lb"]      = keywords["Lb"]		= keywords["LB"]		= make<Lb>();
+	keywords["ln"]      = keywords["Ln"]		= keywords["LN"]		= make<Ln>();
+	keywords["log"]     = keywords["Log"]		= keywords["LOG"]		= make<Log>();
+	keywords["max"]     = keywords["Max"]		= keywords["MAX"]		= make<Max>();
+	keywords["min"]     = keywords["Min"]		= keywords["MIN"]		= make<Min>();
+	keywords["mod"]     = keywords["Mod"]		= keywords["MOD"]		= make<Modulus>();
+	keywords["nand"]    = keywords["Nand"]		= keywords["NAND"]		= make<Nand>();
+	keywords["nor"]     = keywords["Nor"]		= keywords["NOR"]		= make<Nor>();
+	keywords["not"]     = keywords["Not"]		= keywords["NOT"]		= make<Not>();
+	keywords["or"]      = keywords["Or"]		= keywords["OR"]		= make<Or>();
+	keywords["pi"]      = keywords["Pi"]		= keywords["PI"]		= make<Pi>();
+	keywords["pow"]     = keywords["Pow"]		= keywords["POW"]		= make<Pow>();
+	keywords["result"]  = keywords["Result"]	= keywords["RESULT"]	= make<Result>();
+	keywords["sin"]     = keywords["Sin"]		= keywords["SIN"]		= make<Sin>();
+	keywords["sqrt"]    = keywords["Sqrt"]		= keywords["SQRT"]		= make<Sqrt>();
+	keywords["tan"]     = keywords["Tan"]		= keywords["TAN"]		= make<Tan>();
+	keywords["true"]    = keywords["True"]		= keywords["TRUE"]		= make<True>();
+	keywords["xnor"]    = keywords["Xnor"]		= keywords["XNOR"]		= make<Xnor>();
+	keywords["xor"]     = keywords["Xor"]		= keywords["XOR"]		= make<Xor>();
+
+	for (int c = 0; c < 256; ++c)
+		classes[c] = static_cast<unsigned char>(
+			(isdigit(c) ? digit : 0) | (isalpha(c) ? alpha : 0) | (isspace(c) ? space : 0));
+
+	double_ops = {
+		{ "<=", make<LessEqual>() },
+		{ ">=", make<GreaterEqual>() },
+		{ "==", make<Equality>() },
+		{ "!=", make<Inequality>() },
+		{ "**", make<Power>() },
+	};
+
+	single_ops['*'] = make<Multiplication>();
+	single_ops['/'] = make<Division>();
+	single_ops['%'] = keywords["mod"];
+	single_ops['('] = make<LeftParenthesis>();
+	single_ops[')'] = make<RightParenthesis>();
+	single_ops[','] = make<ArgumentSeparator>();
+	single_ops['<'] = make<Less>();
+	single_ops['>'] = make<Greater>();
+	single_ops['!'] = make<Factorial>();
+	single_ops['='] = make<Assignment>();
+
+	addition = make<Addition>();
+	identity = make<Identity>();
+	subtraction = make<Subtraction>();
+	negation = make<Negation>();
+}
+
+
+
+/** The shared core.  Built on first use; C++ guarantees the initialization is thread-safe. */
+Tokenizer::core const& Tokenizer::_core() {
+	static core const instance;
+	return instance;
+}
+
+
+
+/** Default constructor.  Only the session state is per-Tokenizer. */
 Tokenizer::Tokenizer() {
-	keywords_m["abs"]     = keywords_m["Abs"]		= keywords_m["ABS"]		= make<Abs>();
-	keywords_m["and"]     = keywords_m["And"]		= keywords_m["AND"]		= make<And>();
-	keywords_m["arccos"]  = keywords_m["Arccos"]	= keywords_m["ARCCOS"]	= make<Arccos>();
-	keywords_m["arcsin"]  = keywords_m["Arcsin"]	= keywords_m["ARCSIN"]	= make<Arcsin>();
-	keywords_m["arctan"]  = keywords_m["Arctan"]	= keywords_m["ARCTAN"]	= make<Arctan>();
-	keywords_m["arctan2"] = keywords_m["Arctan2"]	= keywords_m["ARCTAN2"]	= make<Arctan2>();
-	keywords_m["ceil"]    = keywords_m["Ceil"]	= keywords_m["CEIL"]		= make<Ceil>();
-	keywords_m["cos"]     = keywords_m["Cos"]		= keywords_m["COS"]		= make<Cos>();
-	keywords_m["e"]       = keywords_m["E"]								= make<E>();
-	keywords_m["exp"]     = keywords_m["Exp"]		= keywords_m["EXP"]		= make<Exp>();
-	keywords_m["false"]   = keywords_m["False"]	= keywords_m["FALSE"]	= make<False>();
-	keywords_m["floor"]   = keywords_m["Floor"]	= keywords_m["FLOOR"]	= make<Floor>();
-	keywords_m["lb"]      = keywords_m["Lb"]		= keywords_m["LB"]		= make<Lb>();
-	keywords_m["ln"]      = keywords_m["Ln"]		= keywords_m["LN"]		= make<Ln>();
-	keywords_m["log"]     = keywords_m["Log"]		= keywords_m["LOG"]		= make<Log>();
-	keywords_m["max"]     = keywords_m["Max"]		= keywords_m["MAX"]		= make<Max>();
-	keywords_m["min"]     = keywords_m["Min"]		= keywords_m["MIN"]		= make<Min>();
-	keywords_m["mod"]     = keywords_m["Mod"]		= keywords_m["MOD"]		= make<Modulus>();
-	keywords_m["nand"]    = keywords_m["Nand"]	= keywords_m["NAND"]		= make<Nand>();
-	keywords_m["nor"]     = keywords_m["Nor"]		= keywords_m["NOR"]		= make<Nor>();
-	keywords_m["not"]     = keywords_m["Not"]		= keywords_m["NOT"]		= make<Not>();
-	keywords_m["or"]      = keywords_m["Or"]		= keywords_m["OR"]		= make<Or>();
-	keywords_m["pi"]      = keywords_m["Pi"]		= keywords_m["PI"]		= make<Pi>();
-	keywords_m["pow"]     = keywords_m["Pow"]		= keywords_m["POW"]		= make<Pow>();
-	keywords_m["result"]  = keywords_m["Result"]	= keywords_m["RESULT"]	= make<Result>();
-	keywords_m["sin"]     = keywords_m["Sin"]		= keywords_m["SIN"]		= make<Sin>();
-	keywords_m["sqrt"]    = keywords_m["Sqrt"]	= keywords_m["SQRT"]		= make<Sqrt>();
-	keywords_m["tan"]     = keywords_m["Tan"]		= keywords_m["TAN"]		= make<Tan>();
-	keywords_m["true"]    = keywords_m["True"]	= keywords_m["TRUE"]		= make<True>();
-	keywords_m["xnor"]    = keywords_m["Xnor"]	= keywords_m["XNOR"]		= make<Xnor>();
-	keywords_m["xor"]     = keywords_m["Xor"]		= keywords_m["XOR"]		= make<Xor>();
+	(void)_core();
 }
 
 
@@ -112,28 +195,56 @@ Tokenizer::Tokenizer() {
 
 /** Get an identifier from the expression.
 	Assumes that the currentChar is pointing to a alphabetic.
+	@return nullptr if it names a new variable that the session's limits reject.
 	*/
-Token::pointer_type Tokenizer::_get_identifier(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression) {
+Token::pointer_type Tokenizer::_get_identifier(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression, TokenizerSession& session) {
+	core const& lexer = _core();
+
 	// accumulate identifier
 	string_type ident;
 	do
 		ident += *currentChar++;
-	while (currentChar != end(expression) && isalnum(*currentChar));
+	while (currentChar != end(expression) && lexer.is_a(*currentChar, core::alpha | core::digit));
 
 	// check for predefined identifier
-	dictionary_type::iterator iter = keywords_m.find(ident);
-	if (iter != end(keywords_m))
+	auto iter = lexer.keywords.find(ident);
+	if (iter != end(lexer.keywords)) {
+		if (session.real_backend != RealBackend::Multiprecision && is<Real>(iter->second))
+			return _make_real_constant(iter->second, session.real_backend);
 		return iter->second;
+	}
+
+	auto variable = session.environment.try_variable(ident);
+	if (variable && session.variable_names)
+		session.variable_names->emplace_back(variable.get(), std::move(ident));
+	return variable;
+}
+
+
+
+/** Look up a variable, adding it to the symbol table if it is new.
+	@param name [in] the identifier.
+*/
+Variable::pointer_type Tokenizer::variable(Tokenizer::string_type const& name) {
+	if (is_keyword(name))
+		throw invalid_argument("Error: '" + name + "' is a reserved word");
+
+	return session_m.environment.variable(name);
+}
+
+
+
+void Tokenizer::assign(Tokenizer::string_type const& name, Operand::pointer_type const& value) {
+	if (is_keyword(name))
+		throw invalid_argument("Error: '" + name + "' is a reserved word");
+
+	session_m.environment.assign(name, value);
+}
 
-	// check for variable
-	iter = variables_m.find(ident);
-	if (iter != variables_m.end())
-		return iter->second;
 
-	// add a variable
-	Token::pointer_type result = make<Variable>();
-	variables_m[ident] = result;
-	return result;
+
+bool Tokenizer::is_keyword(Tokenizer::string_type const& name) {
+	return _core().keywords.count(name) != 0;
 }
 
 
@@ -144,7 +255,7 @@ Token::pointer_type Tokenizer::_get_identifier(Tokenizer::string_type::const_ite
 	@param currentChar [in,out] an iterator to the current character.  Assumes that the currentChar is pointing to a digit.
 	@param expression [in] the expression being scanned.
 */
-Token::pointer_type Tokenizer::_get_number(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression) {
+Token::pointer_type Tokenizer::_get_number(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression, RealBackend backend) {
 	assert(isdigit(*currentChar) && "currentChar must pointer to a digit");
 
 	// Either Integer or Real
@@ -153,6 +264,11 @@ Token::pointer_type Tokenizer::_get_number(Tokenizer::string_type::const_iterato
 	while (currentChar != end(expression) && isdigit(*currentChar))
 		digits += *currentChar++;
 
+	if (_is_decimal_suffix(currentChar, expression)) {
+		++currentChar;
+		return make_decimal_literal(digits);
+	}
+
 	if (currentChar == end(expression) || (!isdigit(*currentChar) && *currentChar != '.'))
 		return make<Integer>(Integer::value_type(digits));
 
@@ -161,8 +277,95 @@ Token::pointer_type Tokenizer::_get_number(Tokenizer::string_type::const_iterato
 	while (currentChar != end(expression) && isdigit(*currentChar))
 		digits += *currentChar++;
 
+	if (_is_decimal_suffix(currentChar, expression)) {
+		++currentChar;
+		return make_decimal_literal(digits);
+	}
+
+	return _make_real(digits, backend);
+}
+
+
+
+/** Make the token for a numeric literal found by parameterize().
+	@param text [in] the literal, as it appeared in the expression.
+	@param backend [in] the session's real backend.
+*/
+Token::pointer_type Tokenizer::number(string_view text, RealBackend backend) {
+	string_type const literal(text);
+	auto currentChar = literal.cbegin();
+	return _get_number(currentChar, literal, backend);
+}
+
+
+
+/** Find the end of the numeric literal at currentChar, by the same rules as _get_number().
+	@param currentChar [in] an iterator to a digit.
+	@param expression [in] the expression being scanned.
+*/
+Tokenizer::string_type::const_iterator Tokenizer::_number_end(Tokenizer::string_type::const_iterator currentChar, Tokenizer::string_type const& expression) {
+	while (currentChar != end(expression) && isdigit(*currentChar))
+		++currentChar;
+	if (_is_decimal_suffix(currentChar, expression))
+		return next(currentChar);
+	if (currentChar == end(expression) || *currentChar != '.')
+		return currentChar;
+
+	++currentChar;
+	while (currentChar != end(expression) && isdigit(*currentChar))
+		++currentChar;
+	return _is_decimal_suffix(currentChar, expression) ? next(currentChar) : currentChar;
+}
+
+
+
+/** Check for the 'm' suffix of a decimal literal (12.50m), as in C#.
+	The suffix must not begin an identifier.
+*/
+bool Tokenizer::_is_decimal_suffix(Tokenizer::string_type::const_iterator currentChar, Tokenizer::string_type const& expression) {
+	if (currentChar == end(expression) || (*currentChar != 'm' && *currentChar != 'M'))
+		return false;
+	++currentChar;
+	return currentChar == end(expression) || (!_core().is_a(*currentChar, core::alpha | core::digit) && *currentChar != '_');
+}
+
+
 
-	return make<Real>(Real::value_type(digits));
+/** Make a real number token of the selected backend type.
+	@param digits [in] the decimal digits of the literal.
+	@param backend [in] the session's real backend.
+*/
+Token::pointer_type Tokenizer::_make_real(Tokenizer::string_type const& digits, RealBackend backend) {
+	switch (backend) {
+	case RealBackend::DoubleDouble:
+		return make<DoubleDouble>(DoubleDouble::value_type(digits));
+	case RealBackend::QuadDouble:
+		return make<QuadDouble>(QuadDouble::value_type(digits));
+	case RealBackend::Lazy:
+		return make<LazyReal>(LazyReal::value_type(digits));
+	default:
+		return make<Real>(Real::value_type(digits));
+	}
+}
+
+
+
+/** Make the selected backend's version of a real constant keyword.
+	@param constant [in] the Pi or E keyword token.
+	@param backend [in] the session's real backend.
+*/
+Token::pointer_type Tokenizer::_make_real_constant(Token::pointer_type const& constant, RealBackend backend) {
+	bool pi = is<Pi>(constant);
+	switch (backend) {
+	case RealBackend::DoubleDouble:
+		return make<DoubleDouble>(pi ? dd_real::pi() : dd_real::e());
+	case RealBackend::QuadDouble:
+		return make<QuadDouble>(pi ? qd_real::pi() : qd_real::e());
+	case RealBackend::Lazy:
+		return make<LazyReal>(pi ? lazy_real::pi() : lazy_real::e());
+	default:
+		return constant;
+	}
 }
 
 
@@ -170,99 +373,168 @@ Token::pointer_type Tokenizer::_get_number(Tokenizer::string_type::const_iterato
 /** Tokenize the expression.
 	@return a TokenList containing the tokens from 'expression'.
 	@param expression [in] The expression to tokenize.
-	@note Tokenizer dictionary may be updated if expression contains variables.
+	@param session [in,out] The symbol state; new variables are added to its environment.
+	@note Reads only the shared core otherwise, so threads with separate sessions may tokenize concurrently.
 	@note Will throws 'BadCharacter' if the expression contains an un-tokenizable character.
+	@note Throws std::length_error, and adds nothing, if a new variable would exceed the session's variable limits.
 	*/
-TokenList Tokenizer::tokenize(string_type const& expression) {
+TokenList Tokenizer::tokenize(string_type const& expression, TokenizerSession& session) {
+	auto tokens = try_tokenize(expression, session);
+	if (tokens)
+		return std::move(*tokens);
+
+	if (tokens.error().code == EvalErrc::variable_limit) {
+		// name the variable the environment rejected, as Environment::variable() would
+		auto first = expression.cbegin() + tokens.error().offset;
+		auto last = find_if(first, expression.cend(), [](char c) { return !_core().is_a(c, core::alpha | core::digit); });
+		throw length_error("Error: variable '" + string_type(first, last) + "' exceeds the session's variable limits");
+	}
+	throw XBadCharacter(expression, tokens.error().offset);
+}
+
+
+
+/** Tokenize the expression without throwing.
+	@return the tokens, or the error and the offset of the character where it was found.
+	@param expression [in] The expression to tokenize.
+	@param session [in,out] The symbol state; new variables are added to its environment.
+	@param offsets [out] If not null, receives the offset of each token.
+	*/
+EvalExpected<TokenList> Tokenizer::try_tokenize(string_type const& expression, TokenizerSession& session, vector<uint32_t>* offsets) {
+	core const& lexer = _core();
 	TokenList tokenizedExpression;
 	auto currentChar = expression.cbegin();
 
 	for(;;)
 	{
 		// strip whitespace
-		while (currentChar != end(expression) && isspace(*currentChar))
+		while (currentChar != end(expression) && lexer.is_a(*currentChar, core::space))
 			++currentChar;
 
 		// check of end of expression
 		if (currentChar == end(expression)) break;
 
+		auto const offset = static_cast<uint32_t>(currentChar - begin(expression));
+		if (offsets)
+			offsets->push_back(offset);
+
 		// check for a number
-		if (isdigit(*currentChar)) {
-			tokenizedExpression.push_back(_get_number(currentChar, expression));
+		if (lexer.is_a(*currentChar, core::digit)) {
+			tokenizedExpression.push_back(_get_number(currentChar, expression, session.real_backend));
 			continue;
 		}
 
 		// check for 2-character operators
-#define CHECK_2OP( symbol1, symbol2, token )\
-		if( *currentChar == symbol1 ) {\
-			auto nextChar = next(currentChar);\
-			if( nextChar != end(expression) && *nextChar == symbol2 ) {\
-				currentChar = next(nextChar);\
-				tokenizedExpression.push_back( make<token>() );\
-				continue;\
-			}\
-		}
-		CHECK_2OP('<', '=', LessEqual)
-		CHECK_2OP('>', '=', GreaterEqual)
-		CHECK_2OP('=', '=', Equality)
-		CHECK_2OP('!', '=', Inequality)
-		CHECK_2OP('*', '*', Power)
-#undef CHECK_2OP
-
-			// check for 1-character operators
-#define CHECK_OP(symbol, token)\
-		if( *currentChar == symbol ) {\
-			++currentChar;\
-			tokenizedExpression.push_back( make<token>() );\
-			continue;\
+		auto nextChar = next(currentChar);
+		if (nextChar != end(expression)) {
+			auto op = find_if(lexer.double_ops.begin(), lexer.double_ops.end(),
+				[&](auto const& entry) { return entry.first[0] == *currentChar && entry.first[1] == *nextChar; });
+			if (op != lexer.double_ops.end()) {
+				currentChar = next(nextChar);
+				tokenizedExpression.push_back(op->second);
+				continue;
+			}
 		}
-		CHECK_OP('*', Multiplication)
-		CHECK_OP('/', Division)
-		CHECK_OP('%', Modulus)
-		CHECK_OP('(', LeftParenthesis)
-		CHECK_OP(')', RightParenthesis)
-		CHECK_OP(',', ArgumentSeparator)
-		CHECK_OP('<', Less)
-		CHECK_OP('>', Greater)
-		CHECK_OP('!', Factorial)
-		CHECK_OP('=', Assignment)
-#undef CHECK_OP
 
-
-		// check for multi-purpose operators
-		if (*currentChar == '+') {
+		// check for 1-character operators
+		if (auto const& op = lexer.single_ops[static_cast<unsigned char>(*currentChar)]) {
 			++currentChar;
-			if (!tokenizedExpression.empty() &&
-				(is<RightParenthesis>(tokenizedExpression.back()) ||
-					is<Operand>(tokenizedExpression.back()) ||
-					is<PostfixOperator>(tokenizedExpression.back())))
-				tokenizedExpression.push_back(make<Addition>());
-			else
-				tokenizedExpression.push_back(make<Identity>());
+			tokenizedExpression.push_back(op);
 			continue;
 		}
-		if (*currentChar == '-') {
-			++currentChar;
-			if (!tokenizedExpression.empty() &&
+
+
+		// check for multi-purpose operators
+		if (*currentChar == '+' || *currentChar == '-') {
+			bool binary = !tokenizedExpression.empty() &&
 				(is<RightParenthesis>(tokenizedExpression.back()) ||
 					is<Operand>(tokenizedExpression.back()) ||
-					is<PostfixOperator>(tokenizedExpression.back())))
-				tokenizedExpression.push_back(make<Subtraction>());
+					is<PostfixOperator>(tokenizedExpression.back()));
+			if (*currentChar++ == '+')
+				tokenizedExpression.push_back(binary ? lexer.addition : lexer.identity);
 			else
-				tokenizedExpression.push_back(make<Negation>());
+				tokenizedExpression.push_back(binary ? lexer.subtraction : lexer.negation);
 			continue;
 		}
 
 
 		// Identifiers
-		if (isalpha(*currentChar)) {
-			tokenizedExpression.push_back(_get_identifier(currentChar, expression));
+		if (lexer.is_a(*currentChar, core::alpha)) {
+			auto identifier = _get_identifier(currentChar, expression, session);
+			if (!identifier)
+				return eval_failure(EvalErrc::variable_limit, offset);
+			tokenizedExpression.push_back(std::move(identifier));
 			continue;
 		}
 
 		// not a recognized token
-		throw XBadCharacter(expression, currentChar - begin(expression));
+		return eval_failure(EvalErrc::bad_character, offset);
 	}
 
 	return tokenizedExpression;
 }
+
+
+
+/** Parameterize the expression: the tokenizer's scan without making tokens.
+	Numbers become '#', keywords are written in lower case and variables as they are.
+	@param expression [in] The expression to scan.
+	@param result [out] The normalized text and the literals.
+	@note Operators are written as they appear; whether '+' and '-' are unary depends only
+		on the previous token, which is the same for every expression with the same text.
+	*/
+bool Tokenizer::parameterize(string_type const& expression, ParameterizedExpression& result) {
+	core const& lexer = _core();
+	result.text.clear();
+	result.literals.clear();
+	result.literal_tokens.clear();
+	result.offsets.clear();
+	result.tokens = 0;
+	auto currentChar = expression.cbegin();
+
+	for (;; ++result.tokens) {
+		while (currentChar != end(expression) && lexer.is_a(*currentChar, core::space))
+			++currentChar;
+		if (currentChar == end(expression))
+			return true;
+		if (result.tokens != 0)
+			result.text += ' ';
+
+		auto first = currentChar;
+		result.offsets.push_back(static_cast<uint32_t>(first - expression.cbegin()));
+		if (lexer.is_a(*currentChar, core::digit)) {
+			currentChar = _number_end(currentChar, expression);
+			result.text += '#';
+			result.literals.emplace_back(&*first, static_cast<size_t>(currentChar - first));
+			result.literal_tokens.push_back(result.tokens);
+			continue;
+		}
+
+		auto nextChar = next(currentChar);
+		if (nextChar != end(expression) && any_of(lexer.double_ops.begin(), lexer.double_ops.end(),
+			[&](auto const& entry) { return entry.first[0] == *currentChar && entry.first[1] == *nextChar; })) {
+			currentChar = next(nextChar);
+			result.text.append(first, currentChar);
+			continue;
+		}
+
+		if (lexer.single_ops[static_cast<unsigned char>(*currentChar)] || *currentChar == '+' || *currentChar == '-') {
+			result.text += *currentChar++;
+			continue;
+		}
+
+		if (lexer.is_a(*currentChar, core::alpha)) {
+			do
+				++currentChar;
+			while (currentChar != end(expression) && lexer.is_a(*currentChar, core::alpha | core::digit));
+			size_t const start = result.text.size();
+			result.text.append(first, currentChar);
+			if (lexer.keywords.count(result.text.substr(start)))
+				for (size_t i = start; i < result.text.size(); ++i)
+					result.text[i] = static_cast<char>(tolower(static_cast<unsigned char>(result.text[i])));
+			continue;
+		}
+
+		return false;
+	}
+}
@@ -11,6 +11,11 @@ Implementation of the Variable class derived from Operand.
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added binding to host memory and getter callbacks.
+	Added copy().
+	Added freeze(); host-memory bindings convert only a changed value.
+
 Version 2021.10.26
 	C++ 20 validated
 
@@ -38,9 +43,66 @@ the program(s) have been supplied.
 =============================================================*/
 
 #include <ee/variable.hpp>
+#include <ee/boolean.hpp>
+#include <ee/integer.hpp>
+#include <ee/real.hpp>
+#include <cstring>
+
+
+
+namespace {
+	/*! A getter that rebuilds the operand only when the bytes at 'location' have changed. */
+	template <class OperandType, class HostType>
+	Variable::getter_type cached_getter(HostType const* location) {
+		return [location, last = HostType(), cached = Operand::pointer_type()]() mutable {
+			HostType const now = *location;
+			if (!cached || std::memcmp(&now, &last, sizeof now) != 0) {
+				cached = make_operand<OperandType>(typename OperandType::value_type(now));
+				last = now;
+			}
+			return cached;
+		};
+	}
+}
 
 [[nodiscard]] Token::string_type Variable::str() const {
-	if (!value_m)
+	value_type v = value();
+	if (!v)
 		return Token::string_type("Variable: null");
-	return value_m->str();
+	return v->str();
+}
+
+
+
+void Variable::bind(double const* location) {
+	bind(cached_getter<Real>(location));
+}
+
+
+
+void Variable::bind(std::int64_t const* location) {
+	bind(cached_getter<Integer>(location));
+}
+
+
+
+void Variable::bind(bool const* location) {
+	bind(cached_getter<Boolean>(location));
+}
+
+
+
+Variable::pointer_type Variable::copy() const {
+	auto result = std::make_shared<Variable>();
+	result->value_m = value_m;
+	result->getter_m = getter_m;
+	return result;
+}
+
+
+
+Variable::pointer_type Variable::freeze() const {
+	auto result = std::make_shared<Variable>();
+	result->value_m = value();
+	return result;
 }
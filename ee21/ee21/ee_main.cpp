@@ -8,6 +8,11 @@
 Revision History
 -------------------------------------------------------------
 
+Version 2026.10.17
+	Added batch mode: ee --batch input.txt --out results.txt
+	Added server mode and load generator: ee --serve / ee --load (Linux)
+	Added shared memory server mode: ee --serve-shm (Linux)
+
 Version 2021.11.01
 	C++ 20 validated
 
@@ -43,6 +48,9 @@ the program(s) have been supplied.
 ============================================================= */
 
 #include <gats/ConsoleApp.hpp>
+#include <ee/batch_file.hpp>
+#include <ee/eval_server.hpp>
+#include <ee/shm_ring.hpp>
 #include <ee/expression_evaluator.hpp>
 #include <ee/function.hpp>
 #include <ee/real.hpp>
@@ -58,7 +66,105 @@ using namespace std;
 
 
 
+/*! The value following 'name' on the command line, or 'otherwise'. */
+string option(vector<string> const& args, string const& name, string const& otherwise = string()) {
+	auto iter = find(args.begin(), args.end(), name);
+	return iter != args.end() && iter + 1 != args.end() ? *(iter + 1) : otherwise;
+}
+
+
+
+
+/*! ee --batch input.txt --out results.txt */
+int run_batch(vector<string> const& args) {
+	string input = option(args, "--batch"), output = option(args, "--out");
+	if (input.empty() || output.empty()) {
+		cerr << "usage: ee --batch input.txt --out results.txt\n";
+		return EXIT_FAILURE;
+	}
+
+	try {
+		ExpressionEvaluator ee;
+		BatchReport report = evaluate_file(ee, input, output);
+		cout << report.expressions << " expressions (" << report.errors << " errors) in "
+			<< report.seconds << " s: " << static_cast<unsigned long long>(report.per_second()) << " expressions/s\n";
+	}
+	catch (exception const& e) {
+		cerr << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+
+
+#if defined(__linux__)
+/*! ee --serve socket [--threads n] */
+int run_server(vector<string> const& args) {
+	try {
+		EvalServer server(option(args, "--serve"), stoul(option(args, "--threads", "0")));
+		cout << "serving on " << server.path() << endl;
+		server.run();
+	}
+	catch (exception const& e) {
+		cerr << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+
+/*! ee --load socket [--connections c] [--requests n] [--pipeline d] [--expr text] */
+int run_load_generator(vector<string> const& args) {
+	try {
+		LoadReport report = run_load(option(args, "--load"), option(args, "--expr", "1"),
+			stoul(option(args, "--connections", "4")), stoul(option(args, "--requests", "10000")), stoul(option(args, "--pipeline", "16")));
+		cout << report.requests << " requests (" << report.errors << " errors) in " << report.seconds << " s: "
+			<< static_cast<unsigned long long>(report.per_second()) << " requests/s, p50 "
+			<< report.p50_us << " us, p99 " << report.p99_us << " us\n";
+	}
+	catch (exception const& e) {
+		cerr << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+
+/*! ee --serve-shm name [--lanes n] [--threads n] */
+int run_shm_server(vector<string> const& args) {
+	try {
+		ShmEvalServer server(option(args, "--serve-shm"), stoul(option(args, "--lanes", "16")), stoul(option(args, "--threads", "1")));
+		cout << "serving on shared memory " << server.name() << endl;
+		server.run();
+	}
+	catch (exception const& e) {
+		cerr << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+#endif
+
+
+
+
 MAKEAPP(ee) {
+	auto const& args = get_args();
+	if (find(args.begin(), args.end(), "--batch") != args.end())
+		return run_batch(args);
+#if defined(__linux__)
+	if (find(args.begin(), args.end(), "--serve") != args.end())
+		return run_server(args);
+	if (find(args.begin(), args.end(), "--load") != args.end())
+		return run_load_generator(args);
+	if (find(args.begin(), args.end(), "--serve-shm") != args.end())
+		return run_shm_server(args);
+#endif
+
 	cout << "Expression Evaluator, (c) 1998-2021 Garth Santor\n";
 	for (unsigned count = 0; ; ++count) {
 		cout << "> ";
@@ -16,6 +16,9 @@ ConsoleApp class declaration.
 =============================================================
 Revision History
 -------------------------------------------------------------
+Version 2026.10.17
+	setup() and wrapup() are no longer [[noreturn]]; they return to the application sandwich.
+
 Version 2021.10.30
 	C++ 20 Version
 	Moved to namespace gats
@@ -91,9 +94,9 @@ namespace gats {
 		ConsoleApp(bool autoRestoreWindowStateOnExit = false);
 		virtual ~ConsoleApp();
 
-		[[noreturn]] virtual void setup() {}
+		virtual void setup() {}
 		[[nodiscard]] virtual int execute();
-		[[noreturn]] virtual void wrapup() {}
+		virtual void wrapup() {}
 
 		/*!	Access the command-line arguments container.
 		*/
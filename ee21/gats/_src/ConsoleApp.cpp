@@ -15,6 +15,9 @@ ConsoleApp class declaration.
 =============================================================
 Revision History
 -------------------------------------------------------------
+Version 2026.10.17
+	The console state is saved and restored on Windows only, so the framework builds on Linux.
+
 Version 2021.10.30
 	C++ 20 Version
 	Moved to namespace gats
@@ -118,9 +121,11 @@ namespace gats {
 		// Collect the command-line arguments.
 		thisApp_sm->args_m.assign(argv, argv + argc);
 
+#if defined(_WIN32)
 		// Save the console state
 		if (thisApp_sm->autoRestoreWindowStateOnExit_m)
 			thisApp_sm->initialState_m = thisApp_sm->console.GetState();
+#endif
 
 		// Reconfigure the console
 		thisApp_sm->setup();
@@ -156,9 +161,11 @@ namespace gats {
 		if (!wrapupCalled_m)
 			this->wrapup();
 
+#if defined(_WIN32)
 		// Restore the console state
 		if (autoRestoreWindowStateOnExit_m)
 			console.SetState(initialState_m);
+#endif
 	}
 
 